@@ -0,0 +1,206 @@
+/*
+ * A program that measures the overhead of ButtonConfig::dispatchEvent() for the
+ * various types of event handlers. The "legacy" rows reproduce the dispatch
+ * code used before EventDelegate was introduced, which stored the handler as a
+ * void*, tested the kInternalFeatureIEventHandler flag, then performed either a
+ * function pointer call or a virtual call. The "delegate" rows invoke the
+ * EventDelegate of a ButtonConfig::Snapshot through a single indirect call,
+ * like AceButton::handleEvent() does.
+ *
+ * Prints the label, the total micros, and the number of iterations in the
+ * following format. These numbers were obtained using EpoxyDuino on a Linux
+ * x86_64 machine:
+ *
+ * @verbatim
+ * BENCHMARKS
+ * legacy_function 3499 1000000
+ * legacy_ievent_handler 2637 1000000
+ * delegate_function 4032 1000000
+ * delegate_static_function 3142 1000000
+ * delegate_ievent_handler 3163 1000000
+ * delegate_method 2491 1000000
+ * delegate_lambda 2421 1000000
+ * END
+ * @endverbatim
+ *
+ * The EventDelegate is always invoked with one unconditional indirect call to
+ * its stub, with no test of the handler type. A stub generated for a specific
+ * handler, by fromFunction<FUNC>(), fromMethod() or fromCallable(), then calls
+ * it directly. A function pointer installed by setEventHandler(), or an
+ * IEventHandler installed by setIEventHandler(), is called from a generic stub,
+ * which costs a second call (or a virtual call). The run-to-run noise of a
+ * desktop machine is about 20%, so only differences larger than that are
+ * significant.
+ */
+
+#include <Arduino.h>
+#include <AceButton.h>
+
+using namespace ace_button;
+
+#if !defined(SERIAL_PORT_MONITOR)
+#define SERIAL_PORT_MONITOR Serial
+#endif
+
+#if defined(ARDUINO_ARCH_AVR)
+const uint32_t NUM_ITERATIONS = 10000;
+#else
+const uint32_t NUM_ITERATIONS = 1000000;
+#endif
+
+// A volatile integer to prevent the compiler from optimizing away the calls.
+volatile uint8_t disableCompilerOptimization = 0;
+
+AceButton button(nullptr);
+
+//-----------------------------------------------------------------------------
+// The handlers.
+//-----------------------------------------------------------------------------
+
+void handleEvent(AceButton* /*button*/, uint8_t eventType,
+    uint8_t /*buttonState*/) {
+  disableCompilerOptimization = eventType;
+}
+
+class Handler: public IEventHandler {
+  public:
+    void handleEvent(AceButton* /*button*/, uint8_t eventType,
+        uint8_t /*buttonState*/) override {
+      disableCompilerOptimization = eventType;
+    }
+
+    void onEvent(AceButton* /*button*/, uint8_t eventType,
+        uint8_t /*buttonState*/) {
+      disableCompilerOptimization = eventType;
+    }
+};
+
+Handler handler;
+
+//-----------------------------------------------------------------------------
+// Reproduction of the dispatch code prior to EventDelegate.
+//-----------------------------------------------------------------------------
+
+class LegacyDispatcher {
+  public:
+    void setEventHandler(ButtonConfig::EventHandler eventHandler) {
+      mEventHandler = reinterpret_cast<void*>(eventHandler);
+      mFeatureFlags &= ~ButtonConfig::kInternalFeatureIEventHandler;
+    }
+
+    void setIEventHandler(IEventHandler* eventHandler) {
+      mEventHandler = eventHandler;
+      mFeatureFlags |= ButtonConfig::kInternalFeatureIEventHandler;
+    }
+
+    void dispatchEvent(AceButton* button, uint8_t eventType,
+        uint8_t buttonState) const {
+      if (! mEventHandler) return;
+
+      if (mFeatureFlags & ButtonConfig::kInternalFeatureIEventHandler) {
+        IEventHandler* eventHandler =
+            reinterpret_cast<IEventHandler*>(mEventHandler);
+        eventHandler->handleEvent(button, eventType, buttonState);
+      } else {
+        ButtonConfig::EventHandler eventHandler =
+            reinterpret_cast<ButtonConfig::EventHandler>(mEventHandler);
+        eventHandler(button, eventType, buttonState);
+      }
+    }
+
+  private:
+    void* mEventHandler = nullptr;
+    ButtonConfig::FeatureFlagType mFeatureFlags = 0;
+};
+
+LegacyDispatcher legacyDispatcher;
+ButtonConfig buttonConfig;
+
+//-----------------------------------------------------------------------------
+
+void printResult(const char* label, unsigned long elapsedMicros) {
+  SERIAL_PORT_MONITOR.print(label);
+  SERIAL_PORT_MONITOR.print(' ');
+  SERIAL_PORT_MONITOR.print(elapsedMicros);
+  SERIAL_PORT_MONITOR.print(' ');
+  SERIAL_PORT_MONITOR.println(NUM_ITERATIONS);
+}
+
+// Dispatch through a non-inlined function, like AceButton::handleEvent(), so
+// that the compiler cannot hoist the handler type test out of the loop.
+void __attribute__((noinline)) legacyHandleEvent(
+    const LegacyDispatcher* dispatcher, uint8_t eventType) {
+  dispatcher->dispatchEvent(&button, eventType, LOW);
+}
+
+void __attribute__((noinline)) delegateHandleEvent(
+    const ButtonConfig::Snapshot* config, uint8_t eventType, int64_t now) {
+  config->eventDelegate(&button, eventType, LOW, now, 0);
+}
+
+void runLegacy(const char* label) {
+  unsigned long startMicros = micros();
+  for (uint32_t i = 0; i < NUM_ITERATIONS; i++) {
+    legacyHandleEvent(&legacyDispatcher, (uint8_t) i);
+  }
+  printResult(label, micros() - startMicros);
+}
+
+void runDelegate(const char* label) {
+  // AceButton::checkState() reads the Snapshot once per check.
+  ButtonConfig::Snapshot config = buttonConfig.getSnapshot();
+  unsigned long startMicros = micros();
+  for (uint32_t i = 0; i < NUM_ITERATIONS; i++) {
+    delegateHandleEvent(&config, (uint8_t) i, i);
+  }
+  printResult(label, micros() - startMicros);
+}
+
+void runBenchmarks() {
+  legacyDispatcher.setEventHandler(handleEvent);
+  runLegacy("legacy_function");
+
+  legacyDispatcher.setIEventHandler(&handler);
+  runLegacy("legacy_ievent_handler");
+
+  buttonConfig.setEventHandler(handleEvent);
+  runDelegate("delegate_function");
+
+  buttonConfig.setEventDelegate(EventDelegate::fromFunction<&handleEvent>());
+  runDelegate("delegate_static_function");
+
+  buttonConfig.setIEventHandler(&handler);
+  runDelegate("delegate_ievent_handler");
+
+  buttonConfig.setEventDelegate(
+      EventDelegate::fromMethod<Handler, &Handler::onEvent>(&handler));
+  runDelegate("delegate_method");
+
+  auto lambda = [](AceButton* /*button*/, uint8_t eventType,
+      uint8_t /*buttonState*/) {
+    disableCompilerOptimization = eventType;
+  };
+  buttonConfig.setEventDelegate(EventDelegate::fromCallable(&lambda));
+  runDelegate("delegate_lambda");
+}
+
+//-----------------------------------------------------------------------------
+
+void setup() {
+#if ! defined(EPOXY_DUINO)
+  delay(1000); // Wait for stability on some boards, otherwise garage on Serial
+#endif
+
+  SERIAL_PORT_MONITOR.begin(115200);
+  while (! SERIAL_PORT_MONITOR); // Wait until ready - Leonardo/Micro only
+
+  SERIAL_PORT_MONITOR.println(F("BENCHMARKS"));
+  runBenchmarks();
+  SERIAL_PORT_MONITOR.println(F("END"));
+
+#if defined(EPOXY_DUINO)
+  exit(0);
+#endif
+}
+
+void loop() {}
@@ -0,0 +1,163 @@
+/*
+ * A host benchmark of EventBus. Several producer threads publish events into
+ * their own lane of the bus, while a single consumer thread pops the merged
+ * stream. Each event carries the publication time in microseconds as its
+ * eventTime, so the consumer can measure the latency from publication to
+ * consumption.
+ *
+ * Two scenarios are measured:
+ *
+ *  * saturated: the producers publish as fast as they can, so the lanes fill
+ *    up and events are dropped
+ *  * paced: each producer publishes one event every PACED_INTERVAL_MICROS
+ *
+ * Prints the scenario, the number of events consumed per second, the total
+ * number of dropped events, and the p50/p99/p99.9/max latency in micros, in
+ * the following format:
+ *
+ * @verbatim
+ * BENCHMARKS
+ * saturated {eventsPerSecond} {drops} {p50} {p99} {p99.9} {max}
+ * paced {eventsPerSecond} {drops} {p50} {p99} {p99.9} {max}
+ * END
+ * @endverbatim
+ *
+ * The results are meaningful only on a machine with at least
+ * (NUM_PRODUCERS + 1) cores. With fewer cores, the latency is dominated by the
+ * time slices of the operating system scheduler.
+ *
+ * Requires std::thread, so it runs on EpoxyDuino and ESP-IDF, not on AVR.
+ */
+
+#include <Arduino.h>
+#include <AceButton.h>
+#include <EventBus.h>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <thread>
+#include <vector>
+
+using namespace ace_button;
+
+#if !defined(SERIAL_PORT_MONITOR)
+#define SERIAL_PORT_MONITOR Serial
+#endif
+
+const uint8_t NUM_PRODUCERS = 4;
+const uint32_t LANE_CAPACITY = 256;
+const uint32_t EVENTS_PER_PRODUCER = 200000;
+const uint32_t PACED_INTERVAL_MICROS = 10;
+
+typedef EventBus<NUM_PRODUCERS, LANE_CAPACITY> Bus;
+
+AceButton buttons[NUM_PRODUCERS];
+
+//-----------------------------------------------------------------------------
+
+int64_t nowMicros() {
+  return std::chrono::duration_cast<std::chrono::microseconds>(
+      std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+void produce(Bus* bus, uint8_t producer, uint32_t intervalMicros) {
+  Bus::Lane& lane = bus->getLane(producer);
+  int64_t next = nowMicros();
+  for (uint32_t i = 0; i < EVENTS_PER_PRODUCER; i++) {
+    if (intervalMicros) {
+      while (nowMicros() < next) {}
+      next += intervalMicros;
+    }
+    lane.handleEvent(&buttons[producer], AceButton::kEventRepeatPressed, LOW,
+        nowMicros(), 0);
+  }
+}
+
+uint32_t percentile(const std::vector<uint32_t>& sorted, uint32_t perMille) {
+  if (sorted.empty()) return 0;
+  size_t index = (size_t) ((sorted.size() - 1) * (uint64_t) perMille / 1000);
+  return sorted[index];
+}
+
+void runScenario(const char* label, uint32_t intervalMicros) {
+  static Bus bus;
+  std::vector<uint32_t> latencies;
+  latencies.reserve(NUM_PRODUCERS * EVENTS_PER_PRODUCER);
+
+  uint32_t initialDrops = 0;
+  for (uint8_t i = 0; i < NUM_PRODUCERS; i++) {
+    initialDrops += bus.getDropCount(i);
+  }
+
+  std::atomic<uint8_t> running(NUM_PRODUCERS);
+  int64_t start = nowMicros();
+  std::vector<std::thread> producers;
+  for (uint8_t i = 0; i < NUM_PRODUCERS; i++) {
+    producers.emplace_back([&bus, &running, i, intervalMicros]() {
+      produce(&bus, i, intervalMicros);
+      running--;
+    });
+  }
+
+  ButtonEvent event;
+  while (true) {
+    // Read the flag before popping, so that no event published before the
+    // last producer finished can be missed.
+    bool done = (running.load() == 0);
+    bool popped = false;
+    while (bus.pop(event)) {
+      latencies.push_back((uint32_t) (nowMicros() - event.eventTime));
+      popped = true;
+    }
+    if (done && ! popped) break;
+    if (! popped) std::this_thread::yield();
+  }
+  int64_t elapsed = nowMicros() - start;
+  for (std::thread& producer : producers) producer.join();
+
+  uint32_t drops = 0;
+  for (uint8_t i = 0; i < NUM_PRODUCERS; i++) {
+    drops += bus.getDropCount(i);
+  }
+  drops -= initialDrops;
+
+  std::sort(latencies.begin(), latencies.end());
+  unsigned long eventsPerSecond = (unsigned long) (
+      latencies.size() * (uint64_t) 1000000 / (elapsed ? elapsed : 1));
+
+  SERIAL_PORT_MONITOR.print(label);
+  SERIAL_PORT_MONITOR.print(' ');
+  SERIAL_PORT_MONITOR.print(eventsPerSecond);
+  SERIAL_PORT_MONITOR.print(' ');
+  SERIAL_PORT_MONITOR.print(drops);
+  SERIAL_PORT_MONITOR.print(' ');
+  SERIAL_PORT_MONITOR.print(percentile(latencies, 500));
+  SERIAL_PORT_MONITOR.print(' ');
+  SERIAL_PORT_MONITOR.print(percentile(latencies, 990));
+  SERIAL_PORT_MONITOR.print(' ');
+  SERIAL_PORT_MONITOR.print(percentile(latencies, 999));
+  SERIAL_PORT_MONITOR.print(' ');
+  SERIAL_PORT_MONITOR.println(latencies.empty() ? 0 : latencies.back());
+}
+
+//-----------------------------------------------------------------------------
+
+void setup() {
+#if ! defined(EPOXY_DUINO)
+  delay(1000); // Wait for stability on some boards, otherwise garage on Serial
+#endif
+
+  SERIAL_PORT_MONITOR.begin(115200);
+  while (! SERIAL_PORT_MONITOR); // Wait until ready - Leonardo/Micro only
+
+  SERIAL_PORT_MONITOR.println(F("BENCHMARKS"));
+  runScenario("saturated", 0);
+  runScenario("paced", PACED_INTERVAL_MICROS);
+  SERIAL_PORT_MONITOR.println(F("END"));
+
+#if defined(EPOXY_DUINO)
+  exit(0);
+#endif
+}
+
+void loop() {}
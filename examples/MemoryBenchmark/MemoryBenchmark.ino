@@ -18,6 +18,7 @@
 #define FEATURE_ENCODED_8TO3_BUTTON_CONFIG 7
 #define FEATURE_ENCODED_BUTTON_CONFIG 8
 #define FEATURE_LADDER_BUTTON_CONFIG 9
+#define FEATURE_SHARED_TIMING_PROFILE 10
 
 // Select one of the FEATURE_* parameters and compile. Then look at the flash
 // and RAM usage, compared to FEATURE_BASELINE usage to determine how much
@@ -172,6 +173,19 @@ void handleEvent(AceButton* /* button */, uint8_t /* eventType */,
   static LadderButtonConfig buttonConfig(
     ANALOG_BUTTON_PIN, NUM_LEVELS, LEVELS, NUM_BUTTONS, BUTTONS
   );
+
+#elif FEATURE == FEATURE_SHARED_TIMING_PROFILE
+  static const ButtonConfig::TimingProfile TIMING_PROFILE = {
+    50, 300, 600, 2000, 2000, 300, 10000
+  };
+  ButtonConfig buttonConfig;
+  ButtonConfig config2;
+  ButtonConfig config3;
+  ButtonConfig config4;
+  AceButton b1(&buttonConfig, 2);
+  AceButton b2(&config2, 3);
+  AceButton b3(&config3, 4);
+  AceButton b4(&config4, 5);
 #endif
 
 // TeensyDuino seems to pull in malloc() and free() when a class with virtual
@@ -224,6 +238,18 @@ void setup() {
   pinMode(PINS[2], INPUT_PULLUP);
 #elif FEATURE == FEATURE_LADDER_BUTTON_CONFIG
   pinMode(ANALOG_BUTTON_PIN, INPUT);
+#elif FEATURE == FEATURE_SHARED_TIMING_PROFILE
+  pinMode(2, INPUT_PULLUP);
+  pinMode(3, INPUT_PULLUP);
+  pinMode(4, INPUT_PULLUP);
+  pinMode(5, INPUT_PULLUP);
+  buttonConfig.setTimingProfile(&TIMING_PROFILE);
+  config2.setTimingProfile(&TIMING_PROFILE);
+  config3.setTimingProfile(&TIMING_PROFILE);
+  config4.setTimingProfile(&TIMING_PROFILE);
+  config2.setEventHandler(handleEvent);
+  config3.setEventHandler(handleEvent);
+  config4.setEventHandler(handleEvent);
 #endif
 
   // Configure the ButtonConfig with the event handler, and enable all higher
@@ -280,5 +306,10 @@ void loop() {
   buttonConfig.checkButtons();
 #elif FEATURE == FEATURE_LADDER_BUTTON_CONFIG
   buttonConfig.checkButtons();
+#elif FEATURE == FEATURE_SHARED_TIMING_PROFILE
+  b1.check();
+  b2.check();
+  b3.check();
+  b4.check();
 #endif
 }
@@ -93,6 +93,8 @@ $ make README.md
 * Encoded8To3ButtonConfig: 7 `AceButton` using a `Encoded8To3ButtonConfig`
 * EncodedButtonConfig: 7 `AceButton` using a `EncodedButtonConfig`
 * LadderButtonConfig: 7 `AceButton` using a `LadderButtonConfig`
+* ButtonConfig x4, TimingProfile: 4 `AceButton` using 4 `ButtonConfig`
+  which share one `TimingProfile`
 
 ## Library Size Changes
 
@@ -195,6 +197,45 @@ $ make README.md
     * Increases flash size of `ButtonConfig` by ~150 bytes on AVR, ~50 bytes on
       32-bit processors.
 
+**Unreleased**
+* Store the timing parameters of `ButtonConfig` as `uint16_t` in a
+  `TimingProfile`, instead of `int64_t`.
+    * `sizeof(ButtonConfig)` drops from 72 to 56 bytes on 32-bit processors,
+      and stays at 80 bytes on a 64-bit host, where the second copy of the
+      16-byte `EventDelegate` in the double-buffered configuration takes the
+      space saved by the narrower delays.
+    * Several `ButtonConfig` instances can share a const `TimingProfile`
+      which lives in flash, using `setTimingProfile()`. The pointer to the
+      profile is stored in place of the config's own delays, so sharing
+      costs no RAM.
+    * Add `ButtonConfig x4, TimingProfile` to measure 4 configs sharing one
+      profile.
+    * The board tables below have not been regenerated yet, because the
+      board toolchains were not available: run `collect.sh` to add the new
+      row. In the meantime, the following table gives the static RAM of the
+      objects defined by `MemoryBenchmark.ino`, in bytes, compared to
+      v1.10.1. It was measured by compiling the sketch with g++ 12.2 (`-Os`)
+      for a 64-bit host, and with `-m32 -malign-double` for the 32-bit
+      layout (with 8-byte aligned `int64_t`, like the ESP32), then adding up
+      the sizes of its data and bss symbols reported by `nm -S`. The
+      v1.10.1 row for `ButtonConfig x4, TimingProfile` uses the same objects
+      without the profile. `EncodedButtonConfig` and `LadderButtonConfig`
+      are also 8 bytes larger on the 64-bit host because of other changes
+      in this release.
+
+```
++----------------------------------------------------------------+
+| functionality                   |   32-bit ram |   64-bit ram |
+|                                 | v1.10.1/ now | v1.10.1/ now |
+|---------------------------------+--------------+--------------|
+| Encoded4To2ButtonConfig         |    252/  232 |    260/  260 |
+| Encoded8To3ButtonConfig         |    476/  456 |    484/  484 |
+| EncodedButtonConfig             |    512/  496 |    556/  564 |
+| LadderButtonConfig              |    512/  496 |    556/  564 |
+| ButtonConfig x4, TimingProfile  |    516/  452 |    548/  548 |
++----------------------------------------------------------------+
+```
+
 ## ATtiny85
 
 * 8MHz ATtiny85
@@ -16,6 +16,7 @@ BEGIN {
   labels[7] = "Encoded8To3ButtonConfig"
   labels[8] = "EncodedButtonConfig"
   labels[9] = "LadderButtonConfig"
+  labels[10] = "ButtonConfig x4, TimingProfile"
   record_index = 0
 }
 {
@@ -47,7 +48,8 @@ END {
     if (name ~ /^Baseline$/ \
         || name ~ /^ButtonConfig$/ \
         || name ~ /^Encoded4To2ButtonConfig$/ \
-        || name ~ /^LadderButtonConfig$/) {
+        || name ~ /^LadderButtonConfig$/ \
+        || name ~ /^ButtonConfig x4/) {
       printf(\
         "|---------------------------------+--------------+-------------|\n")
     }
@@ -0,0 +1,181 @@
+/*
+ * A program that measures how the scan of a large panel of buttons scales
+ * with the number of buttons, at 1024 and 4096 buttons. It must be compiled
+ * with ACE_BUTTON_WIDE_INDEX=1 (see the Makefile), because the pins, ids and
+ * counts do not fit in 8 bits.
+ *
+ * Two kinds of panels are measured:
+ *
+ *  * encoded_array: an EncodedButtonConfig with 12 encoder pins, whose
+ *    buttons are stored by value in a ButtonArray
+ *  * group: a ButtonGroup of CompactButton, which do not hold a pointer to
+ *    their ButtonConfig
+ *
+ * One button is pressed at a time, moving to the next button on every scan,
+ * so that the scans include the debouncing and the event dispatching.
+ *
+ * Prints the size of the button classes, then the label, the number of
+ * buttons, the micros per scan of the whole panel, and the RAM used by the
+ * buttons, in the following format. These numbers were obtained using
+ * EpoxyDuino on a Linux x86_64 machine:
+ *
+ * @verbatim
+ * BENCHMARKS
+ * sizeof AceButton 56 CompactButton 48
+ * encoded_array 1024 72 57352
+ * encoded_array 4096 294 229384
+ * group 1024 69 49152
+ * group 4096 289 196608
+ * END
+ * @endverbatim
+ *
+ * The cost of a scan is linear in the number of buttons, about 70 ns per
+ * button. The wide indexes do not change the size of the buttons, since the
+ * 16-bit pin and id fit in the padding before the 64-bit timestamps.
+ *
+ * The buttons are allocated on the heap. The 4096 rows need about 200 kB, so
+ * on an ESP32 they are skipped unless PSRAM is available.
+ */
+
+#include <Arduino.h>
+#include <AceButton.h>
+#include <ButtonArray.h>
+#include <ButtonGroup.h>
+#include <new>
+
+using namespace ace_button;
+
+#if !defined(SERIAL_PORT_MONITOR)
+#define SERIAL_PORT_MONITOR Serial
+#endif
+
+#if ! ACE_BUTTON_WIDE_INDEX
+  #error ScalingBenchmark requires ACE_BUTTON_WIDE_INDEX=1
+#endif
+
+const uint16_t SMALL_PANEL = 1024;
+const uint16_t LARGE_PANEL = 4096;
+const uint16_t NUM_SCANS = 200;
+
+// 2^12 - 1 virtual pins, enough for the large panel without button 0.
+const uint8_t NUM_ENCODER_PINS = 12;
+const uint8_t ENCODER_PINS[NUM_ENCODER_PINS] = {
+    0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11};
+
+// A volatile integer to prevent the compiler from optimizing away the events.
+volatile uint16_t disableCompilerOptimization = 0;
+
+void handleEvent(AceButton* button, uint8_t /*eventType*/,
+    uint8_t /*buttonState*/) {
+  disableCompilerOptimization = button->getId();
+}
+
+/** An EncodedButtonConfig whose pressed virtual pin is set by the benchmark. */
+class ScanEncodedConfig: public EncodedButtonConfig {
+  public:
+    ScanEncodedConfig():
+        EncodedButtonConfig(NUM_ENCODER_PINS, ENCODER_PINS, 0,
+            (AceButton*) nullptr) {}
+
+    ButtonPinType getVirtualPin() const override { return mVirtualPin; }
+
+    ButtonPinType mVirtualPin = 0;
+};
+
+/** A ButtonConfig for the ButtonGroup, which presses one pin at a time. */
+class ScanGroupConfig: public ButtonConfig {
+  public:
+    int readButton(ButtonPinType pin) override {
+      return (pin == mVirtualPin) ? LOW : HIGH;
+    }
+
+    ButtonPinType mVirtualPin = 0;
+};
+
+//-----------------------------------------------------------------------------
+
+void printResult(const char* label, uint16_t numButtons,
+    unsigned long elapsedMicros, unsigned long bytes) {
+  SERIAL_PORT_MONITOR.print(label);
+  SERIAL_PORT_MONITOR.print(' ');
+  SERIAL_PORT_MONITOR.print(numButtons);
+  SERIAL_PORT_MONITOR.print(' ');
+  SERIAL_PORT_MONITOR.print(elapsedMicros / NUM_SCANS);
+  SERIAL_PORT_MONITOR.print(' ');
+  SERIAL_PORT_MONITOR.println(bytes);
+}
+
+template <uint16_t N>
+void runEncodedArray() {
+  auto* buttons = new (std::nothrow) ButtonArray<N>;
+  if (buttons == nullptr) return;
+  for (uint16_t i = 0; i < N; i++) {
+    buttons->add(nullptr, i + 1, HIGH, i);
+  }
+
+  ScanEncodedConfig config;
+  config.setEventHandler(handleEvent);
+  config.setButtons(buttons->size(), buttons->data());
+
+  unsigned long startMicros = micros();
+  for (uint16_t scan = 0; scan < NUM_SCANS; scan++) {
+    config.mVirtualPin = scan % N + 1;
+    config.checkButtons();
+  }
+  printResult("encoded_array", N, micros() - startMicros, sizeof(*buttons));
+  delete buttons;
+}
+
+template <uint16_t N>
+void runGroup() {
+  auto* buttons = new (std::nothrow) CompactButton[N];
+  if (buttons == nullptr) return;
+  for (uint16_t i = 0; i < N; i++) {
+    buttons[i].init(i + 1, HIGH, i);
+  }
+
+  ScanGroupConfig config;
+  config.setEventHandler(handleEvent);
+  ButtonGroup group(&config, buttons, N);
+
+  unsigned long startMicros = micros();
+  for (uint16_t scan = 0; scan < NUM_SCANS; scan++) {
+    config.mVirtualPin = scan % N + 1;
+    group.checkButtons();
+  }
+  printResult("group", N, micros() - startMicros, N * sizeof(CompactButton));
+  delete[] buttons;
+}
+
+void runBenchmarks() {
+  SERIAL_PORT_MONITOR.print(F("sizeof AceButton "));
+  SERIAL_PORT_MONITOR.print(sizeof(AceButton));
+  SERIAL_PORT_MONITOR.print(F(" CompactButton "));
+  SERIAL_PORT_MONITOR.println(sizeof(CompactButton));
+
+  runEncodedArray<SMALL_PANEL>();
+  runEncodedArray<LARGE_PANEL>();
+  runGroup<SMALL_PANEL>();
+  runGroup<LARGE_PANEL>();
+}
+
+//-----------------------------------------------------------------------------
+
+void setup() {
+#if ! defined(EPOXY_DUINO)
+  delay(1000); // Wait for stability on some boards, otherwise garage on Serial
+#endif
+
+  SERIAL_PORT_MONITOR.begin(115200);
+  while (! SERIAL_PORT_MONITOR); // Wait until ready - Leonardo/Micro only
+
+  SERIAL_PORT_MONITOR.println(F("BENCHMARKS"));
+  runBenchmarks();
+  SERIAL_PORT_MONITOR.println(F("END"));
+
+#if defined(EPOXY_DUINO)
+  exit(0);
+#endif
+}
+
+void loop() {}
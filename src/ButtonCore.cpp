@@ -0,0 +1,680 @@
+/*
+MIT License
+
+Copyright (c) 2018 Brian T. Park
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#include <stddef.h> // offsetof
+#include "include/AceButton.h"
+
+namespace ace_button {
+
+//-----------------------------------------------------------------------------
+
+// Macros to perform compile-time assertions. See
+// https://www.embedded.com/electronics-blogs/programming-pointers/4025549/Catching-errors-early-with-compile-time-assertions
+// and https://gcc.gnu.org/onlinedocs/gcc/Common-Function-Attributes.html
+#define CONCAT_(x, y) x##y
+#define CONCAT(x,y) CONCAT_(x,y)
+#define COMPILE_TIME_ASSERT(cond, msg) \
+    extern char CONCAT(compile_time_assert, __LINE__)[(cond) ? 1 : -1];
+
+// Check that the Arduino constants HIGH and LOW are defined to be 1 and 0,
+// respectively. Otherwise, this library won't work.
+COMPILE_TIME_ASSERT(HIGH == 1, "HIGH must be 1")
+COMPILE_TIME_ASSERT(LOW == 0, "LOW must be 0")
+
+// On boards using the new PinStatus API, check that kButtonStateUnknown is
+// different from all other PinStatus enums.
+#if ARDUINO_API_VERSION >= 10000
+  COMPILE_TIME_ASSERT(\
+    ButtonCore::kButtonStateUnknown != LOW \
+    && ButtonCore::kButtonStateUnknown != HIGH \
+    && ButtonCore::kButtonStateUnknown != CHANGE \
+    && ButtonCore::kButtonStateUnknown != FALLING \
+    && ButtonCore::kButtonStateUnknown != RISING, \
+    "kButtonStateUnknown conflicts with PinStatus enum")
+#endif
+
+//-----------------------------------------------------------------------------
+
+static const char sEventPressed[] = "Pressed";
+static const char sEventReleased[] = "Released";
+static const char sEventClicked[] = "Clicked";
+static const char sEventDoubleClicked[] = "DoubleClicked";
+static const char sEventLongPressed[] = "LongPressed";
+static const char sEventRepeatPressed[] = "RepeatPressed";
+static const char sEventLongReleased[] = "LongReleased";
+static const char sEventHeartBeat[] = "HeartBeat";
+static const char sEventUnknown[] = "(unknown)";
+
+static const char* const sEventNames[] = {
+  sEventPressed,
+  sEventReleased,
+  sEventClicked,
+  sEventDoubleClicked,
+  sEventLongPressed,
+  sEventRepeatPressed,
+  sEventLongReleased,
+  sEventHeartBeat,
+};
+
+const char* ButtonCore::eventName(uint8_t event) {
+  // const char* name = (event >= sizeof(sEventNames) / sizeof(const char*))
+  //     ? sEventUnknown
+  //     : (const char*) ((void*)__LPM_word((uint16_t)(&sEventNames + event)));
+  return sEventUnknown;
+}
+
+//-----------------------------------------------------------------------------
+
+void ButtonCore::init(ButtonPinType pin, uint8_t defaultReleasedState,
+    ButtonIdType id) {
+  mPin = pin;
+  mId = id;
+  mFlags = 0;
+  mLastButtonState = kButtonStateUnknown;
+  setDefaultReleasedState(defaultReleasedState);
+#if ACE_BUTTON_ENABLE_EDGE_LATENCY
+  mEdgeTime = 0;
+  mIsrEdgePending.store(false, std::memory_order_relaxed);
+#endif
+}
+
+void ButtonCore::setDefaultReleasedState(uint8_t state) {
+  if (state == HIGH) {
+    mFlags |= kFlagDefaultReleasedState;
+  } else {
+    mFlags &= ~kFlagDefaultReleasedState;
+  }
+}
+
+uint8_t ButtonCore::getDefaultReleasedState() const {
+  return (mFlags & kFlagDefaultReleasedState) ? HIGH : LOW;
+}
+
+void ButtonCore::primeState(int buttonState) {
+  // Keep only the wiring of the button, and drop any debouncing or click in
+  // progress, as init() does.
+  mFlags &= kFlagDefaultReleasedState;
+  mLastButtonState = buttonState;
+#if ACE_BUTTON_ENABLE_EDGE_LATENCY
+  mIsrEdgePending.store(false, std::memory_order_relaxed);
+#endif
+}
+
+int ButtonCore::sampleState(ButtonConfig* buttonConfig, uint8_t numSamples)
+    const {
+  if (numSamples == 0) numSamples = 1;
+  uint8_t numPressed = 0;
+  for (uint8_t i = 0; i < numSamples; i++) {
+    if (! isReleased(buttonConfig->readButton(getPin()))) numPressed++;
+  }
+  uint8_t releasedState = getDefaultReleasedState();
+  return (numPressed > numSamples - numPressed)
+      ? (releasedState ^ 0x1) : releasedState;
+}
+
+/** Return the age of the given time, clamped to the range of T. */
+template <typename T>
+static T ageOf(int64_t now, int64_t time, T maxAge) {
+  int64_t age = now - time;
+  if (age < 0) return 0;
+  return (age > maxAge) ? maxAge : (T) age;
+}
+
+/**
+ * CRC-8 (polynomial 0x07) of the bytes of the state before its crc, starting
+ * from kSavedStateVersion so that a state of another format does not match.
+ */
+static uint8_t savedStateCrc(const ButtonCore::SavedState& state) {
+  const uint8_t* data = reinterpret_cast<const uint8_t*>(&state);
+  uint8_t crc = ButtonCore::kSavedStateVersion;
+  for (size_t i = 0; i < offsetof(ButtonCore::SavedState, crc); i++) {
+    crc ^= data[i];
+    for (uint8_t bit = 0; bit < 8; bit++) {
+      crc = (crc & 0x80) ? (uint8_t) ((crc << 1) ^ 0x07) : (uint8_t) (crc << 1);
+    }
+  }
+  return crc;
+}
+
+void ButtonCore::saveState(ButtonConfig* buttonConfig, SavedState& state)
+    const {
+  int64_t now = buttonConfig->getClock();
+  state.pressAge = ageOf<uint32_t>(now, mLastPressTime, UINT32_MAX);
+  state.clickAge = ageOf<uint16_t>(now, mLastClickTime, UINT16_MAX);
+  state.repeatPressAge =
+      ageOf<uint16_t>(now, mLastRepeatPressTime, UINT16_MAX);
+  state.debounceAge = ageOf<uint16_t>(now, mLastDebounceTime, UINT16_MAX);
+  state.heartBeatAge = ageOf<uint16_t>(now, mLastHeartBeatTime, UINT16_MAX);
+  state.flags = mFlags;
+  state.lastButtonState = mLastButtonState;
+  state.crc = savedStateCrc(state);
+}
+
+bool ButtonCore::restoreState(ButtonConfig* buttonConfig,
+    const SavedState& state, int64_t elapsedMillis) {
+  if (state.crc != savedStateCrc(state)) return false;
+  if (state.lastButtonState != HIGH && state.lastButtonState != LOW
+      && state.lastButtonState != kButtonStateUnknown) {
+    return false;
+  }
+
+  // The clock time at which the state was saved, so that a long press which
+  // started before the sleep fires at the expected time after the wake.
+  int64_t then = buttonConfig->getClock() - elapsedMillis;
+  mLastPressTime = then - (int64_t) state.pressAge;
+  mLastClickTime = then - (int64_t) state.clickAge;
+  mLastRepeatPressTime = then - (int64_t) state.repeatPressAge;
+  mLastDebounceTime = then - (int64_t) state.debounceAge;
+  mLastHeartBeatTime = then - (int64_t) state.heartBeatAge;
+  mFlags = (mFlags & kFlagDefaultReleasedState)
+      | (state.flags & ~kFlagDefaultReleasedState);
+  mLastButtonState = state.lastButtonState;
+#if ACE_BUTTON_ENABLE_EDGE_LATENCY
+  mIsrEdgePending.store(false, std::memory_order_relaxed);
+#endif
+  return true;
+}
+
+void ButtonCore::checkState(ButtonConfig* buttonConfig, AceButton* button,
+    int buttonState) {
+#if ACE_BUTTON_ENABLE_CHECK_TIMING
+  uint32_t startCycles = readCycleCounter();
+#endif
+#if ACE_BUTTON_ENABLE_STATS
+  int64_t startMicros = esp_timer_get_time();
+  ButtonStatsRecorder& recorder = buttonConfig->getStatsRecorder();
+  recorder.beginUpdate();
+  ButtonStats& stats = recorder.stats();
+  stats.numChecks++;
+  bool wasDebouncing = isFlag(kFlagDebouncing);
+#endif
+
+  // Retrieve the current time just once and use that in the various checkXxx()
+  // functions below. This provides some robustness of the various timing
+  // algorithms even if one of the event handlers takes more time than the
+  // threshold time limits such as 'debounceDelay' or longPressDelay'.
+  int64_t now = buttonConfig->getClock();
+
+  // Likewise, read a consistent snapshot of the timing parameters, features
+  // and event handler just once, so that a concurrent change of the
+  // ButtonConfig from another task cannot take effect halfway through.
+  CheckContext config;
+  config.buttonConfig = buttonConfig;
+  config.button = button;
+  buttonConfig->readSnapshot(config);
+
+#if ACE_BUTTON_ENABLE_SCAN_MONITOR
+  buttonConfig->getScanMonitor().recordScan(this, now, config.debounceDelay);
+#endif
+
+  // Send heart beat if enabled and needed. Purposely placed outside of the
+  // checkDebounced() guard so that it can fire regardless of the state of the
+  // debouncing logic.
+  checkHeartBeat(config, now);
+
+  // Debounce the button, and send any events detected.
+  if (checkDebounced(config, now, buttonState)) {
+#if ACE_BUTTON_ENABLE_STATS
+    if (wasDebouncing && buttonState == getLastButtonState()) {
+      stats.numEdgesRejected++;
+    }
+#endif
+    // check if the button was initialized (i.e. UNKNOWN state)
+    if (checkInitialized(buttonState)) {
+      checkEvent(config, now, buttonState);
+    }
+  }
+#if ACE_BUTTON_ENABLE_STATS
+  else if (! wasDebouncing) {
+    stats.numEdges++;
+  }
+
+  uint32_t elapsedMicros = (uint32_t) (esp_timer_get_time() - startMicros);
+  if (elapsedMicros > stats.maxCheckMicros) {
+    stats.maxCheckMicros = elapsedMicros;
+  }
+  recorder.endUpdate();
+#endif
+#if ACE_BUTTON_ENABLE_CHECK_TIMING
+  buttonConfig->getCheckStateTimes().record(readCycleCounter() - startCycles);
+#endif
+}
+
+int64_t ButtonCore::getNextDeadline(ButtonConfig* buttonConfig) const {
+  ButtonConfig::Snapshot config;
+  buttonConfig->readSnapshot(config);
+  int64_t deadline = kNoDeadline;
+
+  // A check is needed to start the heart beat or to read the initial state.
+  if (config.isFeature(ButtonConfig::kFeatureHeartBeat)) {
+    if (! isFlag(kFlagHeartRunning)) return INT64_MIN;
+    deadline = minTime(deadline,
+        mLastHeartBeatTime + config.heartBeatInterval);
+  }
+  if (isFlag(kFlagDebouncing)) {
+    deadline = minTime(deadline, mLastDebounceTime + config.debounceDelay);
+  }
+  if (mLastButtonState == kButtonStateUnknown) {
+    return isFlag(kFlagDebouncing) ? deadline : INT64_MIN;
+  }
+
+  // Postponed and orphaned clicks, see checkPostponedClick() and
+  // checkOrphanedClick().
+  if ((config.isFeature(ButtonConfig::kFeatureClick)
+          || config.isFeature(ButtonConfig::kFeatureDoubleClick))
+      && (isFlag(kFlagClickPostponed) || isFlag(kFlagClicked))) {
+    deadline = minTime(deadline, mLastClickTime + config.doubleClickDelay);
+  }
+
+  // LongPressed and RepeatPressed, see checkLongPress() and
+  // checkRepeatPress().
+  if (mLastButtonState != getDefaultReleasedState() && isFlag(kFlagPressed)) {
+    if (config.isFeature(ButtonConfig::kFeatureLongPress)
+        && ! isFlag(kFlagLongPressed)) {
+      deadline = minTime(deadline, mLastPressTime + config.longPressDelay);
+    }
+    if (config.isFeature(ButtonConfig::kFeatureRepeatPress)) {
+      deadline = minTime(deadline, isFlag(kFlagRepeatPressed)
+          ? mLastRepeatPressTime + config.repeatPressInterval
+          : mLastPressTime + config.repeatPressDelay);
+    }
+  }
+
+  return deadline;
+}
+
+void ButtonCore::checkEvent(const CheckContext& config, int64_t now,
+    int buttonState) {
+  // We need to remove orphaned clicks even if just Click is enabled. It is not
+  // sufficient to do this for just DoubleClick. That's because it's possible
+  // for a Clicked event to be generated, then 65.536 seconds later, the
+  // ButtonConfig could be changed to enable DoubleClick. (Such real-time change
+  // of ButtonConfig is not recommended, but is sometimes convenient.) If the
+  // orphaned click is not cleared, then the next Click would be errorneously
+  // considered to be a DoubleClick. Therefore, we must clear the orphaned click
+  // even if just the Clicked event is enabled.
+  //
+  // We also need to check of any postponed clicks that got generated when
+  // kFeatureSuppressClickBeforeDoubleClick was enabled.
+  if (config.isFeature(ButtonConfig::kFeatureClick) ||
+      config.isFeature(ButtonConfig::kFeatureDoubleClick)) {
+    checkPostponedClick(config, now);
+    checkOrphanedClick(config, now);
+  }
+
+  if (config.isFeature(ButtonConfig::kFeatureLongPress)) {
+    checkLongPress(config, now, buttonState);
+  }
+  if (config.isFeature(ButtonConfig::kFeatureRepeatPress)) {
+    checkRepeatPress(config, now, buttonState);
+  }
+  if (buttonState != getLastButtonState()) {
+    checkChanged(config, now, buttonState);
+  }
+}
+
+bool ButtonCore::checkDebounced(const CheckContext& config,
+    int64_t now, int buttonState) {
+  if (isFlag(kFlagDebouncing)) {
+
+    // NOTE: This is a bit tricky. The elapsedTime will be valid even if the
+    // uint16_t representation of 'now' rolls over so that (now <
+    // mLastDebounceTime). This is true as long as the 'unsigned long'
+    // representation of 'now' is < (65536 + mLastDebounceTime). We need to cast
+    // this expression into an uint16_t before doing the '>=' comparison below
+    // for compatability with processors whose sizeof(int) == 4 instead of 2.
+    // For those processors, the expression (now - mLastDebounceTime >=
+    // getDebounceDelay()) won't work because the terms in the expression get
+    // promoted to an (int).
+    int64_t elapsedTime = now - mLastDebounceTime;
+
+    bool isDebouncingTimeOver =
+        (elapsedTime >= config.debounceDelay);
+
+    if (isDebouncingTimeOver) {
+      clearFlag(kFlagDebouncing);
+      return true;
+    } else {
+      return false;
+    }
+  } else {
+    // Currently not in debouncing phase. Check for a button state change. This
+    // will also detect a transition from kButtonStateUnknown to HIGH or LOW.
+    if (buttonState == getLastButtonState()) {
+      // no change, return immediately
+      return true;
+    }
+
+    // button has changed so, enter debouncing phase
+    setFlag(kFlagDebouncing);
+    mLastDebounceTime = now;
+#if ACE_BUTTON_ENABLE_EDGE_LATENCY
+    mEdgeTime = consumeEdgeTime(config, now);
+#endif
+    return false;
+  }
+}
+
+bool ButtonCore::checkInitialized(uint16_t buttonState) {
+  if (mLastButtonState != kButtonStateUnknown) {
+    return true;
+  }
+
+  // If transitioning from the initial "unknown" button state, just set the last
+  // valid button state, but don't fire off the event handler. This handles the
+  // case where a momentary switch is pressed down, then the board is rebooted.
+  // When the board comes up, it should not fire off the event handler. This
+  // also handles the case of a 2-position switch set to the "pressed"
+  // position, and the board is rebooted.
+  mLastButtonState = buttonState;
+  return false;
+}
+
+void ButtonCore::checkLongPress(const CheckContext& config,
+    int64_t now, int buttonState) {
+  if (buttonState == getDefaultReleasedState()) {
+    return;
+  }
+
+  if (isFlag(kFlagPressed) && !isFlag(kFlagLongPressed)) {
+    int64_t elapsedTime = now - mLastPressTime;
+    if (elapsedTime >= config.longPressDelay) {
+      setFlag(kFlagLongPressed);
+      handleEvent(config, kEventLongPressed, now);
+    }
+  }
+}
+
+void ButtonCore::checkRepeatPress(const CheckContext& config,
+    int64_t now, int buttonState) {
+  if (buttonState == getDefaultReleasedState()) {
+    return;
+  }
+
+  if (isFlag(kFlagPressed)) {
+    if (isFlag(kFlagRepeatPressed)) {
+      int64_t elapsedTime = now - mLastRepeatPressTime;
+      if (elapsedTime >= config.repeatPressInterval) {
+        handleEvent(config, kEventRepeatPressed, now);
+        mLastRepeatPressTime = now;
+      }
+    } else {
+      int64_t elapsedTime = now - mLastPressTime;
+      if (elapsedTime >= config.repeatPressDelay) {
+        setFlag(kFlagRepeatPressed);
+        // Trigger the RepeatPressed immedidately, instead of waiting until the
+        // first getRepeatPressInterval() has passed.
+        handleEvent(config, kEventRepeatPressed, now);
+        mLastRepeatPressTime = now;
+      }
+    }
+  }
+}
+
+void ButtonCore::checkChanged(const CheckContext& config, int64_t now,
+    int buttonState) {
+  mLastButtonState = buttonState;
+  checkPressed(config, now, buttonState);
+  checkReleased(config, now, buttonState);
+}
+
+void ButtonCore::checkPressed(const CheckContext& config, int64_t now,
+    int buttonState) {
+  if (buttonState == getDefaultReleasedState()) {
+    return;
+  }
+
+  // button was pressed
+  mLastPressTime = now;
+  setFlag(kFlagPressed);
+  handleEvent(config, kEventPressed, now);
+}
+
+void ButtonCore::checkReleased(const CheckContext& config,
+    int64_t now, int buttonState) {
+  if (buttonState != getDefaultReleasedState()) {
+    return;
+  }
+
+  // Check for click (before sending off the Released event).
+  // Make sure that we don't clearPressed() before calling this.
+  if (config.isFeature(ButtonConfig::kFeatureClick)
+      || config.isFeature(ButtonConfig::kFeatureDoubleClick)) {
+    checkClicked(config, now);
+  }
+
+  // Save whether this was generated from a long press.
+  bool wasLongPressed = isFlag(kFlagLongPressed);
+
+  // The press time is valid only if the Pressed event was seen, which is not
+  // the case if the button was already pressed when the device booted.
+  int64_t duration = isFlag(kFlagPressed) ? now - mLastPressTime : 0;
+
+  // Check if Released events are suppressed.
+  bool suppress =
+      ((isFlag(kFlagLongPressed) &&
+          config.isFeature(ButtonConfig::kFeatureSuppressAfterLongPress)) ||
+      (isFlag(kFlagRepeatPressed) &&
+          config.isFeature(ButtonConfig::kFeatureSuppressAfterRepeatPress)) ||
+      (isFlag(kFlagClicked) &&
+          config.isFeature(ButtonConfig::kFeatureSuppressAfterClick)) ||
+      (isFlag(kFlagDoubleClicked) &&
+          config.isFeature(ButtonConfig::kFeatureSuppressAfterDoubleClick)));
+
+  // Button was released, so clear current flags. Note that the compiler will
+  // optimize the following 4 statements to be equivalent to this single one:
+  //    mFlags &= ~kFlagPressed & ~kFlagDoubleClicked & ~kFlagLongPressed
+  //        & ~kFlagRepeatPressed;
+  clearFlag(kFlagPressed);
+  clearFlag(kFlagDoubleClicked);
+  clearFlag(kFlagLongPressed);
+  clearFlag(kFlagRepeatPressed);
+
+  // Fire off a Released event, unless suppressed. Replace Released with
+  // LongReleased if this was a LongPressed.
+  if (suppress) {
+    if (wasLongPressed) {
+      handleEvent(config, kEventLongReleased, now, duration);
+    }
+  } else {
+    handleEvent(config, kEventReleased, now, duration);
+  }
+}
+
+void ButtonCore::checkClicked(const CheckContext& config,
+    int64_t now) {
+  int64_t elapsedTime = now - mLastPressTime;
+  if (elapsedTime >= config.clickDelay) {
+    clearFlag(kFlagClicked);
+    return;
+  }
+
+  // check for double click
+  if (config.isFeature(ButtonConfig::kFeatureDoubleClick)) {
+    checkDoubleClicked(config, now);
+  }
+
+  // Suppress a second click (both buttonState change and event message) if
+  // double-click detected, which has the side-effect of preventing 3 clicks
+  // from generating another double-click at the third click.
+  if (isFlag(kFlagDoubleClicked)) {
+    clearFlag(kFlagClicked);
+    return;
+  }
+
+  // we got a single click
+  mLastClickTime = now;
+  setFlag(kFlagClicked);
+  if (config.isFeature(
+      ButtonConfig::kFeatureSuppressClickBeforeDoubleClick)) {
+    setFlag(kFlagClickPostponed);
+  } else {
+    handleEvent(config, kEventClicked, now, elapsedTime);
+  }
+}
+
+void ButtonCore::checkDoubleClicked(const CheckContext& config,
+    int64_t now) {
+  if (!isFlag(kFlagClicked)) {
+    clearFlag(kFlagDoubleClicked);
+    return;
+  }
+
+  int64_t elapsedTime = now - mLastClickTime;
+  if (elapsedTime >= config.doubleClickDelay) {
+    clearFlag(kFlagDoubleClicked);
+    // There should be no postponed Click at this point because
+    // checkPostponedClick() should have taken care of it.
+    return;
+  }
+
+  // If there was a postponed click, suppress it because it could only have been
+  // postponed if kFeatureSuppressClickBeforeDoubleClick was enabled. If we got
+  // to this point, there was a DoubleClick, so we must suppress the first
+  // Click as requested.
+  if (isFlag(kFlagClickPostponed)) {
+    clearFlag(kFlagClickPostponed);
+#if ACE_BUTTON_ENABLE_STATS
+    ButtonStats& stats = config.buttonConfig->getStatsRecorder().stats();
+    stats.numPostponedClicksCancelled++;
+#endif
+  }
+  setFlag(kFlagDoubleClicked);
+  handleEvent(config, kEventDoubleClicked, now);
+}
+
+void ButtonCore::checkOrphanedClick(const CheckContext& config,
+    int64_t now) {
+  // The amount of time which must pass before a click is determined to be
+  // orphaned and reclaimed. If only DoubleClicked is supported, then I think
+  // just getDoubleClickDelay() is correct. No other higher level event uses the
+  // first Clicked event. If TripleClicked becomes supported, I think
+  // orphanedClickDelay will be either (2 * getDoubleClickDelay()) or
+  // (getDoubleClickDelay() + getTripleClickDelay()), depending on whether the
+  // TripleClick has an independent delay time, or reuses the DoubleClick delay
+  // time. But I'm not sure that I've thought through all the details.
+  int64_t orphanedClickDelay = config.doubleClickDelay;
+
+  int64_t elapsedTime = now - mLastClickTime;
+  if (isFlag(kFlagClicked) && (elapsedTime >= orphanedClickDelay)) {
+    clearFlag(kFlagClicked);
+  }
+}
+
+void ButtonCore::checkPostponedClick(const CheckContext& config,
+    int64_t now) {
+  int64_t postponedClickDelay = config.doubleClickDelay;
+  int64_t elapsedTime = now - mLastClickTime;
+  if (isFlag(kFlagClickPostponed) && elapsedTime >= postponedClickDelay) {
+    // The click happened at mLastClickTime. If the button has been pressed
+    // again since then, mLastPressTime no longer belongs to this click, so the
+    // duration is not known.
+    int64_t duration = mLastClickTime - mLastPressTime;
+    handleEvent(config, kEventClicked, now, (duration >= 0) ? duration : 0);
+    clearFlag(kFlagClickPostponed);
+  }
+}
+
+void ButtonCore::checkHeartBeat(const CheckContext& config,
+    int64_t now) {
+  if (! config.isFeature(ButtonConfig::kFeatureHeartBeat)) return;
+
+  // On first call, set the last heart beat time.
+  if (! isFlag(kFlagHeartRunning)) {
+    setFlag(kFlagHeartRunning);
+    mLastHeartBeatTime = now;
+    return;
+  }
+
+  int64_t elapsedTime = now - mLastHeartBeatTime;
+  if (elapsedTime >= config.heartBeatInterval) {
+    // This causes the kEventHeartBeat to be sent with the last validated button
+    // state, not the current button state. I think that makes more sense, but
+    // there might be situations where it doesn't.
+    handleEvent(config, kEventHeartBeat, now);
+    mLastHeartBeatTime = now;
+  }
+}
+
+void ButtonCore::handleEvent(const CheckContext& config,
+    uint8_t eventType, int64_t now, int64_t duration) {
+#if ACE_BUTTON_ENABLE_STATS
+  config.buttonConfig->getStatsRecorder().stats().numEvents[eventType]++;
+#endif
+#if ACE_BUTTON_ENABLE_EDGE_LATENCY
+  if (eventType == kEventPressed || eventType == kEventReleased) {
+    config.buttonConfig->getEdgeLatencies().record(
+        (uint32_t) (now - mEdgeTime));
+  }
+#endif
+  // A proxy (see ButtonGroup) carries the state of the button which is
+  // being checked, so that the handler can query it as usual.
+  AceButton* button = config.button;
+  if (static_cast<ButtonCore*>(button) != this) {
+    copyStateTo(*button);
+  }
+  config.eventDelegate(button, eventType, getLastButtonState(), now, duration);
+}
+
+void ButtonCore::copyStateTo(ButtonCore& proxy) const {
+  proxy.mPin = mPin;
+  proxy.mId = mId;
+  proxy.mFlags = mFlags;
+  proxy.mLastButtonState = mLastButtonState;
+  proxy.mLastDebounceTime = mLastDebounceTime;
+  proxy.mLastClickTime = mLastClickTime;
+  proxy.mLastPressTime = mLastPressTime;
+  proxy.mLastRepeatPressTime = mLastRepeatPressTime;
+  proxy.mLastHeartBeatTime = mLastHeartBeatTime;
+#if ACE_BUTTON_ENABLE_EDGE_LATENCY
+  proxy.mEdgeTime = mEdgeTime;
+#endif
+}
+
+void ButtonCore::moveFrom(ButtonCore& other) {
+  other.copyStateTo(*this);
+#if ACE_BUTTON_ENABLE_EDGE_LATENCY
+  mIsrEdgeTime.store(other.mIsrEdgeTime.load(std::memory_order_relaxed),
+      std::memory_order_relaxed);
+  mIsrEdgePending.store(other.mIsrEdgePending.exchange(false,
+      std::memory_order_acquire), std::memory_order_release);
+#endif
+}
+
+#if ACE_BUTTON_ENABLE_EDGE_LATENCY
+int64_t ButtonCore::consumeEdgeTime(const CheckContext& config,
+    int64_t now) {
+  if (! mIsrEdgePending.load(std::memory_order_acquire)) return now;
+  mIsrEdgePending.store(false, std::memory_order_relaxed);
+
+  // Extend the lower 32 bits given to markEdge() using 'now'. An edge older
+  // than the debouncing delay belongs to a glitch which was never seen by
+  // check(), not to this state change.
+  uint32_t age = (uint32_t) now - mIsrEdgeTime.load(std::memory_order_relaxed);
+  if ((int64_t) age > config.debounceDelay) return now;
+  return now - age;
+}
+#endif
+
+}
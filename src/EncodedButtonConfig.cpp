@@ -28,41 +28,105 @@ SOFTWARE.
 namespace ace_button {
 
 EncodedButtonConfig::EncodedButtonConfig(
-      uint8_t numPins, const uint8_t pins[], uint8_t numButtons,
+      uint8_t numPins, const uint8_t pins[], ButtonCountType numButtons,
       AceButton* const buttons[], uint8_t defaultReleasedState):
     mNumPins(numPins),
-    mNumButtons(numButtons),
     mPressedState(defaultReleasedState ^ 0x1),
+    mNumButtons(numButtons),
     mPins(pins),
-    mButtons(buttons) {
-  for (uint8_t i = 0; i < mNumButtons; i++) {
+    mButtons(buttons),
+    mButtonArray(nullptr) {
+  for (ButtonCountType i = 0; i < mNumButtons; i++) {
     AceButton* button = mButtons[i];
     button->setButtonConfig(this);
   }
 }
 
-int EncodedButtonConfig::readButton(uint8_t pin) {
-  uint8_t virtualPin = getVirtualPin();
+EncodedButtonConfig::EncodedButtonConfig(
+      uint8_t numPins, const uint8_t pins[], ButtonCountType numButtons,
+      AceButton buttons[], uint8_t defaultReleasedState):
+    mNumPins(numPins),
+    mPressedState(defaultReleasedState ^ 0x1),
+    mNumButtons(0),
+    mPins(pins),
+    mButtons(nullptr),
+    mButtonArray(nullptr) {
+  setButtons(numButtons, buttons);
+}
+
+void EncodedButtonConfig::setButtons(ButtonCountType numButtons,
+    AceButton buttons[]) {
+  for (ButtonCountType i = 0; i < numButtons; i++) {
+    buttons[i].setButtonConfig(this);
+  }
+  mButtons = nullptr;
+  mButtonArray = buttons;
+  mNumButtons = numButtons;
+}
+
+int EncodedButtonConfig::readButton(ButtonPinType pin) {
+  ButtonPinType virtualPin = getVirtualPin();
   return (virtualPin == pin) ? mPressedState : (mPressedState ^ 0x1);
 }
 
 void EncodedButtonConfig::checkButtons() const {
-  uint8_t virtualPin = getVirtualPin();
-  for (uint8_t i = 0; i < mNumButtons; i++) {
-    AceButton* button = mButtons[i];
+#if ACE_BUTTON_ENABLE_CHECK_TIMING
+  uint32_t startCycles = readCycleCounter();
+#endif
+  ButtonPinType virtualPin = getVirtualPin();
+  for (ButtonCountType i = 0; i < mNumButtons; i++) {
+    // The contiguous array avoids loading a pointer for each button.
+    AceButton* button = mButtonArray ? &mButtonArray[i] : mButtons[i];
     if (button == nullptr) continue;
 
     // For each button, call checkState() to allow it to figure out which
     // state it should move it.
-    uint8_t buttonPin = button->getPin();
+    ButtonPinType buttonPin = button->getPin();
     uint8_t buttonState = (buttonPin == virtualPin)
         ? mPressedState : (mPressedState ^ 0x1);
     button->checkState(buttonState);
   }
+
+#if ACE_BUTTON_ENABLE_CHECK_TIMING
+  getCheckButtonsTimes().record(readCycleCounter() - startCycles);
+#endif
+}
+
+ButtonCountType EncodedButtonConfig::primeButtons(uint8_t numSamples) {
+  ButtonPinType virtualPin = sampleVirtualPin(numSamples);
+  ButtonCountType numPressed = 0;
+  for (ButtonCountType i = 0; i < mNumButtons; i++) {
+    AceButton* button = mButtonArray ? &mButtonArray[i] : mButtons[i];
+    if (button == nullptr) continue;
+
+    bool isPressed = (button->getPin() == virtualPin);
+    button->primeState(isPressed ? mPressedState : (mPressedState ^ 0x1));
+    if (isPressed) numPressed++;
+  }
+  return numPressed;
+}
+
+void EncodedButtonConfig::saveButtons(ButtonCore::SavedState states[]) const {
+  for (ButtonCountType i = 0; i < mNumButtons; i++) {
+    AceButton* button = mButtonArray ? &mButtonArray[i] : mButtons[i];
+    if (button == nullptr) continue;
+    button->saveState(states[i]);
+  }
+}
+
+ButtonCountType EncodedButtonConfig::restoreButtons(
+    const ButtonCore::SavedState states[], int64_t elapsedMillis) {
+  ButtonCountType numRestored = 0;
+  for (ButtonCountType i = 0; i < mNumButtons; i++) {
+    AceButton* button = mButtonArray ? &mButtonArray[i] : mButtons[i];
+    if (button == nullptr) continue;
+    if (button->restoreState(states[i], elapsedMillis)) numRestored++;
+  }
+  return numRestored;
 }
 
-uint8_t EncodedButtonConfig::getVirtualPin() const {
-  uint8_t virtualPin = 0;
+ButtonPinType EncodedButtonConfig::getVirtualPin() const {
+  ButtonPinType virtualPin = 0;
   for (uint8_t i = 0; i < mNumPins; i++) {
     uint8_t pin = mPins[i];
     int s = gpio_get_level((gpio_num_t)pin);
@@ -71,4 +135,24 @@ uint8_t EncodedButtonConfig::getVirtualPin() const {
   return virtualPin;
 }
 
+ButtonPinType EncodedButtonConfig::sampleVirtualPin(uint8_t numSamples) const {
+  if (numSamples == 0) numSamples = 1;
+  if (numSamples > kMaxPrimeSamples) numSamples = kMaxPrimeSamples;
+
+  ButtonPinType samples[kMaxPrimeSamples];
+  for (uint8_t i = 0; i < numSamples; i++) {
+    samples[i] = getVirtualPin();
+  }
+
+  // A handful of samples, so count the votes of each one.
+  for (uint8_t i = 0; i < numSamples; i++) {
+    uint8_t votes = 0;
+    for (uint8_t j = 0; j < numSamples; j++) {
+      if (samples[j] == samples[i]) votes++;
+    }
+    if (votes > numSamples - votes) return samples[i];
+  }
+  return getNoButtonPin();
+}
+
 }
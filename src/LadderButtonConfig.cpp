@@ -29,20 +29,21 @@ namespace ace_button {
 
 LadderButtonConfig::LadderButtonConfig(
     uint8_t pin,
-    uint8_t numLevels,
+    ButtonCountType numLevels,
     const uint16_t levels[],
-    uint8_t numButtons,
+    ButtonCountType numButtons,
     AceButton* const buttons[],
     uint8_t defaultReleasedState
 ):
     mPin(pin),
+    mPressedState(defaultReleasedState ^ 0x1),
     mNumLevels(numLevels),
     mNumButtons(numButtons),
-    mPressedState(defaultReleasedState ^ 0x1),
     mLevels(levels),
-    mButtons(buttons)
+    mButtons(buttons),
+    mButtonArray(nullptr)
 {
-  for (uint8_t i = 0; i < mNumButtons; i++) {
+  for (ButtonCountType i = 0; i < mNumButtons; i++) {
     AceButton* button = mButtons[i];
     button->setButtonConfig(this);
   }
@@ -50,36 +51,126 @@ LadderButtonConfig::LadderButtonConfig(
   // TODO: Verify that the levels[] are monotonically increasing.
 }
 
-int LadderButtonConfig::readButton(uint8_t pin) {
-  uint8_t virtualPin = getVirtualPin();
+LadderButtonConfig::LadderButtonConfig(
+    uint8_t pin,
+    ButtonCountType numLevels,
+    const uint16_t levels[],
+    ButtonCountType numButtons,
+    AceButton buttons[],
+    uint8_t defaultReleasedState
+):
+    mPin(pin),
+    mPressedState(defaultReleasedState ^ 0x1),
+    mNumLevels(numLevels),
+    mNumButtons(0),
+    mLevels(levels),
+    mButtons(nullptr),
+    mButtonArray(nullptr)
+{
+  setButtons(numButtons, buttons);
+}
+
+void LadderButtonConfig::setButtons(ButtonCountType numButtons,
+    AceButton buttons[]) {
+  for (ButtonCountType i = 0; i < numButtons; i++) {
+    buttons[i].setButtonConfig(this);
+  }
+  mButtons = nullptr;
+  mButtonArray = buttons;
+  mNumButtons = numButtons;
+}
+
+int LadderButtonConfig::readButton(ButtonPinType pin) {
+  ButtonPinType virtualPin = getVirtualPin();
   return (virtualPin == pin) ? mPressedState : (mPressedState ^ 0x1);
 }
 
 void LadderButtonConfig::checkButtons() const {
-  uint8_t virtualPin = getVirtualPin();
-
-  for (uint8_t i = 0; i < mNumButtons; i++) {
-    AceButton* button = mButtons[i];
+#if ACE_BUTTON_ENABLE_CHECK_TIMING
+  uint32_t startCycles = readCycleCounter();
+#endif
+  ButtonPinType virtualPin = getVirtualPin();
+
+  for (ButtonCountType i = 0; i < mNumButtons; i++) {
+    // The contiguous array avoids loading a pointer for each button.
+    AceButton* button = mButtonArray ? &mButtonArray[i] : mButtons[i];
     if (button == nullptr) continue;
 
     // For each button, call checkState() to allow it to figure out which
     // state it should move to.
-    uint8_t buttonPin = button->getPin();
+    ButtonPinType buttonPin = button->getPin();
     uint8_t buttonState = (buttonPin == virtualPin)
         ? mPressedState : (mPressedState ^ 0x1);
     button->checkState(buttonState);
   }
+
+#if ACE_BUTTON_ENABLE_CHECK_TIMING
+  getCheckButtonsTimes().record(readCycleCounter() - startCycles);
+#endif
 }
 
-uint8_t LadderButtonConfig::getVirtualPin() const {
+ButtonCountType LadderButtonConfig::primeButtons(uint8_t numSamples) {
+  ButtonPinType virtualPin = sampleVirtualPin(numSamples);
+  ButtonCountType numPressed = 0;
+  for (ButtonCountType i = 0; i < mNumButtons; i++) {
+    AceButton* button = mButtonArray ? &mButtonArray[i] : mButtons[i];
+    if (button == nullptr) continue;
+
+    bool isPressed = (button->getPin() == virtualPin);
+    button->primeState(isPressed ? mPressedState : (mPressedState ^ 0x1));
+    if (isPressed) numPressed++;
+  }
+  return numPressed;
+}
+
+void LadderButtonConfig::saveButtons(ButtonCore::SavedState states[]) const {
+  for (ButtonCountType i = 0; i < mNumButtons; i++) {
+    AceButton* button = mButtonArray ? &mButtonArray[i] : mButtons[i];
+    if (button == nullptr) continue;
+    button->saveState(states[i]);
+  }
+}
+
+ButtonCountType LadderButtonConfig::restoreButtons(
+    const ButtonCore::SavedState states[], int64_t elapsedMillis) {
+  ButtonCountType numRestored = 0;
+  for (ButtonCountType i = 0; i < mNumButtons; i++) {
+    AceButton* button = mButtonArray ? &mButtonArray[i] : mButtons[i];
+    if (button == nullptr) continue;
+    if (button->restoreState(states[i], elapsedMillis)) numRestored++;
+  }
+  return numRestored;
+}
+
+ButtonPinType LadderButtonConfig::getVirtualPin() const {
   uint16_t level = gpio_get_level((gpio_num_t)mPin);
   return extractIndex(mNumLevels, mLevels, level);
 }
 
-uint8_t LadderButtonConfig::extractIndex(uint8_t numLevels,
+ButtonPinType LadderButtonConfig::sampleVirtualPin(uint8_t numSamples) const {
+  if (numSamples == 0) numSamples = 1;
+  if (numSamples > kMaxPrimeSamples) numSamples = kMaxPrimeSamples;
+
+  ButtonPinType samples[kMaxPrimeSamples];
+  for (uint8_t i = 0; i < numSamples; i++) {
+    samples[i] = getVirtualPin();
+  }
+
+  // A handful of samples, so count the votes of each one.
+  for (uint8_t i = 0; i < numSamples; i++) {
+    uint8_t votes = 0;
+    for (uint8_t j = 0; j < numSamples; j++) {
+      if (samples[j] == samples[i]) votes++;
+    }
+    if (votes > numSamples - votes) return samples[i];
+  }
+  return getNoButtonPin();
+}
+
+ButtonPinType LadderButtonConfig::extractIndex(ButtonCountType numLevels,
     uint16_t const levels[], uint16_t level) {
 
-  uint8_t i;
+  ButtonCountType i;
   for (i = 0; i < numLevels - 1; i++) {
 
     // NOTE(brian): This will overflow a 16-bit ADC. If we need to support that,
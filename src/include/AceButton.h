@@ -25,8 +25,11 @@ SOFTWARE.
 #ifndef ACE_BUTTON_ACE_BUTTON_H
 #define ACE_BUTTON_ACE_BUTTON_H
 
+#include <utility> // std::move
 #include "IEventHandler.h"
+#include "IEventHandler2.h"
 #include "ButtonConfig.h"
+#include "ButtonCore.h"
 #include "Encoded8To3ButtonConfig.h"
 #include "Encoded4To2ButtonConfig.h"
 #include "EncodedButtonConfig.h"
@@ -35,8 +38,6 @@ SOFTWARE.
 // Version format: xxyyzz == "xx.yy.zz"
 #define ACE_BUTTON_VERSION 11001
 #define ACE_BUTTON_VERSION_STRING "1.10.1"
-#define HIGH 0x1
-#define LOW  0x0
 
 namespace ace_button {
 
@@ -58,81 +59,13 @@ namespace ace_button {
  * the debouncing time period. For 20 ms delay, the check() method should be
  * called at a minimum of every 5 ms. The execution time of check() on a 16
  * MHz Arduino ATmega328P MCU seems to about about 12-14 microseconds.
+ *
+ * The event types, the button state and the event detection logic are
+ * inherited from ButtonCore. The AceButton adds the pointer to its
+ * ButtonConfig.
  */
-class AceButton {
+class AceButton: public ButtonCore {
   public:
-    // The supported event types.
-
-    /** Button was pressed. */
-    static const uint8_t kEventPressed = 0;
-
-    /** Button was released. */
-    static const uint8_t kEventReleased = 1;
-
-    /**
-     * Button was clicked (Pressed and Released within
-     * ButtonConfig::getClickDelay()).
-     */
-    static const uint8_t kEventClicked = 2;
-
-    /**
-     * Button was double-clicked. (Two clicks within
-     * ButtonConfig::getDoubleClickDelay()).
-     */
-    static const uint8_t kEventDoubleClicked = 3;
-
-    /**
-     * Button was held down for longer than
-     * ButtonConfig::getLongPressDelay()).
-     */
-    static const uint8_t kEventLongPressed = 4;
-
-    /**
-     * Button was held down and auto generated multiple presses. The first event
-     * is triggered after ButtonConfig::getRepeatPressDelay(), then the event
-     * fires repeatedly every ButtonConfig::getRepeatPressInterval() until the
-     * button is released.
-     */
-    static const uint8_t kEventRepeatPressed = 5;
-
-    /**
-     * Button was released after a long press. This event becomes the
-     * replacement for kEventReleased if kFeatureSuppressAfterLongPress is
-     * enabled. The kFeatureSuppressAfterLongPress allows us to distinguish a
-     * simple Pressed from a LongPressed, by using the Released event as a
-     * replacement of Pressed. But the suppression prevents us from detecting a
-     * Released event from a LongPress (which is sometimes needed). This event
-     * can be used as a replacement.
-     */
-    static const uint8_t kEventLongReleased = 6;
-
-    /**
-     * An event that fires every time interval defined by
-     * `getHeartBeatInterval()`. This is intended to allow custom subclasses of
-     * `IEventHandler` to track the progression of time even when no other
-     * event is occurring with a button. For example, this allows the
-     * IEventHandler to store the timestamp of the last kEventReleased, then
-     * trigger a custom kCustomLongReleased event after (say) 30 seconds after
-     * the last kEventReleased. Without the heart beat event, the IEventHandler
-     * would not be able to fire off a custom event.
-     */
-    static const uint8_t kEventHeartBeat = 7;
-
-    /**
-     * Button state is unknown. This is a third state (different from LOW or
-     * HIGH) used when the class is first initialized upon reboot. No longer
-     * able to use '2' because the new PinStatus enum API contains 'CHANGE'
-     * which has a value of 2.
-     */
-    static const uint8_t kButtonStateUnknown = 127;
-
-    /**
-     * Return the human-readable name of the event. This is intended to
-     * help debugging. If this function is not used, the underlying table of
-     * strings will not be compiled into the resulting binary.
-     */
-    static const char* eventName(uint8_t event);
-
     /**
      * Constructor defines parameters of the button that changes from button to
      * button. These parameters don't change during the runtime of the program.
@@ -166,13 +99,12 @@ class AceButton {
      * associated with the button.
      */
     explicit AceButton(
-        uint8_t pin = 0,
+        ButtonPinType pin = 0,
         uint8_t defaultReleasedState = HIGH,
-        uint8_t id = 0
+        ButtonIdType id = 0
     ) :
-        mButtonConfig(ButtonConfig::getSystemButtonConfig()) {
-      init(pin, defaultReleasedState, id);
-    }
+        ButtonCore(pin, defaultReleasedState, id),
+        mButtonConfig(ButtonConfig::getSystemButtonConfig()) {}
 
     /**
      * Constructor that accepts a ButtonConfig as a dependency. The
@@ -197,12 +129,28 @@ class AceButton {
      * was not the best idea, but it is too late to change that behavior without
      * breaking backwards compatibility.
      */
-    explicit AceButton(
+    constexpr explicit AceButton(
         ButtonConfig* buttonConfig,
-        uint8_t pin = 0,
+        ButtonPinType pin = 0,
         uint8_t defaultReleasedState = HIGH,
-        uint8_t id = 0) {
-      init(buttonConfig, pin, defaultReleasedState, id);
+        ButtonIdType id = 0) :
+        ButtonCore(pin, defaultReleasedState, id),
+        mButtonConfig(buttonConfig) {}
+
+    /**
+     * Move constructor. The button keeps its ButtonConfig and its state. This
+     * allows buttons to be stored by value in containers such as ButtonArray,
+     * instead of as separate global variables.
+     */
+    AceButton(AceButton&& other) noexcept:
+        ButtonCore(std::move(other)),
+        mButtonConfig(other.mButtonConfig) {}
+
+    /** Move assignment operator, see AceButton(AceButton&&). */
+    AceButton& operator=(AceButton&& other) noexcept {
+      ButtonCore::operator=(std::move(other));
+      mButtonConfig = other.mButtonConfig;
+      return *this;
     }
 
     /**
@@ -211,21 +159,21 @@ class AceButton {
      * identical as the parameters in the AceButton() constructor.
      */
     void init(
-        uint8_t pin = 0,
+        ButtonPinType pin = 0,
         uint8_t defaultReleasedState = HIGH,
-        uint8_t id = 0);
+        ButtonIdType id = 0);
 
     /**
-     * Similar to init(uint8_t, uint8_t, uint8_t) but takes a (ButtonConfig*) as
-     * the first parameter. Sometimes it is more convenient to initialize the
-     * button in the global setup() function using this method instead of using
-     * the constructor.
+     * Similar to init(ButtonPinType, uint8_t, ButtonIdType) but takes a
+     * (ButtonConfig*) as the first parameter. Sometimes it is more convenient
+     * to initialize the button in the global setup() function using this
+     * method instead of using the constructor.
      */
     void init(
         ButtonConfig* buttonConfig,
-        uint8_t pin = 0,
+        ButtonPinType pin = 0,
         uint8_t defaultReleasedState = HIGH,
-        uint8_t id = 0);
+        ButtonIdType id = 0);
 
     /** Get the ButtonConfig associated with this Button. */
     ButtonConfig* getButtonConfig() const {
@@ -275,32 +223,6 @@ class AceButton {
       mButtonConfig->setEventHandler(eventHandler);
     }
 
-    /** Get the button's pin number. */
-    uint8_t getPin() const { return mPin; }
-
-    /** Get the custom identifier of the button. */
-    uint8_t getId() const { return mId; }
-
-    /** Get the initial released state of the button, HIGH or LOW. */
-    uint8_t getDefaultReleasedState() const;
-
-    /**
-     * Return the button state that was last valid. This is a tri-state
-     * function. It may return HIGH, LOW or kButtonStateUnknown to indicate that
-     * the last state is not known. This method is **not** for public
-     * consumption, it is exposed only for testing purposes. Consider it to be a
-     * private method. Use the buttonState parameter provided to the
-     * EventHandler.
-     *
-     * In a more general multi-threaded environment (which the Arduino is not,
-     * fortunately or unfortunately), the getLastButtonState() may have changed
-     * from the value of buttonState provided to the event handler. In other
-     * words, there is a race-condition.
-     */
-    uint8_t getLastButtonState() const {
-      return mLastButtonState;
-    }
-
     /**
      * Check state of button and trigger event processing. This method should be
      * called from the loop() method in Arduino every 4-5 times during the
@@ -314,25 +236,21 @@ class AceButton {
      * Version of check() used by EncodedButtonConfig. NOT for public
      * consumption.
      */
-    void checkState(int buttonState);
+    void checkState(int buttonState) {
+      ButtonCore::checkState(mButtonConfig, this, buttonState);
+    }
 
     /**
-     * Returns true if the given buttonState represents a 'Released' state for
-     * the button. Returns false if the buttonState is 'Pressed' or
-     * kButtonStateUnknown.
-     *
-     * The HIGH or LOW logical value of buttonState represents different a
-     * button position depending on whether the button is wired with a pull-up
-     * or a pull-down resistor. This method translates the logical level to the
-     * physical position which allows the client code to be independent of the
-     * physical wiring.
-     *
-     * Normally, the eventType given to the EventHandler should be sufficient
-     * because the value of the eventType already encodes this information.
-     * This method is provided just in case.
+     * Return the earliest clock time at which check() may change the state of
+     * the button or dispatch an event, assuming that the button input does not
+     * change in the meantime. A time in the past (possibly INT64_MIN) means
+     * that the next check() must not be delayed. Returns kNoDeadline if the
+     * button waits only for an input change. A loop may sleep until the
+     * deadline or the next input interrupt, and a simulator may jump its clock
+     * to it, without changing the events seen by polling.
      */
-    bool isReleased(int buttonState) const {
-      return buttonState == getDefaultReleasedState();
+    int64_t getNextDeadline() const {
+      return ButtonCore::getNextDeadline(mButtonConfig);
     }
 
     /**
@@ -343,206 +261,52 @@ class AceButton {
      * any debouncing, and does not dispatch events to the EventHandler.
      */
     bool isPressedRaw() const {
-      return !isReleased(mButtonConfig->readButton(mPin));
+      return !isReleased(mButtonConfig->readButton(getPin()));
     }
 
-  // Some of these private methods may be useful to the calling client but I
-  // don't want to release them to the public because I want to keep the API as
-  // small as possible for easier long term maintenance. (Once a method is
-  // released to the public, it must be supported forever to ensure backwards
-  // compatibility with older client code.)
-
-  private:
-    // Disable copy-constructor and assignment operator
-    AceButton(const AceButton&) = delete;
-    AceButton& operator=(const AceButton&) = delete;
-
-    /** Set the pin number of the button. */
-    void setPin(uint8_t pin) { mPin = pin; }
-
     /**
-     * Set the initial released state of the button.
-     *
-     * @param state If a pull up resistor is used, this should be HIGH. If a
-     * pull down resistor is used, this should be LOW. The behavior is undefined
-     * for any other values of 'state'.
+     * Read the button numSamples times and seed its debounced state with the
+     * majority of the samples, see ButtonCore::primeState(). Intended to be
+     * called in setup() right after boot or wake, so that a button held by the
+     * user (e.g. to enter a recovery mode) is known within the first
+     * millisecond, and the check() loop starts from a known state without the
+     * initial debouncing period. Several samples reject a glitch on a noisy
+     * input. Returns true if the button is pressed.
      */
-    void setDefaultReleasedState(uint8_t state);
-
-    /** Set the identifier of the button. */
-    void setId(uint8_t id) { mId = id; }
-
-    // Various bit masks to store a boolean flag in the 'mFlags' field.
-    // We use bit masks to save static RAM. If we had used a 'bool' type, each
-    // of these would consume one byte.
-    typedef uint16_t FlagType;
-    static const FlagType kFlagDefaultReleasedState = 0x01;
-    static const FlagType kFlagDebouncing = 0x02;
-    static const FlagType kFlagPressed = 0x04; // mLastPressTime is valid
-    static const FlagType kFlagClicked = 0x08; // mLastClickTime valid
-    static const FlagType kFlagDoubleClicked = 0x10;
-    static const FlagType kFlagLongPressed = 0x20;
-    static const FlagType kFlagRepeatPressed = 0x40; // mLastRepeatPressTime
-    static const FlagType kFlagClickPostponed = 0x80;
-    static const FlagType kFlagHeartRunning = 0x100; // mLastHeartBeatTime valid
-
-    bool isFlag(FlagType flag) const {
-      return mFlags & flag;
+    bool prime(uint8_t numSamples = 1) {
+      primeState(sampleState(mButtonConfig, numSamples));
+      return isPressed();
     }
 
-    void setFlag(FlagType flag) {
-      mFlags |= flag;
-    }
-
-    void clearFlag(FlagType flag) {
-      mFlags &= ~flag;
-    }
-
-    /**
-     * Return true if debouncing succeeded and the buttonState value can be
-     * used. Return false if buttonState should be ignored until debouncing
-     * phase is complete.
-     */
-    bool checkDebounced(int64_t now, int buttonState);
-
     /**
-     * Return true if the button was already initialzed and determined to be in
-     * a HIGH or LOW state. Return false if the button was previously in
-     * kButtonStateUnknown state which implies that the event handler should
-     * NOT be fired.
+     * Save the in-flight state of the button (e.g. a press in progress)
+     * before a deep sleep, into memory which survives it. See
+     * ButtonCore::SavedState.
      */
-    bool checkInitialized(uint16_t buttonState);
-
-    /** Categorize the button event. */
-    void checkEvent(int64_t now, int buttonState);
-
-    /** Check for a long press event and dispatch to event handler. */
-    void checkLongPress(int64_t now, int buttonState);
-
-    /** Check for a repeat press event and dispatch to event handler. */
-    void checkRepeatPress(int64_t now, int buttonState);
-
-    /** Check for onChange event and check for Press or Release events. */
-    void checkChanged(int64_t now, int buttonState);
-
-    /**
-     * Check for Released and Click events and dispatch to respective
-     * handlers.
-     */
-    void checkReleased(int64_t now, int buttonState);
-
-    /** Check for Pressed event and dispatch to handler. */
-    void checkPressed(int64_t now, int buttonState);
-
-    /** Check for a single click event and dispatch to handler. */
-    void checkClicked(int64_t now);
-
-    /**
-     * Check for a double click event and dispatch to handler. Return true if
-     * double click detected.
-     */
-    void checkDoubleClicked(int64_t now);
-
-    /**
-     * Check for an orphaned click that did not generate a double click and
-     * clean up internal state. If we don't do this, the second click may be
-     * generated after the uint16_t rolls over in 65.5 seconds, causing an
-     * unwanted double-click. Even if we used the full 'unsigned long' to store
-     * the 'lastClickTime', we'd still need this function to prevent a rollover
-     * of the 32-bit number in 49.7 days.
-     */
-    void checkOrphanedClick(int64_t now);
+    void saveState(SavedState& state) const {
+      ButtonCore::saveState(mButtonConfig, state);
+    }
 
     /**
-     * Check if a click message has been postponed because of
-     * ButtonConfig::kFeatureSuppressClickBeforeDoubleClick.
+     * Restore the state saved by saveState() after the wake. The elapsedMillis
+     * is the time since saveState(), measured by a clock which keeps running
+     * during the sleep (e.g. gettimeofday() on the ESP32), since getClock() is
+     * reset by the wake. A long press which started before the sleep is then
+     * recognized at the right time, and the check() loop starts without the
+     * initial debouncing period. Returns false, and leaves the button in its
+     * initial state, if the saved state is not valid (e.g. after a cold boot).
      */
-    void checkPostponedClick(int64_t now);
-
-    /** Check if a heart beat should be sent. */
-    void checkHeartBeat(int64_t now);
-
-    /**
-     * Dispatch to the event handler defined in the mButtonConfig.
-     *
-     * This method will always be called and it's up to the user-provided
-     * handler to ignore the events which aren't interesting.
-     *
-     * An alternative might be to provide a bitmask filter to select only
-     * events which should are registered to trigger the event handler. For
-     * example, add the following method:
-     *
-     * @code
-     *    setEventSelection(uint8_t eventSelection) {
-     *      mEventSelection = eventSelection;
-     *    }
-     * @endcode
-     *
-     * Set the event selector at setup():
-     *
-     * @code
-     *    setEventSelection(kEventSelectPressed | kEventSelectReleased);
-     * @endcode
-     *
-     * where
-     *
-     * @code
-     *  kEventSelectPressed = (0x1 << kEventPressed);
-     *  kEventSelectReleased = (0x1 << kEventReleased);
-     *  ...
-     * @endcode
-     *
-     * Then change the handleEvent() method to something like:
-     *
-     * @code
-     * void handleEvent(uint8_t eventType) {
-     *    if (mEventHandler && (eventSelections & (0x1 << eventType))) {
-     *      handleEvent(this, eventType);
-     *    }
-     * }
-     * @endcode
-     *
-     * But it is possible that the evaluation of the if-condition above takes
-     * longer to evaluate than an empty function call, so we should do some
-     * profiling before making this change.
-     *
-     * Note: This probably should have been a const function. But that would
-     * require the ButtonConfig::EventHandler callback function to accept a
-     * `const AceButton*` instead of a `AceButton*`. Unfortunately, that
-     * signature is part of the API, and I cannot change it without
-     * breaking backwards compatibility.
-     *
-     * @param eventType the type of event given by the kEvent* constants
-     */
-    void handleEvent(uint8_t eventType);
+    bool restoreState(const SavedState& state, int64_t elapsedMillis = 0) {
+      return ButtonCore::restoreState(mButtonConfig, state, elapsedMillis);
+    }
 
   private:
+    // Disable copy-constructor and assignment operator
+    AceButton(const AceButton&) = delete;
+    AceButton& operator=(const AceButton&) = delete;
+
     /** ButtonConfig associated with this button. */
     ButtonConfig* mButtonConfig;
-
-    /** button pin number */
-    uint8_t mPin;
-
-    /** identifier, e.g. an index into an array */
-    uint8_t mId;
-
-    /** Internal flags. Bit masks are defined by the kFlag* constants. */
-    FlagType mFlags;
-
-    /**
-     * Last button state. This is a tri-state variable: LOW, HIGH or
-     * kButtonStateUnknown.
-     */
-    uint8_t mLastButtonState;
-
-    // Internal states of the button debouncing and event handling.
-    // NOTE: We don't keep track of the lastDoubleClickTime, because we
-    // don't support a TripleClicked event. That may change in the future.
-    int64_t mLastDebounceTime; // ms
-    int64_t mLastClickTime; // ms
-    int64_t mLastPressTime; // ms
-    int64_t mLastRepeatPressTime; // ms
-    int64_t mLastHeartBeatTime; // ms
 };
 
 }
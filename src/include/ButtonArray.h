@@ -0,0 +1,209 @@
+/*
+MIT License
+
+Copyright (c) 2026 Brian T. Park
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#ifndef ACE_BUTTON_BUTTON_ARRAY_H
+#define ACE_BUTTON_BUTTON_ARRAY_H
+
+#include <stdint.h>
+#include <new> // placement new, std::launder
+#include <type_traits>
+#include <utility> // std::move
+#include "AceButton.h"
+
+namespace ace_button {
+
+/**
+ * A fixed-capacity container which stores AceButton instances contiguously,
+ * by value. The buttons can be added at runtime, for example from a board
+ * description read from flash or NVS, instead of being declared as separate
+ * global variables. An EncodedButtonConfig or a LadderButtonConfig can scan
+ * the buttons without an array of pointers, see attach().
+ *
+ * @code
+ * ButtonArray<16> buttons;
+ * ButtonConfig config;
+ *
+ * void setup() {
+ *   for (const BoardButton& b : boardButtons) {
+ *     buttons.add(&config, b.pin, HIGH, b.id);
+ *   }
+ * }
+ *
+ * void loop() {
+ *   buttons.check();
+ * }
+ * @endcode
+ *
+ * The buttons are relocated by their move constructor when one is removed, so
+ * a pointer to a button is valid only until the next remove(). Use getId() to
+ * identify the buttons in the event handler. The array must not be modified
+ * while the attached config is inside checkButtons().
+ *
+ * @tparam T_CAPACITY maximum number of buttons
+ */
+template <uint16_t T_CAPACITY>
+class ButtonArray {
+  static_assert(std::is_nothrow_move_constructible<AceButton>::value,
+      "AceButton must be relocatable");
+
+  public:
+    ButtonArray(): mSize(0), mConfig(nullptr), mSetButtons(nullptr) {}
+
+    // Does not resync the attached config, which may already be destroyed.
+    ~ButtonArray() { destroyAll(); }
+
+    /** Return the maximum number of buttons. */
+    static constexpr uint16_t capacity() { return T_CAPACITY; }
+
+    /** Return the number of buttons. */
+    uint16_t size() const { return mSize; }
+
+    /**
+     * Add a button constructed with the given parameters, see
+     * AceButton(ButtonConfig*, ButtonPinType, uint8_t, ButtonIdType). Return
+     * nullptr if the array is full.
+     */
+    AceButton* add(ButtonConfig* buttonConfig, ButtonPinType pin = 0,
+        uint8_t defaultReleasedState = HIGH, ButtonIdType id = 0) {
+      if (mSize >= T_CAPACITY) return nullptr;
+      AceButton* button = new (slot(mSize)) AceButton(
+          buttonConfig, pin, defaultReleasedState, id);
+      mSize++;
+      syncConfig();
+      return button;
+    }
+
+    /** Move the given button into the array. Return nullptr if full. */
+    AceButton* add(AceButton&& button) {
+      if (mSize >= T_CAPACITY) return nullptr;
+      AceButton* added = new (slot(mSize)) AceButton(std::move(button));
+      mSize++;
+      syncConfig();
+      return added;
+    }
+
+    /**
+     * Remove the button at index i, by moving the last button into its place.
+     * The order of the buttons is not preserved. Return false, and change
+     * nothing, if i is not less than size().
+     */
+    bool remove(uint16_t i) {
+      if (i >= mSize) return false;
+      uint16_t last = mSize - 1;
+      if (i != last) data()[i] = std::move(data()[last]);
+      data()[last].~AceButton();
+      mSize = last;
+      syncConfig();
+      return true;
+    }
+
+    /** Remove all buttons. */
+    void clear() {
+      destroyAll();
+      syncConfig();
+    }
+
+    /**
+     * Make the given EncodedButtonConfig or LadderButtonConfig scan the
+     * buttons of this array, and point each button to it. Its setButtons() is
+     * called again after every add(), remove() and clear(), so that the config
+     * never scans a destroyed slot or misses a new button. Calling setButtons()
+     * directly with data() instead is valid only until the next change.
+     *
+     * @tparam C EncodedButtonConfig, LadderButtonConfig or a subclass
+     */
+    template <typename C>
+    void attach(C* config) {
+      static_assert(T_CAPACITY <= (ButtonCountType) -1,
+          "T_CAPACITY does not fit in ButtonCountType");
+      mConfig = config;
+      mSetButtons = &setButtonsStub<C>;
+      syncConfig();
+    }
+
+    /** Stop updating the config given to attach(). */
+    void detach() {
+      mConfig = nullptr;
+      mSetButtons = nullptr;
+    }
+
+    /** Return the contiguous array of buttons. */
+    AceButton* data() {
+      return std::launder(reinterpret_cast<AceButton*>(mStorage));
+    }
+
+    /** Return the contiguous array of buttons. */
+    const AceButton* data() const {
+      return std::launder(reinterpret_cast<const AceButton*>(mStorage));
+    }
+
+    AceButton& operator[](uint16_t i) { return data()[i]; }
+    const AceButton& operator[](uint16_t i) const { return data()[i]; }
+
+    AceButton* begin() { return data(); }
+    AceButton* end() { return data() + mSize; }
+    const AceButton* begin() const { return data(); }
+    const AceButton* end() const { return data() + mSize; }
+
+    /** Call AceButton::check() on each button. */
+    void check() {
+      for (AceButton& button : *this) button.check();
+    }
+
+  private:
+    // Disable copy-constructor and assignment operator
+    ButtonArray(const ButtonArray&) = delete;
+    ButtonArray& operator=(const ButtonArray&) = delete;
+
+    typedef void (*SetButtons)(void* config, ButtonCountType numButtons,
+        AceButton buttons[]);
+
+    template <typename C>
+    static void setButtonsStub(void* config, ButtonCountType numButtons,
+        AceButton buttons[]) {
+      static_cast<C*>(config)->setButtons(numButtons, buttons);
+    }
+
+    void* slot(uint16_t i) { return mStorage + i * sizeof(AceButton); }
+
+    void syncConfig() {
+      if (mSetButtons) mSetButtons(mConfig, (ButtonCountType) mSize, data());
+    }
+
+    void destroyAll() {
+      while (mSize > 0) {
+        mSize--;
+        data()[mSize].~AceButton();
+      }
+    }
+
+    alignas(AceButton) uint8_t mStorage[T_CAPACITY * sizeof(AceButton)];
+    uint16_t mSize;
+    void* mConfig;
+    SetButtons mSetButtons;
+};
+
+}
+
+#endif
@@ -25,9 +25,18 @@ SOFTWARE.
 #ifndef ACE_BUTTON_BUTTON_CONFIG_H
 #define ACE_BUTTON_BUTTON_CONFIG_H
 
+#include <string.h> // memcpy()
+#include <atomic>
 #include "esp_timer.h"
 #include "driver/gpio.h"
 #include "IEventHandler.h"
+#include "IEventHandler2.h"
+#include "EventDelegate.h"
+#include "ButtonStats.h"
+#include "CycleCounter.h"
+#include "LatencyHistogram.h"
+#include "ScanMonitor.h"
+#include "ButtonIndex.h"
 
 // https://stackoverflow.com/questions/295120
 #if defined(__GNUC__) || defined(__clang__)
@@ -68,17 +77,12 @@ class ButtonConfig {
   public:
     // Various timing constants, in milliseconds.
     //
-    // Note that the timing constants are stored as uint16_t (2
-    // bytes) instead of unsigned long (4 bytes) which is the type returned by
-    // the esp_timer_get_time() system method. It turns out that we can store and perform
-    // all timing calculations using uint16_t without ill effect, as long as the
-    // polling of AceButton::check() happens more frequently than the rollover
-    // time of a uint16_t (i.e. 65.536 seconds) and certain precautions (e.g.
-    // AceButton::checkOrphanedClick()) are taken before a uint16_t rollover
-    // happens. In theory, these additional precautions would be needed even if
-    // an 'unsigned long' is used but almost no one does them because they
-    // assume that their code won't be running continuously for the rollover
-    // time of an 'unsigned long' (i.e. 49.7 days).
+    // Note that the timing parameters are stored as uint16_t (2 bytes) in a
+    // TimingProfile, and widened to int64_t (the type of getClock()) only in
+    // the Snapshot used by the calculations. No delay needs to be longer than
+    // the 65.535 seconds of a uint16_t, and the narrow storage makes the two
+    // copies of the double-buffered configuration smaller than the single
+    // copy of the int64_t delays of earlier versions (on 32-bit processors).
 
     /** Default milliseconds returned by getDebounceDelay(). */
     static const int64_t kDebounceDelay = 20;
@@ -101,6 +105,9 @@ class ButtonConfig {
     /** Default milliseconds returned by getHeartBeatInterval(). */
     static const int64_t kHeartBeatInterval = 5000;
 
+    /** Largest delay that can be stored, in milliseconds. */
+    static const int64_t kMaxDelay = UINT16_MAX;
+
     // Various features controlled by feature flags.
 
     /**
@@ -154,11 +161,20 @@ class ButtonConfig {
     static const FeatureFlagType kFeatureHeartBeat = 0x200;
 
     /**
-     * Internal flag to indicate that mEventHandler is an IEventHandler object
-     * pointer instead of an EventHandler function pointer.
+     * Internal flag to indicate that the event handler was installed using
+     * setIEventHandler(). Since the handler is stored as an EventDelegate,
+     * this flag is no longer consulted by dispatchEvent(). It is retained so
+     * that isFeature() continues to report the type of handler.
      */
     static const FeatureFlagType kInternalFeatureIEventHandler = 0x8000;
 
+    /**
+     * Internal flag to indicate that the event handler was installed using
+     * setIEventHandler2(). Informational only, like
+     * kInternalFeatureIEventHandler.
+     */
+    static const FeatureFlagType kInternalFeatureIEventHandler2 = 0x4000;
+
     /**
      * Convenience flag to suppress all suppressions. Calling
      * setFeature(kFeatureSuppressAll) suppresses all and
@@ -183,6 +199,53 @@ class ButtonConfig {
     typedef void (*EventHandler)(AceButton* button, uint8_t eventType,
         uint8_t buttonState);
 
+    /**
+     * The timing parameters of a ButtonConfig, in milliseconds. A single
+     * TimingProfile can be shared by several ButtonConfig instances using
+     * setTimingProfile(), for example to apply the same "slow" or "fast"
+     * timing to many panels. A shared TimingProfile is read without locking,
+     * so it must not be modified while it is in use: declare it const, and
+     * switch to another profile to change the timing.
+     *
+     * @code
+     * const ButtonConfig::TimingProfile kSlowProfile = {
+     *   50, 300, 600, 2000, 2000, 300, 10000
+     * };
+     * @endcode
+     */
+    struct TimingProfile {
+      uint16_t debounceDelay = kDebounceDelay;
+      uint16_t clickDelay = kClickDelay;
+      uint16_t doubleClickDelay = kDoubleClickDelay;
+      uint16_t longPressDelay = kLongPressDelay;
+      uint16_t repeatPressDelay = kRepeatPressDelay;
+      uint16_t repeatPressInterval = kRepeatPressInterval;
+      uint16_t heartBeatInterval = kHeartBeatInterval;
+    };
+
+    /**
+     * A consistent copy of the timing parameters, feature flags and event
+     * handler of the ButtonConfig. AceButton::checkState() reads a single
+     * Snapshot and uses it for all of its decisions, so that a setter called
+     * from another task never takes effect in the middle of a check.
+     */
+    struct Snapshot {
+      /** Check if the given features are enabled. */
+      bool isFeature(FeatureFlagType features) const {
+        return featureFlags & features;
+      }
+
+      EventDelegate eventDelegate;
+      FeatureFlagType featureFlags = 0;
+      int64_t debounceDelay = kDebounceDelay;
+      int64_t clickDelay = kClickDelay;
+      int64_t doubleClickDelay = kDoubleClickDelay;
+      int64_t longPressDelay = kLongPressDelay;
+      int64_t repeatPressDelay = kRepeatPressDelay;
+      int64_t repeatPressInterval = kRepeatPressInterval;
+      int64_t heartBeatInterval = kHeartBeatInterval;
+    };
+
     /** Constructor. */
     ButtonConfig() = default;
 
@@ -220,22 +283,22 @@ class ButtonConfig {
     #endif
 
     /** milliseconds to wait for debouncing. */
-    int64_t getDebounceDelay() const { return mDebounceDelay; }
+    int64_t getDebounceDelay() const { return getSnapshot().debounceDelay; }
 
     /** milliseconds to wait for a possible click. */
-    int64_t getClickDelay() const { return mClickDelay; }
+    int64_t getClickDelay() const { return getSnapshot().clickDelay; }
 
     /**
      * milliseconds between the first and second click to register as a
      * double-click.
      */
     int64_t getDoubleClickDelay() const {
-      return mDoubleClickDelay;
+      return getSnapshot().doubleClickDelay;
     }
 
     /** milliseconds for a long press event. */
     int64_t getLongPressDelay() const {
-      return mLongPressDelay;
+      return getSnapshot().longPressDelay;
     }
 
     /**
@@ -245,52 +308,78 @@ class ButtonConfig {
      * getRepeatPressInterval() time.
      */
     int64_t getRepeatPressDelay() const {
-      return mRepeatPressDelay;
+      return getSnapshot().repeatPressDelay;
     }
 
     /** milliseconds between two successive RepeatPressed events. */
     int64_t getRepeatPressInterval() const {
-      return mRepeatPressInterval;
+      return getSnapshot().repeatPressInterval;
     }
 
     /** milliseconds between two successive HeartBeat events. */
     int64_t getHeartBeatInterval() const {
-      return mHeartBeatInterval;
+      return getSnapshot().heartBeatInterval;
     }
 
+    // The setters below store the delay in the TimingProfile of this
+    // ButtonConfig, clamped to [0, kMaxDelay]. If a shared TimingProfile was
+    // set by setTimingProfile(), its values are copied first (copy on write),
+    // and the shared profile is no longer used.
+
     /** Set the debounceDelay milliseconds */
     void setDebounceDelay(int64_t debounceDelay) {
-      mDebounceDelay = debounceDelay;
+      StoredSnapshot stored = readStored();
+      detachTimingProfile(stored);
+      stored.timing.debounceDelay = toDelay(debounceDelay);
+      publishStored(stored);
     }
 
     /** Set the clickDelay milliseconds */
     void setClickDelay(int64_t clickDelay) {
-      mClickDelay = clickDelay;
+      StoredSnapshot stored = readStored();
+      detachTimingProfile(stored);
+      stored.timing.clickDelay = toDelay(clickDelay);
+      publishStored(stored);
     }
 
     /** Set the doubleClickDelay milliseconds */
     void setDoubleClickDelay(int64_t doubleClickDelay) {
-      mDoubleClickDelay = doubleClickDelay;
+      StoredSnapshot stored = readStored();
+      detachTimingProfile(stored);
+      stored.timing.doubleClickDelay = toDelay(doubleClickDelay);
+      publishStored(stored);
     }
 
     /** Set the longPressDelay milliseconds */
     void setLongPressDelay(int64_t longPressDelay) {
-      mLongPressDelay = longPressDelay;
+      StoredSnapshot stored = readStored();
+      detachTimingProfile(stored);
+      stored.timing.longPressDelay = toDelay(longPressDelay);
+      publishStored(stored);
     }
 
     /** Set the repeatPressDelay milliseconds */
     void setRepeatPressDelay(int64_t repeatPressDelay) {
-      mRepeatPressDelay = repeatPressDelay;
+      StoredSnapshot stored = readStored();
+      detachTimingProfile(stored);
+      stored.timing.repeatPressDelay = toDelay(repeatPressDelay);
+      publishStored(stored);
     }
 
     /** Set the repeatPressInterval milliseconds */
     void setRepeatPressInterval(int64_t repeatPressInterval) {
-      mRepeatPressInterval = repeatPressInterval;
+      StoredSnapshot stored = readStored();
+      detachTimingProfile(stored);
+      stored.timing.repeatPressInterval = toDelay(repeatPressInterval);
+      publishStored(stored);
     }
 
     /** Set the heartBeatInterval milliseconds */
     void setHeartBeatInterval(int64_t heartBeatInterval) {
-      mHeartBeatInterval = heartBeatInterval;
+      StoredSnapshot stored = readStored();
+      detachTimingProfile(stored);
+      stored.timing.heartBeatInterval = toDelay(heartBeatInterval);
+      publishStored(stored);
     }
 
     // The getClock() and readButton() are external dependencies that normally
@@ -315,7 +404,7 @@ class ButtonConfig {
      * Note: This should have been a const function. I cannot change it now
      * without breaking backwards compatibility.
      */
-    virtual int readButton(uint8_t pin) {
+    virtual int readButton(ButtonPinType pin) {
       return gpio_get_level((gpio_num_t)pin);
     }
 
@@ -324,17 +413,21 @@ class ButtonConfig {
 
     /** Check if the given features are enabled. */
     bool isFeature(FeatureFlagType features) const {
-      return mFeatureFlags & features;
+      return getSnapshot().isFeature(features);
     }
 
     /** Enable the given features. */
     void setFeature(FeatureFlagType features) {
-      mFeatureFlags |= features;
+      StoredSnapshot stored = readStored();
+      stored.featureFlags |= (features & ~kStoredSharedTiming);
+      publishStored(stored);
     }
 
     /** Disable the given features. */
     void clearFeature(FeatureFlagType features) {
-      mFeatureFlags &= ~features;
+      StoredSnapshot stored = readStored();
+      stored.featureFlags &= ~(features & ~kStoredSharedTiming);
+      publishStored(stored);
     }
 
     /**
@@ -345,8 +438,12 @@ class ButtonConfig {
     void resetFeatures() {
       // NOTE: If any additional kInternalFeatureXxx flag is added, it must be
       // added here like this:
-      // mFeatureFlags &= (kInternalFeatureIEventHandler | kInternalFeatureXxx)
-      mFeatureFlags &= kInternalFeatureIEventHandler;
+      // featureFlags &= (kInternalFeatureIEventHandler | kInternalFeatureXxx)
+      StoredSnapshot stored = readStored();
+      stored.featureFlags &= (kInternalFeatureIEventHandler
+          | kInternalFeatureIEventHandler2
+          | kStoredSharedTiming);
+      publishStored(stored);
     }
 
     // EventHandler
@@ -358,30 +455,43 @@ class ButtonConfig {
      * Deprecated as of v1.6 because the event handler can now be either a
      * function pointer or an object pointer. AceButton class now calls
      * dispatchEvent() which correctly handles both cases. Application code
-     * should never need to retrieve the event handler directly.
+     * should never need to retrieve the event handler directly. Returns
+     * nullptr if the handler is not an EventHandler function pointer.
      */
     EventHandler getEventHandler() const ACE_BUTTON_DEPRECATED {
-      return reinterpret_cast<EventHandler>(mEventHandler);
+      EventDelegate eventDelegate = getSnapshot().eventDelegate;
+      EventHandler eventHandler =
+          reinterpret_cast<EventHandler>(eventDelegate.getObject());
+      return (EventDelegate::fromFunction(eventHandler) == eventDelegate)
+          ? eventHandler
+          : nullptr;
     }
 
     /**
      * Dispatch the event to the handler. This is meant to be an internal
-     * method.
+     * method. The eventTime and duration are passed through to an
+     * IEventHandler2, and ignored by the other handler types.
+     *
+     * The handler is called through the EventDelegate using a single indirect
+     * call. There is no test for nullptr and no test of the
+     * kInternalFeatureIEventHandler flag, because an unset handler is bound to
+     * an empty stub. AceButton calls the EventDelegate of its Snapshot
+     * directly instead.
      */
     void dispatchEvent(AceButton* button, uint8_t eventType,
-        uint8_t buttonState) const {
-
-      if (! mEventHandler) return;
+        uint8_t buttonState, int64_t eventTime, int64_t duration) const {
+      getSnapshot().eventDelegate(
+          button, eventType, buttonState, eventTime, duration);
+    }
 
-      if (isFeature(kInternalFeatureIEventHandler)) {
-        IEventHandler* eventHandler =
-            reinterpret_cast<IEventHandler*>(mEventHandler);
-        eventHandler->handleEvent(button, eventType, buttonState);
-      } else {
-        EventHandler eventHandler =
-            reinterpret_cast<EventHandler>(mEventHandler);
-        eventHandler(button, eventType, buttonState);
-      }
+    /**
+     * Dispatch the event to the handler without timing information. An
+     * IEventHandler2 receives an eventTime and duration of 0. Retained for
+     * backwards compatibility.
+     */
+    void dispatchEvent(AceButton* button, uint8_t eventType,
+        uint8_t buttonState) const {
+      dispatchEvent(button, eventType, buttonState, 0, 0);
     }
 
     /**
@@ -389,8 +499,7 @@ class ButtonConfig {
      * defined for the AceButton to be useful.
      */
     void setEventHandler(EventHandler eventHandler) {
-      mEventHandler = reinterpret_cast<void*>(eventHandler);
-      clearFeature(kInternalFeatureIEventHandler);
+      setEventDelegate(EventDelegate::fromFunction(eventHandler), 0);
     }
 
     /**
@@ -398,10 +507,173 @@ class ButtonConfig {
      * defined for the AceButton to be useful.
      */
     void setIEventHandler(IEventHandler* eventHandler) {
-      mEventHandler = eventHandler;
-      setFeature(kInternalFeatureIEventHandler);
+      setEventDelegate(EventDelegate::fromHandler(eventHandler),
+          kInternalFeatureIEventHandler);
+    }
+
+    /**
+     * Install the IEventHandler2 object pointer, which receives the event time
+     * and the press duration in addition to the parameters of IEventHandler.
+     */
+    void setIEventHandler2(IEventHandler2* eventHandler) {
+      setEventDelegate(EventDelegate::fromHandler(eventHandler),
+          kInternalFeatureIEventHandler2);
+    }
+
+    /**
+     * Install an EventDelegate, which can be bound to a member function or a
+     * lambda in addition to the handler types accepted by setEventHandler(),
+     * setIEventHandler() and setIEventHandler2().
+     */
+    void setEventDelegate(const EventDelegate& eventDelegate) {
+      setEventDelegate(eventDelegate, 0);
+    }
+
+    /** Return the EventDelegate that receives the events. */
+    EventDelegate getEventDelegate() const {
+      return readStored().eventDelegate;
+    }
+
+    /**
+     * Use the given TimingProfile, which may be shared with other ButtonConfig
+     * instances, instead of the timing parameters of this ButtonConfig. The
+     * profile must outlive its use and must not be modified while in use. Pass
+     * nullptr to stop sharing and return to the default delays.
+     */
+    void setTimingProfile(const TimingProfile* profile) {
+      StoredSnapshot stored = readStored();
+      if (profile) {
+        setSharedProfile(stored, profile);
+      } else {
+        stored.timing = TimingProfile();
+        stored.featureFlags &= ~kStoredSharedTiming;
+      }
+      publishStored(stored);
+    }
+
+    /**
+     * Return the shared TimingProfile set by setTimingProfile(), or nullptr
+     * if this ButtonConfig uses its own timing parameters.
+     */
+    const TimingProfile* getTimingProfile() const {
+      return getSharedProfile(readStored());
+    }
+
+    /**
+     * Copy a consistent Snapshot of the configuration into snapshot. This is
+     * lock-free and never waits for a writer: the configuration is double
+     * buffered, and the copy is only retried if a writer published a new
+     * Snapshot while it was being read. Safe to call from any task.
+     */
+    void readSnapshot(Snapshot& snapshot) const {
+      StoredSnapshot stored = readStored();
+      const TimingProfile* profile = getSharedProfile(stored);
+      const TimingProfile& timing = profile ? *profile : stored.timing;
+      snapshot.eventDelegate = stored.eventDelegate;
+      snapshot.featureFlags = stored.featureFlags & ~kStoredSharedTiming;
+      snapshot.debounceDelay = timing.debounceDelay;
+      snapshot.clickDelay = timing.clickDelay;
+      snapshot.doubleClickDelay = timing.doubleClickDelay;
+      snapshot.longPressDelay = timing.longPressDelay;
+      snapshot.repeatPressDelay = timing.repeatPressDelay;
+      snapshot.repeatPressInterval = timing.repeatPressInterval;
+      snapshot.heartBeatInterval = timing.heartBeatInterval;
+    }
+
+    /** Return a consistent Snapshot of the configuration. */
+    Snapshot getSnapshot() const {
+      Snapshot snapshot;
+      readSnapshot(snapshot);
+      return snapshot;
+    }
+
+    /**
+     * Replace the whole configuration atomically with respect to the readers,
+     * for example to change several timing parameters at once. The delays are
+     * clamped to [0, kMaxDelay], and a shared TimingProfile is no longer used.
+     * Writers are not synchronized with each other, so the setters must be
+     * called from one task at a time.
+     */
+    void publishSnapshot(const Snapshot& snapshot) {
+      StoredSnapshot stored;
+      stored.eventDelegate = snapshot.eventDelegate;
+      stored.featureFlags = snapshot.featureFlags & ~kStoredSharedTiming;
+      stored.timing.debounceDelay = toDelay(snapshot.debounceDelay);
+      stored.timing.clickDelay = toDelay(snapshot.clickDelay);
+      stored.timing.doubleClickDelay = toDelay(snapshot.doubleClickDelay);
+      stored.timing.longPressDelay = toDelay(snapshot.longPressDelay);
+      stored.timing.repeatPressDelay = toDelay(snapshot.repeatPressDelay);
+      stored.timing.repeatPressInterval =
+          toDelay(snapshot.repeatPressInterval);
+      stored.timing.heartBeatInterval = toDelay(snapshot.heartBeatInterval);
+      publishStored(stored);
     }
 
+  #if ACE_BUTTON_ENABLE_STATS
+    /**
+     * Copy a consistent snapshot of the instrumentation counters of the
+     * buttons attached to this ButtonConfig. Returns false if the scan task was
+     * updating them for too long. Safe to call from any task. Only available
+     * if ACE_BUTTON_ENABLE_STATS is 1.
+     */
+    bool readStats(ButtonStats& stats) const {
+      return mStatsRecorder.read(stats);
+    }
+
+    /**
+     * Clear the instrumentation counters at the next check of a button. Safe
+     * to call from any task.
+     */
+    void resetStats() { mStatsRecorder.requestReset(); }
+
+    /** Return the recorder of the counters. This is meant to be internal. */
+    ButtonStatsRecorder& getStatsRecorder() { return mStatsRecorder; }
+  #endif
+
+  #if ACE_BUTTON_ENABLE_CHECK_TIMING
+    /** The histogram of check durations, in readCycleCounter() units. */
+    typedef LatencyHistogram<2> CheckTimeHistogram;
+
+    /**
+     * Return the histogram of the duration of AceButton::checkState() for the
+     * buttons attached to this ButtonConfig. Only available if
+     * ACE_BUTTON_ENABLE_CHECK_TIMING is 1.
+     */
+    CheckTimeHistogram& getCheckStateTimes() const {
+      return mCheckStateTimes;
+    }
+
+    /**
+     * Return the histogram of the duration of a complete checkButtons() loop
+     * of EncodedButtonConfig or LadderButtonConfig.
+     */
+    CheckTimeHistogram& getCheckButtonsTimes() const {
+      return mCheckButtonsTimes;
+    }
+  #endif
+
+  #if ACE_BUTTON_ENABLE_EDGE_LATENCY
+    /** The histogram of edge-to-dispatch latencies, in milliseconds. */
+    typedef LatencyHistogram<2> EdgeLatencyHistogram;
+
+    /**
+     * Return the histogram of the latency from the first raw edge of a button
+     * to the dispatch of the resulting kEventPressed or kEventReleased, for
+     * the buttons attached to this ButtonConfig. Only available if
+     * ACE_BUTTON_ENABLE_EDGE_LATENCY is 1.
+     */
+    EdgeLatencyHistogram& getEdgeLatencies() const { return mEdgeLatencies; }
+  #endif
+
+  #if ACE_BUTTON_ENABLE_SCAN_MONITOR
+    /**
+     * Return the monitor of the interval between the scans of the buttons
+     * attached to this ButtonConfig. Only available if
+     * ACE_BUTTON_ENABLE_SCAN_MONITOR is 1.
+     */
+    ScanMonitor& getScanMonitor() const { return mScanMonitor; }
+  #endif
+
     /**
      * Return a pointer to the singleton instance of the ButtonConfig
      * which is attached to all AceButton instances by default.
@@ -417,27 +689,139 @@ class ButtonConfig {
      */
     static ButtonConfig sSystemButtonConfig;
 
+    /**
+     * Flag of StoredSnapshot::featureFlags which indicates that the timing
+     * holds a pointer to a shared TimingProfile. Never visible in a Snapshot.
+     */
+    static const FeatureFlagType kStoredSharedTiming = 0x2000;
+
+    /**
+     * The form of the Snapshot kept in the ButtonConfig, with 16-bit delays.
+     * The 2-byte featureFlags follow the 14 bytes of timing so that the
+     * struct has no padding. If kStoredSharedTiming is set, the first bytes of
+     * timing hold the pointer to the shared TimingProfile instead, so sharing
+     * a profile costs no memory in either copy.
+     */
+    struct StoredSnapshot {
+      EventDelegate eventDelegate;
+      TimingProfile timing;
+      FeatureFlagType featureFlags = 0;
+    };
+
+    static_assert(sizeof(const TimingProfile*) <= sizeof(TimingProfile),
+        "TimingProfile too small to hold a pointer");
+
+    /** Clamp a delay to the range of TimingProfile. */
+    static uint16_t toDelay(int64_t delay) {
+      if (delay < 0) return 0;
+      if (delay > kMaxDelay) return kMaxDelay;
+      return (uint16_t) delay;
+    }
+
+    /** Return the shared TimingProfile of stored, or nullptr. */
+    static const TimingProfile* getSharedProfile(const StoredSnapshot& stored) {
+      if (! (stored.featureFlags & kStoredSharedTiming)) return nullptr;
+      const TimingProfile* profile;
+      memcpy(&profile, &stored.timing, sizeof(profile));
+      return profile;
+    }
+
+    /** Store the pointer to the shared profile in place of the timing. */
+    static void setSharedProfile(StoredSnapshot& stored,
+        const TimingProfile* profile) {
+      memcpy(static_cast<void*>(&stored.timing), &profile, sizeof(profile));
+      stored.featureFlags |= kStoredSharedTiming;
+    }
+
+    /** Copy the shared TimingProfile, if any, into the stored timing. */
+    static void detachTimingProfile(StoredSnapshot& stored) {
+      const TimingProfile* profile = getSharedProfile(stored);
+      if (profile) {
+        stored.timing = *profile;
+        stored.featureFlags &= ~kStoredSharedTiming;
+      }
+    }
+
+    /**
+     * Copy the StoredSnapshot which is stable for the readers. This is
+     * lock-free, see readSnapshot().
+     */
+    StoredSnapshot readStored() const {
+      StoredSnapshot stored;
+      uint32_t sequence;
+      do {
+        sequence = mSequence.load(std::memory_order_acquire);
+        stored = mSnapshots[sequence & 1];
+        std::atomic_thread_fence(std::memory_order_acquire);
+      } while (sequence != mSequence.load(std::memory_order_relaxed));
+      return stored;
+    }
+
+    /** Publish the StoredSnapshot to both buffers, see publishSnapshot(). */
+    void publishStored(const StoredSnapshot& stored) {
+      uint32_t sequence = mSequence.load(std::memory_order_relaxed);
+
+      // Readers use mSnapshots[1] while mSnapshots[0] is updated.
+      mSequence.store(sequence + 1, std::memory_order_relaxed);
+      std::atomic_thread_fence(std::memory_order_release);
+      mSnapshots[0] = stored;
+
+      // Readers use mSnapshots[0] while mSnapshots[1] is updated.
+      mSequence.store(sequence + 2, std::memory_order_release);
+      std::atomic_thread_fence(std::memory_order_release);
+      mSnapshots[1] = stored;
+    }
+
+    /**
+     * Install the eventDelegate and set the internal feature flag which
+     * describes it, in a single Snapshot.
+     */
+    void setEventDelegate(const EventDelegate& eventDelegate,
+        FeatureFlagType internalFeature) {
+      StoredSnapshot stored = readStored();
+      stored.eventDelegate = eventDelegate;
+      stored.featureFlags &= ~(kInternalFeatureIEventHandler
+          | kInternalFeatureIEventHandler2);
+      stored.featureFlags |= internalFeature;
+      publishStored(stored);
+    }
+
     // Disable copy-constructor and assignment operator
     ButtonConfig(const ButtonConfig&) = delete;
     ButtonConfig& operator=(const ButtonConfig&) = delete;
 
     /**
-     * The event handler for all buttons associated with this ButtonConfig.
-     * This can be a function pointer or an object pointer, depending on the
-     * kInternalFeatureIEventHandler flag.
+     * Sequence number of publishSnapshot(). Its lowest bit selects the
+     * element of mSnapshots which is stable for the readers.
      */
-    void* mEventHandler = nullptr;
+    std::atomic<uint32_t> mSequence{0};
 
-    /** A bit mask flag that activates certain features. */
-    FeatureFlagType mFeatureFlags = 0;
-
-    int64_t mDebounceDelay = kDebounceDelay;
-    int64_t mClickDelay = kClickDelay;
-    int64_t mDoubleClickDelay = kDoubleClickDelay;
-    int64_t mLongPressDelay = kLongPressDelay;
-    int64_t mRepeatPressDelay = kRepeatPressDelay;
-    int64_t mRepeatPressInterval = kRepeatPressInterval;
-    int64_t mHeartBeatInterval = kHeartBeatInterval;
+    /**
+     * Two copies of the event handler, feature flags and timing parameters
+     * for all buttons associated with this ButtonConfig.
+     */
+    StoredSnapshot mSnapshots[2];
+
+  #if ACE_BUTTON_ENABLE_STATS
+    /** Instrumentation counters, updated by the scan task. */
+    ButtonStatsRecorder mStatsRecorder;
+  #endif
+
+  #if ACE_BUTTON_ENABLE_CHECK_TIMING
+    /** Recorded by the scan task, even from const checkButtons(). */
+    mutable CheckTimeHistogram mCheckStateTimes;
+    mutable CheckTimeHistogram mCheckButtonsTimes;
+  #endif
+
+  #if ACE_BUTTON_ENABLE_EDGE_LATENCY
+    /** Recorded by the scan task. */
+    mutable EdgeLatencyHistogram mEdgeLatencies;
+  #endif
+
+  #if ACE_BUTTON_ENABLE_SCAN_MONITOR
+    /** Updated by the scan task. */
+    mutable ScanMonitor mScanMonitor;
+  #endif
 };
 
 }
@@ -0,0 +1,592 @@
+/*
+MIT License
+
+Copyright (c) 2018 Brian T. Park
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#ifndef ACE_BUTTON_BUTTON_CORE_H
+#define ACE_BUTTON_BUTTON_CORE_H
+
+#include "ButtonConfig.h"
+
+#define HIGH 0x1
+#define LOW  0x0
+
+namespace ace_button {
+
+class AceButton;
+
+/**
+ * The state and the event detection logic of a button, without the pointer to
+ * its ButtonConfig. The ButtonConfig is given to each checkState(), along with
+ * the AceButton which is passed to the event handler. An AceButton is a
+ * ButtonCore which knows its ButtonConfig. A CompactButton is a bare
+ * ButtonCore, owned and checked by a ButtonGroup, which saves the pointer in
+ * each button of large panels.
+ */
+class ButtonCore {
+  public:
+    // The supported event types.
+
+    /** Button was pressed. */
+    static const uint8_t kEventPressed = 0;
+
+    /** Button was released. */
+    static const uint8_t kEventReleased = 1;
+
+    /**
+     * Button was clicked (Pressed and Released within
+     * ButtonConfig::getClickDelay()).
+     */
+    static const uint8_t kEventClicked = 2;
+
+    /**
+     * Button was double-clicked. (Two clicks within
+     * ButtonConfig::getDoubleClickDelay()).
+     */
+    static const uint8_t kEventDoubleClicked = 3;
+
+    /**
+     * Button was held down for longer than
+     * ButtonConfig::getLongPressDelay()).
+     */
+    static const uint8_t kEventLongPressed = 4;
+
+    /**
+     * Button was held down and auto generated multiple presses. The first event
+     * is triggered after ButtonConfig::getRepeatPressDelay(), then the event
+     * fires repeatedly every ButtonConfig::getRepeatPressInterval() until the
+     * button is released.
+     */
+    static const uint8_t kEventRepeatPressed = 5;
+
+    /**
+     * Button was released after a long press. This event becomes the
+     * replacement for kEventReleased if kFeatureSuppressAfterLongPress is
+     * enabled. The kFeatureSuppressAfterLongPress allows us to distinguish a
+     * simple Pressed from a LongPressed, by using the Released event as a
+     * replacement of Pressed. But the suppression prevents us from detecting a
+     * Released event from a LongPress (which is sometimes needed). This event
+     * can be used as a replacement.
+     */
+    static const uint8_t kEventLongReleased = 6;
+
+    /**
+     * An event that fires every time interval defined by
+     * `getHeartBeatInterval()`. This is intended to allow custom subclasses of
+     * `IEventHandler` to track the progression of time even when no other
+     * event is occurring with a button. For example, this allows the
+     * IEventHandler to store the timestamp of the last kEventReleased, then
+     * trigger a custom kCustomLongReleased event after (say) 30 seconds after
+     * the last kEventReleased. Without the heart beat event, the IEventHandler
+     * would not be able to fire off a custom event.
+     */
+    static const uint8_t kEventHeartBeat = 7;
+
+    /**
+     * Button state is unknown. This is a third state (different from LOW or
+     * HIGH) used when the class is first initialized upon reboot. No longer
+     * able to use '2' because the new PinStatus enum API contains 'CHANGE'
+     * which has a value of 2.
+     */
+    static const uint8_t kButtonStateUnknown = 127;
+
+    /** Returned by getNextDeadline() if no timer of the button is running. */
+    static const int64_t kNoDeadline = INT64_MAX;
+
+    /**
+     * Return the human-readable name of the event. This is intended to
+     * help debugging. If this function is not used, the underlying table of
+     * strings will not be compiled into the resulting binary.
+     */
+    static const char* eventName(uint8_t event);
+
+    /**
+     * Reset the button to the initial constructed state. In particular,
+     * getLastButtonState() returns kButtonStateUnknown.
+     */
+    void init(
+        ButtonPinType pin = 0,
+        uint8_t defaultReleasedState = HIGH,
+        ButtonIdType id = 0);
+
+    /** Get the button's pin number. */
+    ButtonPinType getPin() const { return mPin; }
+
+    /** Get the custom identifier of the button. */
+    ButtonIdType getId() const { return mId; }
+
+    /** Get the initial released state of the button, HIGH or LOW. */
+    uint8_t getDefaultReleasedState() const;
+
+    /**
+     * Return the button state that was last valid. This is a tri-state
+     * function. It may return HIGH, LOW or kButtonStateUnknown to indicate that
+     * the last state is not known. This method is **not** for public
+     * consumption, it is exposed only for testing purposes. Consider it to be a
+     * private method. Use the buttonState parameter provided to the
+     * EventHandler.
+     *
+     * In a more general multi-threaded environment (which the Arduino is not,
+     * fortunately or unfortunately), the getLastButtonState() may have changed
+     * from the value of buttonState provided to the event handler. In other
+     * words, there is a race-condition.
+     */
+    uint8_t getLastButtonState() const {
+      return mLastButtonState;
+    }
+
+    /**
+     * Return true if the last debounced state of the button is Pressed.
+     * Returns false if it is Released or kButtonStateUnknown. Unlike
+     * AceButton::isPressedRaw(), this does not read the pin, so it can be
+     * used after AceButton::prime() to check the buttons held at boot.
+     */
+    bool isPressed() const {
+      return mLastButtonState != kButtonStateUnknown
+          && ! isReleased(mLastButtonState);
+    }
+
+    /**
+     * Seed the debounced state of the button with the given state, read by the
+     * caller at boot. The button then leaves kButtonStateUnknown without the
+     * initial debouncing period of check(), so the next change of the button is
+     * detected after a single getDebounceDelay(). Like a button which is held
+     * during a reboot, a button primed in the Pressed state does not fire
+     * kEventPressed. NOT for public consumption, use AceButton::prime() or the
+     * primeButtons() method of the configs.
+     */
+    void primeState(int buttonState);
+
+    /**
+     * Read the button numSamples times (at least once) using
+     * ButtonConfig::readButton() and return the state seen by the majority of
+     * the samples, HIGH or LOW. A tie returns the released state.
+     */
+    int sampleState(ButtonConfig* buttonConfig, uint8_t numSamples) const;
+
+    /**
+     * The in-flight state of a button in a compact binary form, to be kept in
+     * memory which survives a deep sleep (e.g. `RTC_NOINIT_ATTR` on the
+     * ESP32). The timestamps are stored as ages relative to the clock at
+     * saveState(), so they do not depend on the clock surviving the sleep.
+     * The ages other than the press age are clamped to 65535 ms, which is
+     * longer than any ButtonConfig delay (see ButtonConfig::kMaxDelay).
+     */
+    struct SavedState {
+      /** Age of the Pressed event, for the duration and the long press. */
+      uint32_t pressAge;
+
+      /** Age of the last click, for double clicks. */
+      uint16_t clickAge;
+
+      /** Age of the last repeat press. */
+      uint16_t repeatPressAge;
+
+      /** Age of the start of the debouncing in progress. */
+      uint16_t debounceAge;
+
+      /** Age of the last heart beat. */
+      uint16_t heartBeatAge;
+
+      /** The kFlag* bits of the button. */
+      uint16_t flags;
+
+      /** The debounced state, HIGH, LOW or kButtonStateUnknown. */
+      uint8_t lastButtonState;
+
+      /**
+       * CRC-8 of the preceding 15 bytes, starting from kSavedStateVersion,
+       * written by saveState() to reject the random contents of memory after
+       * a cold boot, a state torn by a reset during saveState(), or a state
+       * saved in another format.
+       */
+      uint8_t crc;
+    };
+
+    /**
+     * Version of the format of SavedState, used as the initial value of its
+     * crc.
+     */
+    static const uint8_t kSavedStateVersion = 2;
+
+    /**
+     * Save the state of the button, with the ages relative to the clock of
+     * the given ButtonConfig. NOT for public consumption, use
+     * AceButton::saveState() or the saveButtons() method of the configs.
+     */
+    void saveState(ButtonConfig* buttonConfig, SavedState& state) const;
+
+    /**
+     * Restore the state saved by saveState(), elapsedMillis after it was
+     * saved. The restored times are relative to the clock of the ButtonConfig,
+     * which may have been reset by the sleep in the meantime. Returns false
+     * and leaves the button unchanged if the state is not valid, i.e. its crc
+     * does not match. The pin, the
+     * id and the default released state of the button are not changed. NOT
+     * for public consumption, use AceButton::restoreState() or the
+     * restoreButtons() method of the configs.
+     */
+    bool restoreState(ButtonConfig* buttonConfig, const SavedState& state,
+        int64_t elapsedMillis);
+
+  #if ACE_BUTTON_ENABLE_EDGE_LATENCY
+    /**
+     * Record the time of a raw edge of the button, captured closer to the
+     * physical edge than the next check(), typically from a GPIO interrupt
+     * handler. The edgeMillis is the lower 32 bits of the getClock() time,
+     * e.g. `(uint32_t) (esp_timer_get_time() / 1000)`. Safe to call from an
+     * ISR. An edge which is not followed by a state change within
+     * getDebounceDelay() is ignored. Only available if
+     * ACE_BUTTON_ENABLE_EDGE_LATENCY is 1.
+     */
+    void markEdge(uint32_t edgeMillis) {
+      mIsrEdgeTime.store(edgeMillis, std::memory_order_relaxed);
+      mIsrEdgePending.store(true, std::memory_order_release);
+    }
+
+    /**
+     * Return the time of the first raw edge of the last state change of the
+     * button: the time given to markEdge(), or otherwise the time of the first
+     * check() which saw the new state. Within the event handler of a
+     * kEventPressed or kEventReleased, (eventTime - getEdgeTime()) is the
+     * latency of the event. Only available if ACE_BUTTON_ENABLE_EDGE_LATENCY
+     * is 1.
+     */
+    int64_t getEdgeTime() const { return mEdgeTime; }
+  #endif
+
+    /**
+     * Check the state of the button with the given ButtonConfig, and dispatch
+     * the events to its event handler with the given AceButton, which is this
+     * button itself, or a proxy of it (see ButtonGroup). NOT for public
+     * consumption.
+     */
+    void checkState(ButtonConfig* buttonConfig, AceButton* button,
+        int buttonState);
+
+    /**
+     * Version of AceButton::getNextDeadline() for the given ButtonConfig.
+     */
+    int64_t getNextDeadline(ButtonConfig* buttonConfig) const;
+
+    /**
+     * Returns true if the given buttonState represents a 'Released' state for
+     * the button. Returns false if the buttonState is 'Pressed' or
+     * kButtonStateUnknown.
+     *
+     * The HIGH or LOW logical value of buttonState represents different a
+     * button position depending on whether the button is wired with a pull-up
+     * or a pull-down resistor. This method translates the logical level to the
+     * physical position which allows the client code to be independent of the
+     * physical wiring.
+     *
+     * Normally, the eventType given to the EventHandler should be sufficient
+     * because the value of the eventType already encodes this information.
+     * This method is provided just in case.
+     */
+    bool isReleased(int buttonState) const {
+      return buttonState == getDefaultReleasedState();
+    }
+
+  protected:
+    /**
+     * Constructor, equivalent to init(). It is constexpr so that the buttons
+     * of a static panel can be constant-initialized, without any code running
+     * at startup.
+     */
+    constexpr ButtonCore(ButtonPinType pin, uint8_t defaultReleasedState,
+        ButtonIdType id):
+        mPin(pin),
+        mId(id),
+        mFlags((defaultReleasedState == HIGH) ? kFlagDefaultReleasedState : 0),
+        mLastButtonState(kButtonStateUnknown),
+        mLastDebounceTime(0),
+        mLastClickTime(0),
+        mLastPressTime(0),
+        mLastRepeatPressTime(0),
+        mLastHeartBeatTime(0)
+      #if ACE_BUTTON_ENABLE_EDGE_LATENCY
+        , mEdgeTime(0),
+        mIsrEdgeTime(0),
+        mIsrEdgePending(false)
+      #endif
+        {}
+
+    /**
+     * Move constructor. A button holds no pointer into itself, so it can be
+     * relocated to another address (e.g. by ButtonArray) without losing its
+     * state. The button must not be checked or marked by an ISR while it is
+     * being moved.
+     */
+    ButtonCore(ButtonCore&& other) noexcept:
+        ButtonCore(0, HIGH, 0) {
+      moveFrom(other);
+    }
+
+    /** Move assignment operator, see ButtonCore(ButtonCore&&). */
+    ButtonCore& operator=(ButtonCore&& other) noexcept {
+      moveFrom(other);
+      return *this;
+    }
+
+    // Disable copy-constructor and assignment operator
+    ButtonCore(const ButtonCore&) = delete;
+    ButtonCore& operator=(const ButtonCore&) = delete;
+
+    /**
+     * The ButtonConfig::Snapshot read once per checkState(), with the
+     * ButtonConfig and the AceButton given to it.
+     */
+    struct CheckContext: ButtonConfig::Snapshot {
+      ButtonConfig* buttonConfig;
+      AceButton* button;
+    };
+
+    /** Set the pin number of the button. */
+    void setPin(ButtonPinType pin) { mPin = pin; }
+
+    /**
+     * Set the initial released state of the button.
+     *
+     * @param state If a pull up resistor is used, this should be HIGH. If a
+     * pull down resistor is used, this should be LOW. The behavior is undefined
+     * for any other values of 'state'.
+     */
+    void setDefaultReleasedState(uint8_t state);
+
+    /** Set the identifier of the button. */
+    void setId(ButtonIdType id) { mId = id; }
+
+    // Various bit masks to store a boolean flag in the 'mFlags' field.
+    // We use bit masks to save static RAM. If we had used a 'bool' type, each
+    // of these would consume one byte.
+    typedef uint16_t FlagType;
+    static const FlagType kFlagDefaultReleasedState = 0x01;
+    static const FlagType kFlagDebouncing = 0x02;
+    static const FlagType kFlagPressed = 0x04; // mLastPressTime is valid
+    static const FlagType kFlagClicked = 0x08; // mLastClickTime valid
+    static const FlagType kFlagDoubleClicked = 0x10;
+    static const FlagType kFlagLongPressed = 0x20;
+    static const FlagType kFlagRepeatPressed = 0x40; // mLastRepeatPressTime
+    static const FlagType kFlagClickPostponed = 0x80;
+    static const FlagType kFlagHeartRunning = 0x100; // mLastHeartBeatTime valid
+
+    bool isFlag(FlagType flag) const {
+      return mFlags & flag;
+    }
+
+    void setFlag(FlagType flag) {
+      mFlags |= flag;
+    }
+
+    void clearFlag(FlagType flag) {
+      mFlags &= ~flag;
+    }
+
+    static int64_t minTime(int64_t a, int64_t b) {
+      return (a < b) ? a : b;
+    }
+
+  #if ACE_BUTTON_ENABLE_EDGE_LATENCY
+    /**
+     * Return the time of the raw edge which started the current debouncing
+     * phase: the time given to markEdge() if recent enough, otherwise now.
+     */
+    int64_t consumeEdgeTime(const CheckContext& config, int64_t now);
+  #endif
+
+    /**
+     * Return true if debouncing succeeded and the buttonState value can be
+     * used. Return false if buttonState should be ignored until debouncing
+     * phase is complete.
+     */
+    bool checkDebounced(const CheckContext& config, int64_t now,
+        int buttonState);
+
+    /**
+     * Return true if the button was already initialzed and determined to be in
+     * a HIGH or LOW state. Return false if the button was previously in
+     * kButtonStateUnknown state which implies that the event handler should
+     * NOT be fired.
+     */
+    bool checkInitialized(uint16_t buttonState);
+
+    /** Categorize the button event. */
+    void checkEvent(const CheckContext& config, int64_t now,
+        int buttonState);
+
+    /** Check for a long press event and dispatch to event handler. */
+    void checkLongPress(const CheckContext& config, int64_t now,
+        int buttonState);
+
+    /** Check for a repeat press event and dispatch to event handler. */
+    void checkRepeatPress(const CheckContext& config, int64_t now,
+        int buttonState);
+
+    /** Check for onChange event and check for Press or Release events. */
+    void checkChanged(const CheckContext& config, int64_t now,
+        int buttonState);
+
+    /**
+     * Check for Released and Click events and dispatch to respective
+     * handlers.
+     */
+    void checkReleased(const CheckContext& config, int64_t now,
+        int buttonState);
+
+    /** Check for Pressed event and dispatch to handler. */
+    void checkPressed(const CheckContext& config, int64_t now,
+        int buttonState);
+
+    /** Check for a single click event and dispatch to handler. */
+    void checkClicked(const CheckContext& config, int64_t now);
+
+    /**
+     * Check for a double click event and dispatch to handler. Return true if
+     * double click detected.
+     */
+    void checkDoubleClicked(const CheckContext& config, int64_t now);
+
+    /**
+     * Check for an orphaned click that did not generate a double click and
+     * clean up internal state. If we don't do this, the second click may be
+     * generated after the uint16_t rolls over in 65.5 seconds, causing an
+     * unwanted double-click. Even if we used the full 'unsigned long' to store
+     * the 'lastClickTime', we'd still need this function to prevent a rollover
+     * of the 32-bit number in 49.7 days.
+     */
+    void checkOrphanedClick(const CheckContext& config, int64_t now);
+
+    /**
+     * Check if a click message has been postponed because of
+     * ButtonConfig::kFeatureSuppressClickBeforeDoubleClick.
+     */
+    void checkPostponedClick(const CheckContext& config, int64_t now);
+
+    /** Check if a heart beat should be sent. */
+    void checkHeartBeat(const CheckContext& config, int64_t now);
+
+    /**
+     * Dispatch to the event handler defined in the ButtonConfig, with the
+     * AceButton given to checkState(). If it is a proxy of this button (e.g.
+     * in a ButtonGroup), the state of this button is copied into it first.
+     *
+     * This method will always be called and it's up to the user-provided
+     * handler to ignore the events which aren't interesting.
+     *
+     * An alternative might be to provide a bitmask filter to select only
+     * events which should are registered to trigger the event handler. For
+     * example, add the following method:
+     *
+     * @code
+     *    setEventSelection(uint8_t eventSelection) {
+     *      mEventSelection = eventSelection;
+     *    }
+     * @endcode
+     *
+     * Set the event selector at setup():
+     *
+     * @code
+     *    setEventSelection(kEventSelectPressed | kEventSelectReleased);
+     * @endcode
+     *
+     * where
+     *
+     * @code
+     *  kEventSelectPressed = (0x1 << kEventPressed);
+     *  kEventSelectReleased = (0x1 << kEventReleased);
+     *  ...
+     * @endcode
+     *
+     * Then change the handleEvent() method to something like:
+     *
+     * @code
+     * void handleEvent(uint8_t eventType) {
+     *    if (mEventHandler && (eventSelections & (0x1 << eventType))) {
+     *      handleEvent(this, eventType);
+     *    }
+     * }
+     * @endcode
+     *
+     * But it is possible that the evaluation of the if-condition above takes
+     * longer to evaluate than an empty function call, so we should do some
+     * profiling before making this change.
+     *
+     * Note: This probably should have been a const function. But that would
+     * require the ButtonConfig::EventHandler callback function to accept a
+     * `const AceButton*` instead of a `AceButton*`. Unfortunately, that
+     * signature is part of the API, and I cannot change it without
+     * breaking backwards compatibility.
+     *
+     * @param config the ButtonConfig::Snapshot read at the start of
+     *        checkState(), with the ButtonConfig and the AceButton
+     * @param eventType the type of event given by the kEvent* constants
+     * @param now the clock time sampled at the start of checkState()
+     * @param duration milliseconds between the Pressed event and the release
+     *        of the button, for the Released, LongReleased and Clicked events
+     */
+    void handleEvent(const CheckContext& config, uint8_t eventType,
+        int64_t now, int64_t duration = 0);
+
+    /** Copy the state of this button into a proxy before dispatching. */
+    void copyStateTo(ButtonCore& proxy) const;
+
+    /** Take over the complete state of the other button. */
+    void moveFrom(ButtonCore& other);
+
+  private:
+    // The 8-bit or 16-bit mPin and mId, the 16-bit mFlags and the 8-bit
+    // mLastButtonState fit in the 8 bytes before the int64_t fields either way.
+
+    /** button pin number */
+    ButtonPinType mPin;
+
+    /** identifier, e.g. an index into an array */
+    ButtonIdType mId;
+
+    /** Internal flags. Bit masks are defined by the kFlag* constants. */
+    FlagType mFlags;
+
+    /**
+     * Last button state. This is a tri-state variable: LOW, HIGH or
+     * kButtonStateUnknown.
+     */
+    uint8_t mLastButtonState;
+
+    // Internal states of the button debouncing and event handling.
+    // NOTE: We don't keep track of the lastDoubleClickTime, because we
+    // don't support a TripleClicked event. That may change in the future.
+    int64_t mLastDebounceTime; // ms
+    int64_t mLastClickTime; // ms
+    int64_t mLastPressTime; // ms
+    int64_t mLastRepeatPressTime; // ms
+    int64_t mLastHeartBeatTime; // ms
+
+  #if ACE_BUTTON_ENABLE_EDGE_LATENCY
+    int64_t mEdgeTime; // ms
+    std::atomic<uint32_t> mIsrEdgeTime; // ms, lower 32 bits
+    std::atomic<bool> mIsrEdgePending;
+  #endif
+};
+
+}
+#endif
@@ -0,0 +1,439 @@
+/*
+MIT License
+
+Copyright (c) 2026 Brian T. Park
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#ifndef ACE_BUTTON_BUTTON_COROUTINE_H
+#define ACE_BUTTON_BUTTON_COROUTINE_H
+
+/**
+ * @file ButtonCoroutine.h
+ *
+ * C++20 coroutine support, so that an interaction flow spanning several
+ * button events can be written as straight-line code:
+ *
+ * @code
+ * ButtonAwaitDispatcher dispatcher;
+ *
+ * ButtonTask unlock() {
+ *   while (true) {
+ *     co_await dispatcher.next(&modeButton, AceButton::kEventLongPressed);
+ *     ButtonEvent event = co_await dispatcher.anyOf(&upButton, &downButton)
+ *         .clicked();
+ *     ...
+ *   }
+ * }
+ *
+ * void setup() {
+ *   ...
+ *   dispatcher.attach(&buttonConfig);
+ *   unlock();
+ * }
+ * @endcode
+ *
+ * The coroutines are resumed from ButtonConfig::dispatchEvent(), in the task
+ * which calls AceButton::check(). Their frames are allocated from a static pool
+ * of ACE_BUTTON_COROUTINE_NUM_FRAMES frames of ACE_BUTTON_COROUTINE_FRAME_SIZE
+ * bytes, never from the heap. If the pool is exhausted, or if the frame is too
+ * large, the coroutine does not start and ButtonTask::isValid() returns false.
+ *
+ * Only available when the compiler supports C++20 coroutines (e.g.
+ * -std=gnu++20).
+ */
+
+#if defined(__cpp_impl_coroutine) && __has_include(<coroutine>)
+
+#include <stddef.h>
+#include <stdint.h>
+#include <coroutine>
+#include <exception>
+#include "AceButton.h"
+#include "ButtonConfig.h"
+#include "ButtonEvent.h"
+
+#ifndef ACE_BUTTON_COROUTINE_NUM_FRAMES
+  /** Number of coroutine frames in the static pool, at most 32. */
+  #define ACE_BUTTON_COROUTINE_NUM_FRAMES 4
+#endif
+
+#ifndef ACE_BUTTON_COROUTINE_FRAME_SIZE
+  /** Size in bytes of each coroutine frame in the static pool. */
+  #define ACE_BUTTON_COROUTINE_FRAME_SIZE 384
+#endif
+
+namespace ace_button {
+
+/**
+ * A fixed pool of equally sized memory blocks for the coroutine frames.
+ *
+ * @tparam T_FRAME_SIZE size of each frame in bytes
+ * @tparam T_NUM_FRAMES number of frames, at most 32
+ */
+template <size_t T_FRAME_SIZE, uint8_t T_NUM_FRAMES>
+class CoroutineFramePool {
+  static_assert(T_NUM_FRAMES > 0 && T_NUM_FRAMES <= 32,
+      "T_NUM_FRAMES must be between 1 and 32");
+
+  public:
+    /** Return a free frame, or nullptr if none is available. */
+    void* allocate(size_t size) {
+      if (size > T_FRAME_SIZE) return nullptr;
+      for (uint8_t i = 0; i < T_NUM_FRAMES; i++) {
+        uint32_t bit = (uint32_t) 1 << i;
+        if ((mUsed & bit) == 0) {
+          mUsed |= bit;
+          return mFrames[i].bytes;
+        }
+      }
+      return nullptr;
+    }
+
+    /** Return the frame to the pool. */
+    void deallocate(void* frame) {
+      size_t index = (Frame*) frame - mFrames;
+      mUsed &= ~((uint32_t) 1 << index);
+    }
+
+    /** Number of free frames. */
+    uint8_t getNumFree() const {
+      uint8_t count = 0;
+      for (uint8_t i = 0; i < T_NUM_FRAMES; i++) {
+        if ((mUsed & ((uint32_t) 1 << i)) == 0) count++;
+      }
+      return count;
+    }
+
+    /** Size of each frame. */
+    static size_t getFrameSize() { return T_FRAME_SIZE; }
+
+  private:
+    struct Frame {
+      alignas(alignof(max_align_t)) uint8_t bytes[T_FRAME_SIZE];
+    };
+
+    Frame mFrames[T_NUM_FRAMES];
+    uint32_t mUsed = 0;
+};
+
+/** The pool used by all ButtonTask coroutines. */
+typedef CoroutineFramePool<ACE_BUTTON_COROUTINE_FRAME_SIZE,
+    ACE_BUTTON_COROUTINE_NUM_FRAMES> ButtonTaskFramePool;
+
+/** Return the pool used by all ButtonTask coroutines. */
+inline ButtonTaskFramePool& getButtonTaskFramePool() {
+  static ButtonTaskFramePool pool;
+  return pool;
+}
+
+/**
+ * The return type of a coroutine which awaits button events. The coroutine
+ * starts immediately, runs until its first co_await, and its frame is released
+ * when it returns. The ButtonTask itself can be discarded.
+ */
+class ButtonTask {
+  public:
+    struct promise_type {
+      static void* operator new(size_t size) noexcept {
+        return getButtonTaskFramePool().allocate(size);
+      }
+
+      static void operator delete(void* frame) noexcept {
+        getButtonTaskFramePool().deallocate(frame);
+      }
+
+      static ButtonTask get_return_object_on_allocation_failure() {
+        return ButtonTask(false);
+      }
+
+      ButtonTask get_return_object() { return ButtonTask(true); }
+
+      std::suspend_never initial_suspend() noexcept { return {}; }
+
+      std::suspend_never final_suspend() noexcept { return {}; }
+
+      void return_void() {}
+
+      void unhandled_exception() { std::terminate(); }
+    };
+
+    /** Return false if the coroutine could not be started. */
+    bool isValid() const { return mValid; }
+
+  private:
+    explicit ButtonTask(bool valid):
+        mValid(valid) {}
+
+    bool mValid;
+};
+
+class ButtonAwaitDispatcher;
+
+/**
+ * The awaitable returned by ButtonAwaitDispatcher::next() and by the methods
+ * of ButtonAwaitDispatcher::ButtonSet. It lives in the frame of the awaiting
+ * coroutine, and is linked into the list of the dispatcher while the coroutine
+ * is suspended. The result of co_await is the ButtonEvent which resumed it.
+ */
+class ButtonEventAwaiter {
+  public:
+    /** Maximum number of buttons which can be awaited at once. */
+    static const uint8_t kMaxButtons = 4;
+
+    bool await_ready() const noexcept { return false; }
+
+    inline void await_suspend(std::coroutine_handle<> handle) noexcept;
+
+    ButtonEvent await_resume() const noexcept { return mEvent; }
+
+  private:
+    friend class ButtonAwaitDispatcher;
+
+    ButtonEventAwaiter(ButtonAwaitDispatcher* dispatcher,
+        AceButton* const* buttons, uint8_t numButtons, uint8_t eventMask):
+        mDispatcher(dispatcher),
+        mNumButtons(numButtons),
+        mEventMask(eventMask),
+        mById(false) {
+      for (uint8_t i = 0; i < numButtons; i++) mButtons[i] = buttons[i];
+    }
+
+    ButtonEventAwaiter(ButtonAwaitDispatcher* dispatcher,
+        AceButton* button, ButtonIdType buttonId, uint8_t eventMask):
+        mDispatcher(dispatcher),
+        mNumButtons(1),
+        mEventMask(eventMask),
+        mById(true),
+        mButtonId(buttonId) {
+      mButtons[0] = button;
+    }
+
+    /**
+     * Return true if the event resumes this awaiter. The button id is
+     * compared only when waiting for one button of a ButtonGroup or a
+     * ButtonPanel, whose buttons all report the same proxy pointer.
+     */
+    bool matches(const ButtonEvent& event) const {
+      if ((mEventMask & (1 << event.eventType)) == 0) return false;
+      if (mById && event.buttonId != mButtonId) return false;
+      for (uint8_t i = 0; i < mNumButtons; i++) {
+        if (mButtons[i] == event.button) return true;
+      }
+      return false;
+    }
+
+    ButtonAwaitDispatcher* mDispatcher;
+    AceButton* mButtons[kMaxButtons];
+    uint8_t mNumButtons;
+    uint8_t mEventMask;
+    bool mById;
+    ButtonIdType mButtonId = 0;
+    std::coroutine_handle<> mHandle;
+    ButtonEvent mEvent;
+    ButtonEventAwaiter* mNext = nullptr;
+};
+
+/**
+ * The event handler which resumes the coroutines waiting for button events.
+ * It is installed as the EventDelegate of one or more ButtonConfig instances,
+ * which must all be checked from the same task.
+ *
+ * When an event fires, all awaiters which match the button and event type are
+ * removed from the waiting list first, then resumed in the order in which they
+ * started waiting. A coroutine which awaits again while it is being resumed
+ * waits for the next event, not for the current one.
+ */
+class ButtonAwaitDispatcher {
+  public:
+    /** A set of buttons, returned by anyOf(), whose events can be awaited. */
+    class ButtonSet {
+      public:
+        /** Wait for the given event type on any button of the set. */
+        ButtonEventAwaiter next(uint8_t eventType) const {
+          return ButtonEventAwaiter(
+              mDispatcher, mButtons, mNumButtons, 1 << eventType);
+        }
+
+        /** Wait for any of the event types in the mask (1 << kEventXxx). */
+        ButtonEventAwaiter nextOf(uint8_t eventMask) const {
+          return ButtonEventAwaiter(
+              mDispatcher, mButtons, mNumButtons, eventMask);
+        }
+
+        ButtonEventAwaiter pressed() const {
+          return next(AceButton::kEventPressed);
+        }
+
+        ButtonEventAwaiter released() const {
+          return next(AceButton::kEventReleased);
+        }
+
+        ButtonEventAwaiter clicked() const {
+          return next(AceButton::kEventClicked);
+        }
+
+        ButtonEventAwaiter longPressed() const {
+          return next(AceButton::kEventLongPressed);
+        }
+
+      private:
+        friend class ButtonAwaitDispatcher;
+
+        ButtonSet(ButtonAwaitDispatcher* dispatcher,
+            AceButton* const* buttons, uint8_t numButtons):
+            mDispatcher(dispatcher),
+            mNumButtons(numButtons) {
+          for (uint8_t i = 0; i < numButtons; i++) mButtons[i] = buttons[i];
+        }
+
+        ButtonAwaitDispatcher* mDispatcher;
+        AceButton* mButtons[ButtonEventAwaiter::kMaxButtons];
+        uint8_t mNumButtons;
+    };
+
+    ButtonAwaitDispatcher() {}
+
+    /** Install this dispatcher as the event handler of the ButtonConfig. */
+    void attach(ButtonConfig* buttonConfig) {
+      buttonConfig->setEventDelegate(
+          EventDelegate::fromMethod2<ButtonAwaitDispatcher,
+              &ButtonAwaitDispatcher::handleEvent>(this));
+    }
+
+    /** Wait for the given event type on the button. */
+    ButtonEventAwaiter next(AceButton* button, uint8_t eventType) {
+      return ButtonEventAwaiter(this, &button, 1, 1 << eventType);
+    }
+
+    /**
+     * Wait for the given event type on the button with the given id, among
+     * the buttons which report the given AceButton, e.g. the proxy returned
+     * by ButtonGroup::getProxy().
+     */
+    ButtonEventAwaiter next(AceButton* button, ButtonIdType buttonId,
+        uint8_t eventType) {
+      return ButtonEventAwaiter(this, button, buttonId, 1 << eventType);
+    }
+
+    /**
+     * Return the set of the given buttons (at most
+     * ButtonEventAwaiter::kMaxButtons), to wait for an event on any of them.
+     */
+    template <typename... B>
+    ButtonSet anyOf(B*... buttons) {
+      static_assert(sizeof...(buttons) > 0
+          && sizeof...(buttons) <= ButtonEventAwaiter::kMaxButtons,
+          "anyOf() takes 1 to ButtonEventAwaiter::kMaxButtons buttons");
+      AceButton* array[] = {buttons...};
+      return ButtonSet(this, array, sizeof...(buttons));
+    }
+
+    /** Resume the coroutines waiting for this event. */
+    void handleEvent(AceButton* button, uint8_t eventType,
+        uint8_t buttonState, int64_t eventTime, int64_t duration) {
+      // The id and pin are captured now, because the state of a proxy button
+      // changes with the next event.
+      ButtonEvent event;
+      event.eventTime = eventTime;
+      event.button = button;
+      event.buttonId = button->getId();
+      event.pin = button->getPin();
+      event.duration = (int32_t) duration;
+      event.eventType = eventType;
+      event.buttonState = buttonState;
+      event.source = 0;
+      event.count = 1;
+
+      // Detach the matching awaiters first, so that the coroutines can await
+      // again while they are resumed.
+      ButtonEventAwaiter* ready = nullptr;
+      ButtonEventAwaiter** readyTail = &ready;
+      ButtonEventAwaiter** link = &mWaiting;
+      while (*link != nullptr) {
+        ButtonEventAwaiter* awaiter = *link;
+        if (awaiter->matches(event)) {
+          *link = awaiter->mNext;
+          awaiter->mNext = nullptr;
+          *readyTail = awaiter;
+          readyTail = &awaiter->mNext;
+        } else {
+          link = &awaiter->mNext;
+        }
+      }
+
+      while (ready != nullptr) {
+        ButtonEventAwaiter* awaiter = ready;
+        ready = awaiter->mNext;
+        awaiter->mEvent = event;
+        awaiter->mHandle.resume();
+      }
+    }
+
+    /** Number of coroutines waiting for an event. */
+    uint8_t getNumWaiting() const {
+      uint8_t count = 0;
+      for (const ButtonEventAwaiter* a = mWaiting; a != nullptr; a = a->mNext) {
+        count++;
+      }
+      return count;
+    }
+
+    /**
+     * Destroy all waiting coroutines without resuming them, and release their
+     * frames.
+     */
+    void cancelAll() {
+      while (mWaiting != nullptr) {
+        ButtonEventAwaiter* awaiter = mWaiting;
+        mWaiting = awaiter->mNext;
+        awaiter->mHandle.destroy();
+      }
+    }
+
+  private:
+    friend class ButtonEventAwaiter;
+
+    // Disable copy-constructor and assignment operator
+    ButtonAwaitDispatcher(const ButtonAwaitDispatcher&) = delete;
+    ButtonAwaitDispatcher& operator=(const ButtonAwaitDispatcher&) = delete;
+
+    /** Append the awaiter to the waiting list. */
+    void add(ButtonEventAwaiter* awaiter) {
+      ButtonEventAwaiter** link = &mWaiting;
+      while (*link != nullptr) link = &(*link)->mNext;
+      *link = awaiter;
+    }
+
+    ButtonEventAwaiter* mWaiting = nullptr;
+};
+
+void ButtonEventAwaiter::await_suspend(std::coroutine_handle<> handle)
+    noexcept {
+  mHandle = handle;
+  mNext = nullptr;
+  mDispatcher->add(this);
+}
+
+}
+
+#endif
+
+#endif
@@ -0,0 +1,88 @@
+/*
+MIT License
+
+Copyright (c) 2026 Brian T. Park
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#ifndef ACE_BUTTON_BUTTON_EVENT_H
+#define ACE_BUTTON_BUTTON_EVENT_H
+
+#include <stdint.h>
+#include "ButtonIndex.h"
+
+namespace ace_button {
+
+class AceButton;
+
+/**
+ * A self-contained record of a button event, as delivered to an
+ * IEventHandler2, so that it can be stored in a queue and processed later,
+ * possibly by a different task. It is a plain struct which can be copied with
+ * memcpy().
+ */
+struct ButtonEvent {
+  /** The clock time (milliseconds) when the event was detected. */
+  int64_t eventTime;
+
+  /**
+   * The button which generated the event. The buttons of a ButtonGroup or a
+   * ButtonPanel all report the same proxy AceButton, whose state changes with
+   * every event, so a consumer which processes the event later must use
+   * buttonId and pin instead of dereferencing this pointer.
+   */
+  AceButton* button;
+
+  /**
+   * Milliseconds the button was held down, for kEventReleased,
+   * kEventLongReleased and kEventClicked, otherwise 0.
+   */
+  int32_t duration;
+
+  /** The AceButton::kEventXxx event type. */
+  uint8_t eventType;
+
+  /** The button state (HIGH or LOW) which triggered the event. */
+  uint8_t buttonState;
+
+  /**
+   * Index of the producer (e.g. the EventBus lane) which published the event,
+   * or the priority class of the event in a PriorityEventQueue.
+   */
+  uint8_t source;
+
+  /**
+   * Number of events represented by this record. Normally 1, but greater when
+   * consecutive kEventRepeatPressed or kEventHeartBeat events of the button
+   * were merged by an EventCoalescer. The eventTime is then that of the
+   * latest event.
+   */
+  uint16_t count;
+
+  /** The id of the button, captured when the event was created. */
+  ButtonIdType buttonId;
+
+  /** The pin of the button, captured when the event was created. */
+  ButtonPinType pin;
+};
+
+}
+
+#endif
@@ -0,0 +1,205 @@
+/*
+MIT License
+
+Copyright (c) 2026 Brian T. Park
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#ifndef ACE_BUTTON_BUTTON_GROUP_H
+#define ACE_BUTTON_BUTTON_GROUP_H
+
+#include <stdint.h>
+#include "ButtonCore.h"
+#include "AceButton.h"
+
+namespace ace_button {
+
+/**
+ * A button without a pointer to its ButtonConfig, which saves 4 bytes of RAM
+ * per button on a 32-bit processor (more with padding), compared to an
+ * AceButton. It cannot be checked by itself. It is owned by a ButtonGroup,
+ * which checks it through the ButtonConfig of the group.
+ */
+class CompactButton: public ButtonCore {
+  public:
+    /**
+     * Constructor. The parameters are identical to the parameters of the
+     * AceButton() constructor.
+     */
+    constexpr explicit CompactButton(
+        ButtonPinType pin = 0,
+        uint8_t defaultReleasedState = HIGH,
+        ButtonIdType id = 0) :
+        ButtonCore(pin, defaultReleasedState, id) {}
+};
+
+/**
+ * An array of CompactButton instances which share a single ButtonConfig, for
+ * large panels of buttons. The event handler of the ButtonConfig receives a
+ * proxy AceButton owned by the group, which carries the pin, the id and the
+ * state of the button which triggered the event. The proxy is valid only
+ * during the call to the event handler; use getId() or getPin() to identify
+ * the button, not the pointer.
+ *
+ * Usage:
+ *
+ * @code
+ * CompactButton buttons[NUM_BUTTONS];
+ * ButtonConfig buttonConfig;
+ * ButtonGroup group(&buttonConfig, buttons, NUM_BUTTONS);
+ *
+ * void setup() {
+ *   for (ButtonCountType i = 0; i < NUM_BUTTONS; i++) {
+ *     buttons[i].init(PINS[i], HIGH, i);
+ *   }
+ *   buttonConfig.setEventHandler(handleEvent);
+ * }
+ *
+ * void loop() {
+ *   group.checkButtons();
+ * }
+ * @endcode
+ */
+class ButtonGroup {
+  public:
+    /**
+     * Constructor.
+     * @param buttonConfig the ButtonConfig shared by the buttons
+     * @param buttons array of CompactButton instances, owned by the caller
+     *        but checked only through this group
+     * @param numButtons number of buttons in the array
+     */
+    constexpr ButtonGroup(ButtonConfig* buttonConfig, CompactButton buttons[],
+        ButtonCountType numButtons):
+        mButtonConfig(buttonConfig),
+        mButtons(buttons),
+        mNumButtons(numButtons),
+        mProxy(buttonConfig) {}
+
+    /** Get the ButtonConfig shared by the buttons. */
+    ButtonConfig* getButtonConfig() const { return mButtonConfig; }
+
+    /** Return the number of buttons. */
+    ButtonCountType getNumButtons() const { return mNumButtons; }
+
+    /** Return the button at the given index. */
+    CompactButton& getButton(ButtonCountType i) { return mButtons[i]; }
+
+    /** Return the button at the given index. */
+    const CompactButton& getButton(ButtonCountType i) const {
+      return mButtons[i];
+    }
+
+    /**
+     * Return the proxy AceButton given to the event handler for every button
+     * of the group. Use ButtonEvent::buttonId to tell the buttons apart.
+     */
+    AceButton* getProxy() { return &mProxy; }
+
+    /**
+     * Read each button using ButtonConfig::readButton() and check its state.
+     * Equivalent to calling AceButton::check() on each button.
+     */
+    void checkButtons() {
+      for (ButtonCountType i = 0; i < mNumButtons; i++) {
+        CompactButton& button = mButtons[i];
+        button.checkState(mButtonConfig, &mProxy,
+            mButtonConfig->readButton(button.getPin()));
+      }
+    }
+
+    /**
+     * Prime each button with the majority of numSamples reads, like
+     * AceButton::prime(). Returns the number of pressed buttons.
+     */
+    ButtonCountType primeButtons(uint8_t numSamples = 1) {
+      ButtonCountType numPressed = 0;
+      for (ButtonCountType i = 0; i < mNumButtons; i++) {
+        CompactButton& button = mButtons[i];
+        button.primeState(button.sampleState(mButtonConfig, numSamples));
+        if (button.isPressed()) numPressed++;
+      }
+      return numPressed;
+    }
+
+    /**
+     * Save the state of the buttons into the states array, which must hold
+     * getNumButtons() elements. See AceButton::saveState().
+     */
+    void saveButtons(ButtonCore::SavedState states[]) const {
+      for (ButtonCountType i = 0; i < mNumButtons; i++) {
+        mButtons[i].saveState(mButtonConfig, states[i]);
+      }
+    }
+
+    /**
+     * Restore the states saved by saveButtons(), elapsedMillis after they were
+     * saved. See AceButton::restoreState(). Returns the number of buttons
+     * whose state was valid.
+     */
+    ButtonCountType restoreButtons(const ButtonCore::SavedState states[],
+        int64_t elapsedMillis = 0) {
+      ButtonCountType numRestored = 0;
+      for (ButtonCountType i = 0; i < mNumButtons; i++) {
+        if (mButtons[i].restoreState(mButtonConfig, states[i], elapsedMillis)) {
+          numRestored++;
+        }
+      }
+      return numRestored;
+    }
+
+    /**
+     * Check the state of the button at the given index, read by the caller,
+     * e.g. from a scanned key matrix or a shift register. Equivalent to
+     * AceButton::checkState().
+     */
+    void checkState(ButtonCountType i, int buttonState) {
+      mButtons[i].checkState(mButtonConfig, &mProxy, buttonState);
+    }
+
+    /**
+     * Return the earliest AceButton::getNextDeadline() of the buttons, or
+     * ButtonCore::kNoDeadline if no timer of any button is running.
+     */
+    int64_t getNextDeadline() const {
+      int64_t deadline = ButtonCore::kNoDeadline;
+      for (ButtonCountType i = 0; i < mNumButtons; i++) {
+        int64_t next = mButtons[i].getNextDeadline(mButtonConfig);
+        if (next < deadline) deadline = next;
+      }
+      return deadline;
+    }
+
+  private:
+    // Disable copy-constructor and assignment operator
+    ButtonGroup(const ButtonGroup&) = delete;
+    ButtonGroup& operator=(const ButtonGroup&) = delete;
+
+    ButtonConfig* const mButtonConfig;
+    CompactButton* const mButtons;
+    ButtonCountType const mNumButtons;
+
+    /** The AceButton given to the event handler. */
+    AceButton mProxy;
+};
+
+}
+
+#endif
@@ -0,0 +1,62 @@
+/*
+MIT License
+
+Copyright (c) 2026 Brian T. Park
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#ifndef ACE_BUTTON_BUTTON_INDEX_H
+#define ACE_BUTTON_BUTTON_INDEX_H
+
+#include <stdint.h>
+
+/**
+ * Set to 1 to use 16-bit pin numbers, ids and button counts, for test
+ * fixtures and shift-register panels with more than 256 buttons, or binary
+ * encoders with more than 8 pins. Must be defined identically for all
+ * translation units, for example with
+ * `idf_build_set_property(COMPILE_OPTIONS "-DACE_BUTTON_WIDE_INDEX=1"
+ * APPEND)`. When 0 (the default), these are 8 bits wide. The fields are
+ * arranged so that sizeof(AceButton) is the same in both cases.
+ */
+#ifndef ACE_BUTTON_WIDE_INDEX
+  #define ACE_BUTTON_WIDE_INDEX 0
+#endif
+
+namespace ace_button {
+
+#if ACE_BUTTON_WIDE_INDEX
+  /** Pin number of a button, or virtual pin of an encoded or ladder button. */
+  typedef uint16_t ButtonPinType;
+
+  /** User-defined identifier of a button, see AceButton::getId(). */
+  typedef uint16_t ButtonIdType;
+
+  /** Number of buttons or levels of an EncodedButtonConfig or ladder. */
+  typedef uint16_t ButtonCountType;
+#else
+  typedef uint8_t ButtonPinType;
+  typedef uint8_t ButtonIdType;
+  typedef uint8_t ButtonCountType;
+#endif
+
+}
+
+#endif
@@ -0,0 +1,336 @@
+/*
+MIT License
+
+Copyright (c) 2026 Brian T. Park
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#ifndef ACE_BUTTON_BUTTON_PANEL_H
+#define ACE_BUTTON_BUTTON_PANEL_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include <utility> // std::index_sequence
+#include "ButtonConfig.h"
+#include "ButtonGroup.h"
+
+/**
+ * Expands to `constinit` if the compiler supports it, so that a ButtonPanel
+ * which is not constant-initialized is a compile error.
+ */
+#if defined(__cpp_constinit)
+  #define ACE_BUTTON_CONSTINIT constinit
+#else
+  #define ACE_BUTTON_CONSTINIT
+#endif
+
+namespace ace_button {
+
+/** A button of a panel, identified by its virtual pin number and its id. */
+struct PanelButton {
+  ButtonPinType pin;
+  ButtonIdType id;
+};
+
+/**
+ * Compile-time description of the buttons of an N-to-M binary encoder, the
+ * constexpr equivalent of the parameters of EncodedButtonConfig. Create it
+ * with makeEncodedPanel(), as a constexpr variable so that it is placed in
+ * flash.
+ *
+ * @tparam T_NUM_PINS number of pins of the encoder (M)
+ * @tparam T_NUM_BUTTONS number of buttons, at most 2^M - 1
+ */
+template <uint8_t T_NUM_PINS, ButtonCountType T_NUM_BUTTONS>
+struct EncodedPanel {
+  static const ButtonCountType kNumButtons = T_NUM_BUTTONS;
+
+  /** Actual pin numbers of the encoder, bit 0 first. */
+  uint8_t pins[T_NUM_PINS];
+
+  /** Buttons, each with a virtual pin between 1 and 2^M - 1. */
+  PanelButton buttons[T_NUM_BUTTONS];
+
+  /** State of an encoder pin when no button is pressed. */
+  uint8_t defaultReleasedState;
+
+  /** The virtual pin number corresponding to "no button" pressed. */
+  static constexpr ButtonPinType getNoButtonPin() { return 0; }
+
+  /** Read the pins and return the virtual pin number. */
+  ButtonPinType readVirtualPin() const {
+    uint8_t pressedState = defaultReleasedState ^ 0x1;
+    ButtonPinType virtualPin = 0;
+    for (uint8_t i = 0; i < T_NUM_PINS; i++) {
+      int s = gpio_get_level((gpio_num_t) pins[i]);
+      virtualPin |= (s == pressedState) << i;
+    }
+    return virtualPin;
+  }
+};
+
+/**
+ * Create an EncodedPanel from arrays of pins and buttons, whose sizes are
+ * checked at compile time.
+ */
+template <uint8_t T_NUM_PINS, ButtonCountType T_NUM_BUTTONS>
+constexpr EncodedPanel<T_NUM_PINS, T_NUM_BUTTONS> makeEncodedPanel(
+    const uint8_t (&pins)[T_NUM_PINS],
+    const PanelButton (&buttons)[T_NUM_BUTTONS],
+    uint8_t defaultReleasedState = HIGH) {
+  static_assert(T_NUM_PINS <= 8 * sizeof(ButtonPinType),
+      "Too many encoder pins for ButtonPinType, see ACE_BUTTON_WIDE_INDEX");
+  static_assert(T_NUM_BUTTONS < (1UL << T_NUM_PINS),
+      "At most 2^numPins - 1 buttons");
+
+  EncodedPanel<T_NUM_PINS, T_NUM_BUTTONS> panel{};
+  for (uint8_t i = 0; i < T_NUM_PINS; i++) panel.pins[i] = pins[i];
+  for (ButtonCountType i = 0; i < T_NUM_BUTTONS; i++) {
+    panel.buttons[i] = buttons[i];
+  }
+  panel.defaultReleasedState = defaultReleasedState;
+  return panel;
+}
+
+/**
+ * Compile-time description of the buttons of a resistor ladder, the constexpr
+ * equivalent of the parameters of LadderButtonConfig. The thresholds between
+ * adjacent levels are calculated at compile time by makeLadderPanel().
+ *
+ * @tparam T_NUM_LEVELS number of voltage levels, including the level of "no
+ *         button" pressed
+ * @tparam T_NUM_BUTTONS number of buttons, less than T_NUM_LEVELS
+ */
+template <ButtonCountType T_NUM_LEVELS, ButtonCountType T_NUM_BUTTONS>
+struct LadderPanel {
+  static const ButtonCountType kNumButtons = T_NUM_BUTTONS;
+
+  /** The analog pin of the ladder. */
+  uint8_t pin;
+
+  /** The midpoints between adjacent levels of the ADC. */
+  uint16_t thresholds[T_NUM_LEVELS - 1];
+
+  /** Buttons, each with a virtual pin between 0 and (numLevels - 2). */
+  PanelButton buttons[T_NUM_BUTTONS];
+
+  /** State of a virtual pin when its button is not pressed. */
+  uint8_t defaultReleasedState;
+
+  /** The virtual pin number corresponding to "no button" pressed. */
+  static constexpr ButtonPinType getNoButtonPin() { return T_NUM_LEVELS - 1; }
+
+  /** Read the ADC and return the virtual pin number. */
+  ButtonPinType readVirtualPin() const {
+    uint16_t level = gpio_get_level((gpio_num_t) pin);
+    return extractIndex(level);
+  }
+
+  /** Return the index of the level which matches the given ADC level. */
+  ButtonPinType extractIndex(uint16_t level) const {
+    ButtonCountType i;
+    for (i = 0; i < T_NUM_LEVELS - 1; i++) {
+      if (level < thresholds[i]) return i;
+    }
+    return i;
+  }
+};
+
+/**
+ * Create a LadderPanel from the ADC levels (monotonically increasing, the
+ * last one for "no button" pressed) and the buttons.
+ */
+template <ButtonCountType T_NUM_LEVELS, ButtonCountType T_NUM_BUTTONS>
+constexpr LadderPanel<T_NUM_LEVELS, T_NUM_BUTTONS> makeLadderPanel(
+    uint8_t pin,
+    const uint16_t (&levels)[T_NUM_LEVELS],
+    const PanelButton (&buttons)[T_NUM_BUTTONS],
+    uint8_t defaultReleasedState = HIGH) {
+  static_assert(T_NUM_BUTTONS < T_NUM_LEVELS,
+      "numButtons must be less than numLevels");
+
+  LadderPanel<T_NUM_LEVELS, T_NUM_BUTTONS> panel{};
+  panel.pin = pin;
+  for (ButtonCountType i = 0; i < T_NUM_LEVELS - 1; i++) {
+    // In 32 bits, so that a 16-bit ADC does not overflow.
+    panel.thresholds[i] =
+        (uint16_t) (((uint32_t) levels[i] + levels[i + 1]) / 2);
+  }
+  for (ButtonCountType i = 0; i < T_NUM_BUTTONS; i++) {
+    panel.buttons[i] = buttons[i];
+  }
+  panel.defaultReleasedState = defaultReleasedState;
+  return panel;
+}
+
+/**
+ * A ButtonConfig for a panel of buttons described at compile time by an
+ * EncodedPanel or a LadderPanel. The descriptor is a template parameter, so it
+ * stays in flash. The buttons are CompactButton instances owned by the panel,
+ * and the constructor is constexpr, so a static ButtonPanel is
+ * constant-initialized: no code runs at startup, and RAM holds only the
+ * configuration and the state of the buttons.
+ *
+ * @code
+ * constexpr uint8_t PINS[] = {2, 4, 5};
+ * constexpr PanelButton BUTTONS[] = {{1, 0}, {2, 1}, {3, 2}, {5, 3}, {6, 4}};
+ * constexpr auto PANEL = makeEncodedPanel(PINS, BUTTONS);
+ *
+ * ACE_BUTTON_CONSTINIT ButtonPanel<PANEL> panel;
+ *
+ * void setup() {
+ *   ...
+ *   panel.setEventHandler(handleEvent);
+ * }
+ *
+ * void loop() {
+ *   panel.checkButtons();
+ * }
+ * @endcode
+ *
+ * The event handler receives the proxy AceButton of the ButtonGroup, so use
+ * getId() or getPin() to identify the button. An event stored for later, e.g.
+ * in an EventBus, must use ButtonEvent::buttonId or ButtonEvent::pin instead.
+ *
+ * @tparam T_PANEL a constexpr EncodedPanel or LadderPanel
+ */
+template <const auto& T_PANEL>
+class ButtonPanel: public ButtonConfig {
+  public:
+    /** Number of buttons of the panel. */
+    static const ButtonCountType kNumButtons = T_PANEL.kNumButtons;
+
+    /** Constructor. */
+    constexpr ButtonPanel():
+        ButtonPanel(std::make_index_sequence<kNumButtons>()) {}
+
+    /**
+     * Return state of the button corresponding to the virtual 'pin' number.
+     * This method is not expected to be used. Use checkButtons() instead.
+     */
+    int readButton(ButtonPinType pin) override {
+      uint8_t pressedState = T_PANEL.defaultReleasedState ^ 0x1;
+      return (getVirtualPin() == pin) ? pressedState : (pressedState ^ 0x1);
+    }
+
+    /**
+     * Read the virtual pin once, then check the state of each button, like
+     * EncodedButtonConfig::checkButtons().
+     */
+    void checkButtons() {
+    #if ACE_BUTTON_ENABLE_CHECK_TIMING
+      uint32_t startCycles = readCycleCounter();
+    #endif
+      ButtonPinType virtualPin = getVirtualPin();
+      uint8_t pressedState = T_PANEL.defaultReleasedState ^ 0x1;
+      for (ButtonCountType i = 0; i < kNumButtons; i++) {
+        uint8_t buttonState = (T_PANEL.buttons[i].pin == virtualPin)
+            ? pressedState : (pressedState ^ 0x1);
+        mGroup.checkState(i, buttonState);
+      }
+    #if ACE_BUTTON_ENABLE_CHECK_TIMING
+      getCheckButtonsTimes().record(readCycleCounter() - startCycles);
+    #endif
+    }
+
+    /**
+     * Prime the buttons with the virtual pin seen by the majority of
+     * numSamples reads (at most 15), like EncodedButtonConfig::primeButtons().
+     * Returns the number of pressed buttons.
+     */
+    ButtonCountType primeButtons(uint8_t numSamples = 1) {
+      if (numSamples == 0) numSamples = 1;
+      if (numSamples > kMaxPrimeSamples) numSamples = kMaxPrimeSamples;
+      ButtonPinType samples[kMaxPrimeSamples];
+      for (uint8_t i = 0; i < numSamples; i++) samples[i] = getVirtualPin();
+
+      ButtonPinType virtualPin = getNoButtonPin();
+      for (uint8_t i = 0; i < numSamples; i++) {
+        uint8_t votes = 0;
+        for (uint8_t j = 0; j < numSamples; j++) {
+          if (samples[j] == samples[i]) votes++;
+        }
+        if (votes > numSamples - votes) {
+          virtualPin = samples[i];
+          break;
+        }
+      }
+
+      uint8_t pressedState = T_PANEL.defaultReleasedState ^ 0x1;
+      ButtonCountType numPressed = 0;
+      for (ButtonCountType i = 0; i < kNumButtons; i++) {
+        bool isPressed = (T_PANEL.buttons[i].pin == virtualPin);
+        mButtons[i].primeState(isPressed ? pressedState : (pressedState ^ 0x1));
+        if (isPressed) numPressed++;
+      }
+      return numPressed;
+    }
+
+    /** Save the state of the buttons, see ButtonGroup::saveButtons(). */
+    void saveButtons(ButtonCore::SavedState states[kNumButtons]) const {
+      mGroup.saveButtons(states);
+    }
+
+    /** Restore the state of the buttons, see ButtonGroup::restoreButtons(). */
+    ButtonCountType restoreButtons(
+        const ButtonCore::SavedState states[kNumButtons],
+        int64_t elapsedMillis = 0) {
+      return mGroup.restoreButtons(states, elapsedMillis);
+    }
+
+    /** Return the button at the given index. */
+    CompactButton& getButton(ButtonCountType i) { return mButtons[i]; }
+
+    /** Return the proxy AceButton, see ButtonGroup::getProxy(). */
+    AceButton* getProxy() { return mGroup.getProxy(); }
+
+    /** Return the earliest deadline of the buttons, see ButtonGroup. */
+    int64_t getNextDeadline() const { return mGroup.getNextDeadline(); }
+
+    /** The virtual button pin number corresponding to "no button" pressed. */
+    ButtonPinType getNoButtonPin() const { return T_PANEL.getNoButtonPin(); }
+
+  protected:
+    /** Return the virtual pin number of the pressed button, if any. */
+    virtual ButtonPinType getVirtualPin() const {
+      return T_PANEL.readVirtualPin();
+    }
+
+  private:
+    /** Maximum number of samples of primeButtons(). */
+    static const uint8_t kMaxPrimeSamples = 15;
+
+    template <size_t... I>
+    constexpr explicit ButtonPanel(std::index_sequence<I...>):
+        mButtons{CompactButton(T_PANEL.buttons[I].pin,
+            T_PANEL.defaultReleasedState, T_PANEL.buttons[I].id)...},
+        mGroup(this, mButtons, kNumButtons) {}
+
+    // Disable copy-constructor and assignment operator
+    ButtonPanel(const ButtonPanel&) = delete;
+    ButtonPanel& operator=(const ButtonPanel&) = delete;
+
+    CompactButton mButtons[kNumButtons];
+    ButtonGroup mGroup;
+};
+
+}
+
+#endif
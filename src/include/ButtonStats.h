@@ -0,0 +1,153 @@
+/*
+MIT License
+
+Copyright (c) 2026 Brian T. Park
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#ifndef ACE_BUTTON_BUTTON_STATS_H
+#define ACE_BUTTON_BUTTON_STATS_H
+
+#include <stdint.h>
+#include <atomic>
+
+/**
+ * Set to 1 to collect the ButtonStats counters of each ButtonConfig. Must be
+ * defined identically for all translation units, for example with
+ * `idf_build_set_property(COMPILE_OPTIONS "-DACE_BUTTON_ENABLE_STATS=1"
+ * APPEND)`. When 0 (the default), the counters use no RAM and no CPU.
+ */
+#ifndef ACE_BUTTON_ENABLE_STATS
+  #define ACE_BUTTON_ENABLE_STATS 0
+#endif
+
+namespace ace_button {
+
+/**
+ * Instrumentation counters of the buttons attached to a ButtonConfig, since
+ * the last reset. Useful to find worn switches (many rejected bounces) and
+ * slow event handlers (a large maxCheckMicros) in the field.
+ */
+struct ButtonStats {
+  /** Number of AceButton::checkState() calls. */
+  uint32_t numChecks;
+
+  /** Number of state changes which started a debouncing period. */
+  uint32_t numEdges;
+
+  /**
+   * Number of debouncing periods which ended with the button back in its
+   * previous state, i.e. edges rejected as bounces or noise.
+   */
+  uint32_t numEdgesRejected;
+
+  /** Number of events dispatched, indexed by AceButton::kEventXxx. */
+  uint32_t numEvents[8];
+
+  /**
+   * Number of Clicked events, postponed by
+   * ButtonConfig::kFeatureSuppressClickBeforeDoubleClick, which were
+   * cancelled by a DoubleClicked.
+   */
+  uint32_t numPostponedClicksCancelled;
+
+  /** Maximum duration of AceButton::checkState(), in microseconds. */
+  uint32_t maxCheckMicros;
+};
+
+/**
+ * Owner of the ButtonStats of a ButtonConfig. The counters are updated with
+ * plain increments by the single task which checks the buttons of the
+ * ButtonConfig, between beginUpdate() and endUpdate(). Any other task can read
+ * a consistent copy with read(), which is protected by a sequence lock.
+ */
+class ButtonStatsRecorder {
+  public:
+    constexpr ButtonStatsRecorder():
+        mSequence(0),
+        mResetRequested(false),
+        mStats() {}
+
+    /** Start a batch of updates. Scan task only. */
+    void beginUpdate() {
+      mSequence.store(mSequence.load(std::memory_order_relaxed) + 1,
+          std::memory_order_relaxed);
+      std::atomic_thread_fence(std::memory_order_release);
+
+      // Cleared inside the update, so that read() never copies a half
+      // cleared snapshot.
+      if (mResetRequested.load(std::memory_order_relaxed)) {
+        mResetRequested.store(false, std::memory_order_relaxed);
+        clear();
+      }
+    }
+
+    /** Finish a batch of updates. Scan task only. */
+    void endUpdate() {
+      mSequence.store(mSequence.load(std::memory_order_relaxed) + 1,
+          std::memory_order_release);
+    }
+
+    /** Return the counters to update. Scan task only. */
+    ButtonStats& stats() { return mStats; }
+
+    /**
+     * Copy a consistent snapshot of the counters into stats. Returns false if
+     * the scan task kept updating the counters during maxAttempts attempts,
+     * which can happen if the calling task preempted the scan task in the
+     * middle of an update. Safe to call from any task.
+     */
+    bool read(ButtonStats& stats, uint8_t maxAttempts = 8) const {
+      for (uint8_t i = 0; i < maxAttempts; i++) {
+        uint32_t sequence = mSequence.load(std::memory_order_acquire);
+        if (sequence & 1) continue;
+        stats = mStats;
+        std::atomic_thread_fence(std::memory_order_acquire);
+        if (sequence == mSequence.load(std::memory_order_relaxed)) return true;
+      }
+      return false;
+    }
+
+    /**
+     * Ask the scan task to clear the counters at its next update. Safe to call
+     * from any task.
+     */
+    void requestReset() {
+      mResetRequested.store(true, std::memory_order_relaxed);
+    }
+
+  private:
+    // Disable copy-constructor and assignment operator
+    ButtonStatsRecorder(const ButtonStatsRecorder&) = delete;
+    ButtonStatsRecorder& operator=(const ButtonStatsRecorder&) = delete;
+
+    void clear() {
+      mStats = ButtonStats();
+    }
+
+    /** Odd while the scan task is updating mStats. */
+    std::atomic<uint32_t> mSequence;
+    std::atomic<bool> mResetRequested;
+    ButtonStats mStats;
+};
+
+}
+
+#endif
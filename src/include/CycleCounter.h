@@ -0,0 +1,67 @@
+/*
+MIT License
+
+Copyright (c) 2026 Brian T. Park
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#ifndef ACE_BUTTON_CYCLE_COUNTER_H
+#define ACE_BUTTON_CYCLE_COUNTER_H
+
+#include <stdint.h>
+
+#if defined(ESP_PLATFORM)
+  #include "esp_cpu.h"
+#elif defined(__x86_64__) || defined(__i386__)
+  #include <x86intrin.h>
+#else
+  #include <time.h>
+#endif
+
+namespace ace_button {
+
+/**
+ * Return a free-running counter with the finest resolution available, for
+ * measuring short durations as the unsigned difference of two readings:
+ *
+ *   * ESP-IDF: the CPU cycle counter, esp_cpu_get_cycle_count()
+ *   * x86 host: the time stamp counter, rdtsc
+ *   * other hosts: the nanoseconds of clock_gettime(CLOCK_MONOTONIC)
+ *
+ * The counter is truncated to 32 bits, so it wraps around after a few seconds
+ * on the host, but the difference is valid for any duration shorter than that.
+ * The readings of different cores are not comparable, so the two readings of a
+ * measurement must be taken on the same core.
+ */
+inline uint32_t readCycleCounter() {
+#if defined(ESP_PLATFORM)
+  return (uint32_t) esp_cpu_get_cycle_count();
+#elif defined(__x86_64__) || defined(__i386__)
+  return (uint32_t) __rdtsc();
+#else
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return (uint32_t) ((uint64_t) ts.tv_sec * 1000000000 + ts.tv_nsec);
+#endif
+}
+
+}
+
+#endif
@@ -78,7 +78,7 @@ class Encoded8To3ButtonConfig : public ButtonConfig {
      * states of the actual pins. LOW means that the corresponding encoded
      * virtual pin was pushed.
      */
-    int readButton(uint8_t pin) override {
+    int readButton(ButtonPinType pin) override {
       int s0 = gpio_get_level((gpio_num_t)mPin0);
       int s1 = gpio_get_level((gpio_num_t)mPin1);
       int s2 = gpio_get_level((gpio_num_t)mPin2);
@@ -26,6 +26,7 @@ SOFTWARE.
 #define ACE_BUTTON_ENCODED_BUTTON_CONFIG_H
 
 #include "ButtonConfig.h"
+#include "ButtonCore.h" // ButtonCore::SavedState
 
 namespace ace_button {
 
@@ -90,9 +91,28 @@ class EncodedButtonConfig : public ButtonConfig {
      *        wiring, so this should be set HIGH. The default value is HIGH.
      */
     EncodedButtonConfig(uint8_t numPins, const uint8_t pins[],
-        uint8_t numButtons, AceButton* const buttons[],
+        ButtonCountType numButtons, AceButton* const buttons[],
         uint8_t defaultReleasedState = HIGH);
 
+    /**
+     * Constructor which takes a contiguous array of buttons, e.g. the data()
+     * of a ButtonArray, instead of an array of pointers. See setButtons().
+     */
+    EncodedButtonConfig(uint8_t numPins, const uint8_t pins[],
+        ButtonCountType numButtons, AceButton buttons[],
+        uint8_t defaultReleasedState = HIGH);
+
+    /**
+     * Replace the buttons with a contiguous array of buttons, and attach them
+     * to this ButtonConfig. This allows the buttons to be created at runtime,
+     * for example in a ButtonArray filled from a board description. The array
+     * must not be modified while checkButtons() is running. The number of
+     * buttons and the pointer are cached, so this must be called again after
+     * every change to the array; ButtonArray::attach() does that
+     * automatically.
+     */
+    void setButtons(ButtonCountType numButtons, AceButton buttons[]);
+
     /**
      * Return state of the virtual (i.e. encoded) 'pin' number, corresponding to
      * the pull-down states of the actual pins. LOW means that the corresponding
@@ -101,7 +121,7 @@ class EncodedButtonConfig : public ButtonConfig {
      * This method is not expected to be used. Use the checkButtons() method
      * instead for this class.
      */
-    int readButton(uint8_t pin) override;
+    int readButton(ButtonPinType pin) override;
 
     /**
      * Read the pins once, obtain the virtual pin number, then call each
@@ -111,8 +131,32 @@ class EncodedButtonConfig : public ButtonConfig {
      */
     void checkButtons() const;
 
+    /**
+     * Read the virtual pin numSamples times (at most 15), then prime each
+     * button with the state given by the virtual pin seen by the majority of
+     * the samples (or getNoButtonPin() if there is no majority), see
+     * AceButton::prime(). Call it in setup() so that checkButtons() starts
+     * from the known states, without the initial debouncing period. Returns
+     * the number of pressed buttons.
+     */
+    ButtonCountType primeButtons(uint8_t numSamples = 1);
+
+    /**
+     * Save the state of the buttons into the states array, which must hold
+     * as many elements as there are buttons. See AceButton::saveState().
+     */
+    void saveButtons(ButtonCore::SavedState states[]) const;
+
+    /**
+     * Restore the states saved by saveButtons(), elapsedMillis after they were
+     * saved. See AceButton::restoreState(). Returns the number of buttons
+     * whose state was valid.
+     */
+    ButtonCountType restoreButtons(const ButtonCore::SavedState states[],
+        int64_t elapsedMillis = 0);
+
     /** The virtual button pin number corresponding to "no button" pressed. */
-    uint8_t getNoButtonPin() const {
+    ButtonPinType getNoButtonPin() const {
       return 0;
     }
 
@@ -122,9 +166,18 @@ class EncodedButtonConfig : public ButtonConfig {
      * of the actual pins. Returns a number between 1 and (2^{numPins} - 1). 0
      * means "no button" pressed.
      */
-    virtual uint8_t getVirtualPin() const;
+    virtual ButtonPinType getVirtualPin() const;
+
+    /**
+     * Return the virtual pin seen by the majority of numSamples calls to
+     * getVirtualPin(), or getNoButtonPin() if there is no majority.
+     */
+    ButtonPinType sampleVirtualPin(uint8_t numSamples) const;
 
   private:
+    /** Maximum number of samples of sampleVirtualPin(). */
+    static const uint8_t kMaxPrimeSamples = 15;
+
     // Disable copy-constructor and assignment operator
     EncodedButtonConfig(const EncodedButtonConfig&) = delete;
     EncodedButtonConfig& operator=(const EncodedButtonConfig&) = delete;
@@ -132,10 +185,15 @@ class EncodedButtonConfig : public ButtonConfig {
   private:
     // Arranged for efficient packing on 32-bit processors
     uint8_t const mNumPins;
-    uint8_t const mNumButtons;
     uint8_t const mPressedState;
+    ButtonCountType mNumButtons;
     const uint8_t* const mPins;
-    AceButton* const* const mButtons;
+
+    /** Array of pointers to the buttons, or nullptr if mButtonArray is used. */
+    AceButton* const* mButtons;
+
+    /** Contiguous array of buttons, or nullptr if mButtons is used. */
+    AceButton* mButtonArray;
 };
 
 }
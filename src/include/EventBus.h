@@ -0,0 +1,219 @@
+/*
+MIT License
+
+Copyright (c) 2026 Brian T. Park
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#ifndef ACE_BUTTON_EVENT_BUS_H
+#define ACE_BUTTON_EVENT_BUS_H
+
+#include <stdint.h>
+#include <atomic>
+#include "ButtonConfig.h"
+#include "ButtonEvent.h"
+#include "EventCoalescer.h"
+#include "RingBuffer.h"
+
+namespace ace_button {
+
+/**
+ * A lock-free multi-producer single-consumer event bus which merges the events
+ * of several ButtonConfig instances, possibly scanned from different tasks at
+ * different rates, into a single stream ordered by ButtonEvent::eventTime.
+ *
+ * Each producer owns a lane, which is a single-producer single-consumer
+ * RingBuffer, so producers never contend with each other and never block. The
+ * consumer merges the lanes by always taking the oldest event at the front of
+ * all lanes. When a lane is full, the new event is dropped and counted in the
+ * drop count of that lane. If T_COALESCE_SLOTS is greater than 0, the
+ * kEventRepeatPressed and kEventHeartBeat events are merged by an
+ * EventCoalescer while the consumer is behind, the other events are queued
+ * behind them, and the producer should call Lane::flush() after each scan of
+ * its buttons.
+ *
+ * The merged stream is ordered among the events which are already in the bus.
+ * An event published late by a slow producer may still carry an older
+ * timestamp than an event already consumed. If strict ordering is required,
+ * use pop(event, horizon) with a horizon which lags the current time by more
+ * than the longest scan interval of the producers.
+ *
+ * @code
+ * EventBus<2, 16> bus;
+ *
+ * void setup() {
+ *   bus.attach(&gpioButtonConfig, 0); // scanned by task A
+ *   bus.attach(&ladderButtonConfig, 1); // scanned by task B
+ * }
+ *
+ * void consumerTask() {
+ *   ButtonEvent event;
+ *   while (bus.pop(event)) {
+ *     ...
+ *   }
+ * }
+ * @endcode
+ *
+ * @tparam T_NUM_PRODUCERS number of lanes
+ * @tparam T_LANE_CAPACITY capacity of each lane, must be a power of 2
+ * @tparam T_COALESCE_SLOTS number of records of the EventCoalescer of each
+ *    lane, 0 to disable coalescing
+ */
+template <uint8_t T_NUM_PRODUCERS, uint32_t T_LANE_CAPACITY,
+    uint8_t T_COALESCE_SLOTS = 0>
+class EventBus {
+  public:
+    /**
+     * The lane of a single producer. Its handleEvent() is installed as the
+     * EventDelegate of the ButtonConfig which publishes into the lane.
+     */
+    class Lane {
+      public:
+        Lane():
+            mSource(0),
+            mDropCount(0) {}
+
+        /** Publish the event into the lane. Producer only. */
+        void handleEvent(AceButton* button, uint8_t eventType,
+            uint8_t buttonState, int64_t eventTime, int64_t duration) {
+          ButtonEvent event;
+          event.eventTime = eventTime;
+          event.button = button;
+          event.buttonId = button->getId();
+          event.pin = button->getPin();
+          event.duration = (int32_t) duration;
+          event.eventType = eventType;
+          event.buttonState = buttonState;
+          event.source = mSource;
+          event.count = 1;
+          publish(event);
+        }
+
+        /** Publish the given event into the lane. Producer only. */
+        void publish(const ButtonEvent& event) {
+          if (! mCoalescer.publish(mRing, event)) {
+            mDropCount.store(
+                mDropCount.load(std::memory_order_relaxed) + 1,
+                std::memory_order_relaxed);
+          }
+        }
+
+        /**
+         * Move the events held by the EventCoalescer into the lane if it has
+         * room. Producer only.
+         */
+        void flush() { mCoalescer.flush(mRing); }
+
+        /** Number of events dropped because the lane was full. */
+        uint32_t getDropCount() const {
+          return mDropCount.load(std::memory_order_relaxed);
+        }
+
+      private:
+        friend class EventBus;
+
+        // Disable copy-constructor and assignment operator
+        Lane(const Lane&) = delete;
+        Lane& operator=(const Lane&) = delete;
+
+        RingBuffer<ButtonEvent, T_LANE_CAPACITY> mRing;
+        EventCoalescer<T_COALESCE_SLOTS> mCoalescer;
+        uint8_t mSource;
+        std::atomic<uint32_t> mDropCount;
+    };
+
+    EventBus() {
+      for (uint8_t i = 0; i < T_NUM_PRODUCERS; i++) {
+        mLanes[i].mSource = i;
+      }
+    }
+
+    /**
+     * Install the given lane as the event handler of the ButtonConfig. Each
+     * lane must be used by a single task. Several ButtonConfig instances
+     * which are scanned by the same task may share a lane.
+     */
+    void attach(ButtonConfig* buttonConfig, uint8_t producer) {
+      buttonConfig->setEventDelegate(
+          EventDelegate::fromMethod2<Lane, &Lane::handleEvent>(
+              &mLanes[producer]));
+    }
+
+    /** Return the lane of the given producer, to publish events directly. */
+    Lane& getLane(uint8_t producer) { return mLanes[producer]; }
+
+    /**
+     * Remove the oldest event at the front of all lanes and copy it into
+     * event. Returns false if the bus is empty. Consumer only.
+     */
+    bool pop(ButtonEvent& event) {
+      Lane* lane = oldestLane();
+      if (lane == nullptr) return false;
+      return lane->mRing.pop(event);
+    }
+
+    /**
+     * Same as pop(event), but only returns an event whose eventTime is
+     * less than or equal to horizon. Consumer only.
+     */
+    bool pop(ButtonEvent& event, int64_t horizon) {
+      Lane* lane = oldestLane();
+      if (lane == nullptr) return false;
+      if (lane->mRing.front()->eventTime > horizon) return false;
+      return lane->mRing.pop(event);
+    }
+
+    /** Number of events dropped by the given producer. */
+    uint32_t getDropCount(uint8_t producer) const {
+      return mLanes[producer].getDropCount();
+    }
+
+    /** Number of producers. */
+    static uint8_t getNumProducers() { return T_NUM_PRODUCERS; }
+
+  private:
+    // Disable copy-constructor and assignment operator
+    EventBus(const EventBus&) = delete;
+    EventBus& operator=(const EventBus&) = delete;
+
+    /**
+     * Return the lane whose front event is the oldest, or nullptr if all lanes
+     * are empty. Ties are resolved in favor of the lowest producer index.
+     */
+    Lane* oldestLane() {
+      Lane* oldest = nullptr;
+      int64_t oldestTime = 0;
+      for (uint8_t i = 0; i < T_NUM_PRODUCERS; i++) {
+        const ButtonEvent* front = mLanes[i].mRing.front();
+        if (front == nullptr) continue;
+        if (oldest == nullptr || front->eventTime < oldestTime) {
+          oldest = &mLanes[i];
+          oldestTime = front->eventTime;
+        }
+      }
+      return oldest;
+    }
+
+    Lane mLanes[T_NUM_PRODUCERS];
+};
+
+}
+
+#endif
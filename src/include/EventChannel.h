@@ -0,0 +1,280 @@
+/*
+MIT License
+
+Copyright (c) 2026 Brian T. Park
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#ifndef ACE_BUTTON_EVENT_CHANNEL_H
+#define ACE_BUTTON_EVENT_CHANNEL_H
+
+#include <stdint.h>
+#include "ButtonConfig.h"
+#include "ButtonEvent.h"
+#include "RingBuffer.h"
+
+#if defined(ESP_PLATFORM)
+  #include "esp_timer.h"
+  #include "freertos/FreeRTOS.h"
+  #include "freertos/task.h"
+
+  #ifndef ACE_BUTTON_NOTIFY_INDEX
+    /**
+     * Index of the FreeRTOS direct task notification used by EventSignal.
+     * Index 0 is also used by xTaskNotifyGive() and by the FreeRTOS stream
+     * and message buffers, so the last index is used by default.
+     */
+    #define ACE_BUTTON_NOTIFY_INDEX (configTASK_NOTIFICATION_ARRAY_ENTRIES - 1)
+
+    // With a single entry, the default would silently share index 0 with
+    // xTaskNotifyGive() and ulTaskNotifyTake(), which then lose or steal
+    // each other's notifications.
+    static_assert(configTASK_NOTIFICATION_ARRAY_ENTRIES >= 2,
+        "EventChannel needs its own task notification: set "
+        "CONFIG_FREERTOS_TASK_NOTIFICATION_ARRAY_ENTRIES to 2 or more, or "
+        "define ACE_BUTTON_NOTIFY_INDEX explicitly if index 0 is not used by "
+        "anything else");
+  #endif
+#else
+  #include <chrono>
+  #include <condition_variable>
+  #include <mutex>
+#endif
+
+namespace ace_button {
+
+/**
+ * Wakes up the single consumer task of an EventChannel. On ESP-IDF, the
+ * consumer is blocked on a FreeRTOS direct task notification, which is
+ * latched by the kernel, so a notification sent between the consumer's last
+ * check of the queue and the start of its wait is not lost. On other
+ * platforms (e.g. the host used for the unit tests), a mutex and a
+ * condition variable provide the same behavior.
+ */
+class EventSignal {
+  public:
+    /** Timeout value which waits without limit. */
+    static const uint32_t kWaitForever = UINT32_MAX;
+
+#if defined(ESP_PLATFORM)
+    static_assert(
+        ACE_BUTTON_NOTIFY_INDEX < configTASK_NOTIFICATION_ARRAY_ENTRIES,
+        "ACE_BUTTON_NOTIFY_INDEX must be less than "
+        "configTASK_NOTIFICATION_ARRAY_ENTRIES");
+
+    EventSignal():
+        mWaiter(nullptr) {}
+
+    /** Monotonic clock (milliseconds) used for the timeouts. */
+    static int64_t getMillis() { return esp_timer_get_time() / 1000; }
+
+    /** Register the calling task as the consumer. Consumer only. */
+    void prepare() {
+      mWaiter = xTaskGetCurrentTaskHandle();
+    }
+
+    /**
+     * Block the consumer until notify() is called or the timeout expires.
+     * Returns false on timeout. Consumer only.
+     */
+    template <typename P>
+    bool wait(uint32_t timeoutMillis, P /*isReady*/) {
+      TickType_t ticks = (timeoutMillis == kWaitForever)
+          ? portMAX_DELAY : pdMS_TO_TICKS(timeoutMillis);
+      return ulTaskNotifyTakeIndexed(ACE_BUTTON_NOTIFY_INDEX, pdTRUE, ticks)
+          != 0;
+    }
+
+    /** Wake up the consumer, if it has been registered. Producer only. */
+    void notify() {
+      TaskHandle_t waiter = mWaiter;
+      if (waiter != nullptr) {
+        xTaskNotifyGiveIndexed(waiter, ACE_BUTTON_NOTIFY_INDEX);
+      }
+    }
+
+  private:
+    TaskHandle_t volatile mWaiter;
+#else
+    /** Nothing to register on the host. */
+    void prepare() {}
+
+    /** Monotonic clock (milliseconds) used for the timeouts. */
+    static int64_t getMillis() {
+      return std::chrono::duration_cast<std::chrono::milliseconds>(
+          std::chrono::steady_clock::now().time_since_epoch()).count();
+    }
+
+    /**
+     * Block the consumer until isReady() returns true, or the timeout expires.
+     * Returns false on timeout.
+     */
+    template <typename P>
+    bool wait(uint32_t timeoutMillis, P isReady) {
+      std::unique_lock<std::mutex> lock(mMutex);
+      if (timeoutMillis == kWaitForever) {
+        mCondition.wait(lock, isReady);
+        return true;
+      }
+      return mCondition.wait_for(
+          lock, std::chrono::milliseconds(timeoutMillis), isReady);
+    }
+
+    /** Wake up the consumer. */
+    void notify() {
+      // Taking the mutex orders this notification after the consumer's
+      // check of isReady(), so the wake up cannot be lost.
+      std::lock_guard<std::mutex> lock(mMutex);
+      mCondition.notify_one();
+    }
+
+  private:
+    std::mutex mMutex;
+    std::condition_variable mCondition;
+#endif
+};
+
+/**
+ * A queue of ButtonEvent records, attached to one or more ButtonConfig
+ * instances, from which a consumer task retrieves the events with the
+ * blocking waitForEvent() instead of an event handler callback. The consumer
+ * uses no CPU while it waits.
+ *
+ * The events are published by a single producer task (the one calling
+ * AceButton::check()) into a lock-free RingBuffer, and retrieved by a single
+ * consumer task. If the queue is full, the event is dropped and counted by
+ * getDropCount().
+ *
+ * @code
+ * EventChannel<16> channel;
+ *
+ * void setup() {
+ *   ...
+ *   channel.attach(&buttonConfig);
+ * }
+ *
+ * void consumerTask(void*) {
+ *   ButtonEvent event;
+ *   while (true) {
+ *     if (channel.waitForEvent(event, 1000)) {
+ *       ...
+ *     }
+ *   }
+ * }
+ * @endcode
+ *
+ * @tparam T_CAPACITY capacity of the queue, must be a power of 2
+ */
+template <uint32_t T_CAPACITY>
+class EventChannel {
+  public:
+    /** Timeout value of waitForEvent() which waits without limit. */
+    static const uint32_t kWaitForever = EventSignal::kWaitForever;
+
+    EventChannel():
+        mDropCount(0) {}
+
+    /** Install this channel as the event handler of the ButtonConfig. */
+    void attach(ButtonConfig* buttonConfig) {
+      buttonConfig->setEventDelegate(
+          EventDelegate::fromMethod2<EventChannel,
+              &EventChannel::handleEvent>(this));
+    }
+
+    /** Queue the event and wake up the consumer. Producer only. */
+    void handleEvent(AceButton* button, uint8_t eventType,
+        uint8_t buttonState, int64_t eventTime, int64_t duration) {
+      ButtonEvent event;
+      event.eventTime = eventTime;
+      event.button = button;
+      event.buttonId = button->getId();
+      event.pin = button->getPin();
+      event.duration = (int32_t) duration;
+      event.eventType = eventType;
+      event.buttonState = buttonState;
+      event.source = 0;
+      event.count = 1;
+      publish(event);
+    }
+
+    /** Queue the given event and wake up the consumer. Producer only. */
+    void publish(const ButtonEvent& event) {
+      if (! mRing.push(event)) {
+        mDropCount.store(
+            mDropCount.load(std::memory_order_relaxed) + 1,
+            std::memory_order_relaxed);
+        return;
+      }
+      mSignal.notify();
+    }
+
+    /**
+     * Remove the next event and copy it into event, blocking the calling task
+     * for up to timeoutMillis milliseconds until an event arrives. Returns
+     * false if the timeout expired. A timeout of 0 polls the queue without
+     * blocking. Consumer only.
+     *
+     * The timeout is measured from the call, so a stale wake up (e.g. a
+     * notification for an event already removed by pop()) only waits for the
+     * remaining time.
+     */
+    bool waitForEvent(ButtonEvent& event, uint32_t timeoutMillis) {
+      mSignal.prepare();
+      int64_t deadline = (timeoutMillis == kWaitForever)
+          ? 0 : EventSignal::getMillis() + timeoutMillis;
+      while (! mRing.pop(event)) {
+        uint32_t remaining = kWaitForever;
+        if (timeoutMillis != kWaitForever) {
+          int64_t now = EventSignal::getMillis();
+          if (now >= deadline) return false;
+          remaining = (uint32_t) (deadline - now);
+        }
+        if (! mSignal.wait(remaining, [this]() {
+            return ! mRing.isEmpty(); })) {
+          return mRing.pop(event);
+        }
+      }
+      return true;
+    }
+
+    /**
+     * Remove the next event without blocking. Returns false if the queue is
+     * empty. Consumer only.
+     */
+    bool pop(ButtonEvent& event) { return mRing.pop(event); }
+
+    /** Number of events dropped because the queue was full. */
+    uint32_t getDropCount() const {
+      return mDropCount.load(std::memory_order_relaxed);
+    }
+
+  private:
+    // Disable copy-constructor and assignment operator
+    EventChannel(const EventChannel&) = delete;
+    EventChannel& operator=(const EventChannel&) = delete;
+
+    RingBuffer<ButtonEvent, T_CAPACITY> mRing;
+    EventSignal mSignal;
+    std::atomic<uint32_t> mDropCount;
+};
+
+}
+
+#endif
@@ -0,0 +1,185 @@
+/*
+MIT License
+
+Copyright (c) 2026 Brian T. Park
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#ifndef ACE_BUTTON_EVENT_COALESCER_H
+#define ACE_BUTTON_EVENT_COALESCER_H
+
+#include <stdint.h>
+#include "AceButton.h"
+#include "ButtonEvent.h"
+
+namespace ace_button {
+
+/**
+ * Producer-side staging area which coalesces kEventRepeatPressed and
+ * kEventHeartBeat events while the consumer of a queue is behind. Consecutive
+ * events of the same type for the same button are merged into a single
+ * ButtonEvent whose count is incremented and whose eventTime is that of the
+ * latest event, so the consumer catches up with a held button in one step
+ * instead of processing every RepeatPressed.
+ *
+ * A coalescable event is pushed directly only if the ring is empty.
+ * Otherwise it is held in the staging area, where the following events of the
+ * same type for the same button are merged into it. The records in the ring
+ * itself are never modified, because the consumer may be reading them. The
+ * held records are moved into the ring once the consumer has emptied it, on
+ * the next publish() or flush().
+ *
+ * The staging area is a FIFO of T_SLOTS records. Any other event (e.g.
+ * kEventPressed or kEventReleased) which arrives while records are staged is
+ * queued behind them, and all the records ahead of it are then moved into the
+ * ring as soon as it has room, so that it is delivered without waiting for
+ * the consumer to empty the ring. The order of the events of a given button is
+ * therefore preserved. Events of different buttons may be reordered relative
+ * to each other by a merge. If the FIFO is full, the held records are moved
+ * into the ring early to make room. An event is dropped only if it cannot be
+ * merged and neither the ring nor the FIFO has room, and publish() then
+ * returns false so that the caller can count it.
+ *
+ * All methods must be called from the producer.
+ *
+ * @tparam T_SLOTS number of records which can be staged
+ */
+template <uint8_t T_SLOTS>
+class EventCoalescer {
+  public:
+    EventCoalescer():
+        mNumStaged(0) {}
+
+    /** Return true if events of the given type may be coalesced. */
+    static bool isCoalescable(uint8_t eventType) {
+      return eventType == AceButton::kEventRepeatPressed
+          || eventType == AceButton::kEventHeartBeat;
+    }
+
+    /**
+     * Push the event into the ring, or merge or queue it in the staging area.
+     * Returns false if the event had to be dropped.
+     */
+    template <typename R>
+    bool publish(R& ring, const ButtonEvent& event) {
+      flush(ring);
+      if (mNumStaged == 0
+          && (! isCoalescable(event.eventType) || ring.isEmpty())
+          && ring.push(event)) {
+        return true;
+      }
+      // If the staging area is full, make room by moving the held records
+      // into the ring early.
+      if (! stage(event)) {
+        moveToRing(ring, mNumStaged);
+        if (! stage(event)) return false;
+      }
+      flush(ring);
+      return true;
+    }
+
+    /**
+     * Move the staged records into the ring, in order, while it has room. The
+     * coalescable records after the last other event are kept back until the
+     * ring is empty, so that they can still be merged.
+     */
+    template <typename R>
+    void flush(R& ring) {
+      if (mNumStaged == 0) return;
+
+      // Number of records up to and including the last non-coalescable one.
+      uint8_t numUrgent = mNumStaged;
+      while (numUrgent > 0 && isCoalescable(mStaged[numUrgent - 1].eventType)) {
+        numUrgent--;
+      }
+      moveToRing(ring, ring.isEmpty() ? mNumStaged : numUrgent);
+    }
+
+    /** Number of records in the staging area. */
+    uint8_t getNumStaged() const { return mNumStaged; }
+
+  private:
+    /** Move up to limit staged records into the ring, in order. */
+    template <typename R>
+    void moveToRing(R& ring, uint8_t limit) {
+      uint8_t flushed = 0;
+      while (flushed < limit && ring.push(mStaged[flushed])) {
+        flushed++;
+      }
+      if (flushed == 0) return;
+      for (uint8_t i = flushed; i < mNumStaged; i++) {
+        mStaged[i - flushed] = mStaged[i];
+      }
+      mNumStaged -= flushed;
+    }
+
+    /**
+     * Merge the event into the newest staged record of the same button, or
+     * append it to the staging area. Returns false if it is full.
+     */
+    bool stage(const ButtonEvent& event) {
+      if (isCoalescable(event.eventType)) {
+        for (uint8_t i = mNumStaged; i > 0; i--) {
+          ButtonEvent& staged = mStaged[i - 1];
+          // The buttons of a ButtonGroup share the same proxy pointer, so the
+          // id and pin are also compared.
+          if (staged.button != event.button
+              || staged.buttonId != event.buttonId
+              || staged.pin != event.pin) {
+            continue;
+          }
+          if (staged.eventType != event.eventType) break;
+          if (staged.count < UINT16_MAX) staged.count++;
+          staged.eventTime = event.eventTime;
+          staged.buttonState = event.buttonState;
+          return true;
+        }
+      }
+      if (mNumStaged >= T_SLOTS) return false;
+      mStaged[mNumStaged++] = event;
+      return true;
+    }
+
+    ButtonEvent mStaged[T_SLOTS];
+    uint8_t mNumStaged;
+};
+
+/**
+ * No coalescing: events are pushed directly and dropped if the ring is full.
+ */
+template <>
+class EventCoalescer<0> {
+  public:
+    static bool isCoalescable(uint8_t /*eventType*/) { return false; }
+
+    template <typename R>
+    bool publish(R& ring, const ButtonEvent& event) {
+      return ring.push(event);
+    }
+
+    template <typename R>
+    void flush(R& /*ring*/) {}
+
+    uint8_t getNumStaged() const { return 0; }
+};
+
+}
+
+#endif
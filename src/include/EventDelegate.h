@@ -0,0 +1,274 @@
+/*
+MIT License
+
+Copyright (c) 2026 Brian T. Park
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#ifndef ACE_BUTTON_EVENT_DELEGATE_H
+#define ACE_BUTTON_EVENT_DELEGATE_H
+
+#include <stdint.h>
+#include "IEventHandler.h"
+#include "IEventHandler2.h"
+
+namespace ace_button {
+
+class AceButton;
+
+/**
+ * A type-erased reference to an event handler, which is invoked through a
+ * single indirect call. The delegate holds an opaque object pointer and a
+ * pointer to a stub function which knows how to turn that object pointer back
+ * into the original callable. The stub functions are generated at compile time
+ * by the various from*() factory methods, so binding a free function, an
+ * IEventHandler, a member function or a lambda never allocates on the heap.
+ *
+ * A function pointer bound at runtime by fromFunction(function), e.g. by
+ * ButtonConfig::setEventHandler(), is called by its stub, which costs a second
+ * call. A function known at compile time can be bound with fromFunction<FUNC>()
+ * instead, whose stub calls it directly, so that the whole dispatch is a single
+ * indirect call.
+ *
+ * A default constructed EventDelegate is bound to an empty stub, so it can
+ * always be called without checking for nullptr first.
+ *
+ * The delegate does not own the object that it refers to. The IEventHandler,
+ * the object of a member function, or the lambda must outlive the delegate.
+ *
+ * @code
+ * class Handler {
+ *   public:
+ *     void onEvent(AceButton* button, uint8_t eventType, uint8_t buttonState);
+ * };
+ * Handler handler;
+ *
+ * auto lambda = [&](AceButton* b, uint8_t eventType, uint8_t buttonState) {
+ *   ...
+ * };
+ *
+ * void setup() {
+ *   config.setEventDelegate(
+ *       EventDelegate::fromMethod<Handler, &Handler::onEvent>(&handler));
+ *   // or
+ *   config.setEventDelegate(EventDelegate::fromCallable(&lambda));
+ * }
+ * @endcode
+ */
+class EventDelegate {
+  public:
+    /** Signature of the EventHandler function (ButtonConfig::EventHandler). */
+    typedef void (*Function)(AceButton* button, uint8_t eventType,
+        uint8_t buttonState);
+
+    /** Signature of the event handler function with timing information. */
+    typedef void (*Function2)(AceButton* button, uint8_t eventType,
+        uint8_t buttonState, int64_t eventTime, int64_t duration);
+
+    /** Signature of the stub which restores the type of the object. */
+    typedef void (*Stub)(void* object, AceButton* button, uint8_t eventType,
+        uint8_t buttonState, int64_t eventTime, int64_t duration);
+
+    /** Create a delegate which does nothing. */
+    constexpr EventDelegate():
+        mObject(nullptr),
+        mStub(&nullStub) {}
+
+    /** Bind to a free function with the EventHandler signature. */
+    static EventDelegate fromFunction(Function function) {
+      return function
+          ? EventDelegate(reinterpret_cast<void*>(function), &functionStub)
+          : EventDelegate();
+    }
+
+    /**
+     * Bind to the free function FUNC with the EventHandler signature, known
+     * at compile time. The stub is generated for FUNC and calls it directly.
+     */
+    template <void (*FUNC)(AceButton*, uint8_t, uint8_t)>
+    static EventDelegate fromFunction() {
+      return EventDelegate(nullptr, &staticFunctionStub<FUNC>);
+    }
+
+    /** Bind to a free function which accepts the timing information. */
+    static EventDelegate fromFunction2(Function2 function) {
+      return function
+          ? EventDelegate(reinterpret_cast<void*>(function), &function2Stub)
+          : EventDelegate();
+    }
+
+    /** Bind to an IEventHandler object. */
+    static EventDelegate fromHandler(IEventHandler* handler) {
+      return handler
+          ? EventDelegate(handler, &handlerStub)
+          : EventDelegate();
+    }
+
+    /** Bind to an IEventHandler2 object. */
+    static EventDelegate fromHandler(IEventHandler2* handler) {
+      return handler
+          ? EventDelegate(handler, &handler2Stub)
+          : EventDelegate();
+    }
+
+    /**
+     * Bind to the member function M of the given object. The member function
+     * has the EventHandler signature. The stub calls M directly, so a
+     * non-virtual M costs a single indirect call. A virtual M is still
+     * dispatched through the vtable of the object.
+     */
+    template <typename T,
+        void (T::*M)(AceButton*, uint8_t, uint8_t)>
+    static EventDelegate fromMethod(T* object) {
+      return EventDelegate(object, &methodStub<T, M>);
+    }
+
+    /** Bind to a member function which accepts the timing information. */
+    template <typename T,
+        void (T::*M)(AceButton*, uint8_t, uint8_t, int64_t, int64_t)>
+    static EventDelegate fromMethod2(T* object) {
+      return EventDelegate(object, &method2Stub<T, M>);
+    }
+
+    /**
+     * Bind to a callable object, such as a capturing lambda, which accepts
+     * (AceButton*, uint8_t eventType, uint8_t buttonState). Only the pointer
+     * is stored, so the callable must outlive the delegate.
+     */
+    template <typename F>
+    static EventDelegate fromCallable(F* callable) {
+      return EventDelegate(
+          const_cast<void*>(static_cast<const void*>(callable)),
+          &callableStub<F>);
+    }
+
+    /**
+     * Bind to a callable object which also accepts (int64_t eventTime,
+     * int64_t duration).
+     */
+    template <typename F>
+    static EventDelegate fromCallable2(F* callable) {
+      return EventDelegate(
+          const_cast<void*>(static_cast<const void*>(callable)),
+          &callable2Stub<F>);
+    }
+
+    /** Invoke the bound handler. */
+    void operator()(AceButton* button, uint8_t eventType, uint8_t buttonState,
+        int64_t eventTime, int64_t duration) const {
+      mStub(mObject, button, eventType, buttonState, eventTime, duration);
+    }
+
+    /** Return true if the delegate is not bound to any handler. */
+    bool isNull() const { return mStub == &nullStub; }
+
+    /** Return the opaque object pointer. Intended for internal use. */
+    void* getObject() const { return mObject; }
+
+    /** Return true if both delegates refer to the same handler. */
+    bool operator==(const EventDelegate& other) const {
+      return mObject == other.mObject && mStub == other.mStub;
+    }
+
+    bool operator!=(const EventDelegate& other) const {
+      return !(*this == other);
+    }
+
+  private:
+    EventDelegate(void* object, Stub stub):
+        mObject(object),
+        mStub(stub) {}
+
+    static void nullStub(void* /*object*/, AceButton* /*button*/,
+        uint8_t /*eventType*/, uint8_t /*buttonState*/,
+        int64_t /*eventTime*/, int64_t /*duration*/) {}
+
+    static void functionStub(void* object, AceButton* button,
+        uint8_t eventType, uint8_t buttonState,
+        int64_t /*eventTime*/, int64_t /*duration*/) {
+      reinterpret_cast<Function>(object)(button, eventType, buttonState);
+    }
+
+    template <void (*FUNC)(AceButton*, uint8_t, uint8_t)>
+    static void staticFunctionStub(void* /*object*/, AceButton* button,
+        uint8_t eventType, uint8_t buttonState,
+        int64_t /*eventTime*/, int64_t /*duration*/) {
+      FUNC(button, eventType, buttonState);
+    }
+
+    static void function2Stub(void* object, AceButton* button,
+        uint8_t eventType, uint8_t buttonState,
+        int64_t eventTime, int64_t duration) {
+      reinterpret_cast<Function2>(object)(
+          button, eventType, buttonState, eventTime, duration);
+    }
+
+    static void handlerStub(void* object, AceButton* button,
+        uint8_t eventType, uint8_t buttonState,
+        int64_t /*eventTime*/, int64_t /*duration*/) {
+      static_cast<IEventHandler*>(object)->handleEvent(
+          button, eventType, buttonState);
+    }
+
+    static void handler2Stub(void* object, AceButton* button,
+        uint8_t eventType, uint8_t buttonState,
+        int64_t eventTime, int64_t duration) {
+      static_cast<IEventHandler2*>(object)->handleEvent(
+          button, eventType, buttonState, eventTime, duration);
+    }
+
+    template <typename T, void (T::*M)(AceButton*, uint8_t, uint8_t)>
+    static void methodStub(void* object, AceButton* button,
+        uint8_t eventType, uint8_t buttonState,
+        int64_t /*eventTime*/, int64_t /*duration*/) {
+      (static_cast<T*>(object)->*M)(button, eventType, buttonState);
+    }
+
+    template <typename T,
+        void (T::*M)(AceButton*, uint8_t, uint8_t, int64_t, int64_t)>
+    static void method2Stub(void* object, AceButton* button,
+        uint8_t eventType, uint8_t buttonState,
+        int64_t eventTime, int64_t duration) {
+      (static_cast<T*>(object)->*M)(
+          button, eventType, buttonState, eventTime, duration);
+    }
+
+    template <typename F>
+    static void callableStub(void* object, AceButton* button,
+        uint8_t eventType, uint8_t buttonState,
+        int64_t /*eventTime*/, int64_t /*duration*/) {
+      (*static_cast<F*>(object))(button, eventType, buttonState);
+    }
+
+    template <typename F>
+    static void callable2Stub(void* object, AceButton* button,
+        uint8_t eventType, uint8_t buttonState,
+        int64_t eventTime, int64_t duration) {
+      (*static_cast<F*>(object))(
+          button, eventType, buttonState, eventTime, duration);
+    }
+
+    void* mObject;
+    Stub mStub;
+};
+
+}
+
+#endif
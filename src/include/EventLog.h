@@ -0,0 +1,576 @@
+/*
+MIT License
+
+Copyright (c) 2026 Brian T. Park
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#ifndef ACE_BUTTON_EVENT_LOG_H
+#define ACE_BUTTON_EVENT_LOG_H
+
+#include <stdint.h>
+#include "AceButton.h"
+#include "ButtonEvent.h"
+
+namespace ace_button {
+
+/**
+ * The flash memory which holds an EventLog, divided into pages of the size of
+ * the erase unit (e.g. a 4 kB flash sector). Like NOR flash, an erased page
+ * reads as 0xFF, and a write can only clear bits. Implemented by
+ * PartitionLogStorage on ESP-IDF and by FileLogStorage on the host.
+ */
+class EventLogStorage {
+  public:
+    /** Size of a page, the erase unit, in bytes. */
+    virtual uint32_t getPageSize() const = 0;
+
+    /** Number of pages. */
+    virtual uint32_t getNumPages() const = 0;
+
+    /** Read size bytes at the address. Returns false on error. */
+    virtual bool read(uint32_t address, void* data, uint32_t size) = 0;
+
+    /** Write size bytes at the address. Returns false on error. */
+    virtual bool write(uint32_t address, const void* data, uint32_t size) = 0;
+
+    /** Erase the page to 0xFF. Returns false on error. */
+    virtual bool erasePage(uint32_t page) = 0;
+};
+
+/** A decoded record of an EventLog. */
+struct EventLogRecord {
+  /** The clock time (milliseconds) of the event, since its boot. */
+  int64_t eventTime;
+
+  /** The sequence number of the page which holds the record. */
+  uint32_t sequence;
+
+  /** The boot count of the EventLog::begin() which wrote the record. */
+  uint16_t bootCount;
+
+  /**
+   * AceButton::getId(), 16 bits so that the log of an ACE_BUTTON_WIDE_INDEX
+   * device can be decoded by any build.
+   */
+  uint16_t buttonId;
+
+  /** The AceButton::kEventXxx event type. */
+  uint8_t eventType;
+};
+
+/**
+ * The format of the pages of an EventLog, shared by the writer and the reader.
+ *
+ * Each page starts with a 16-byte header: a 16-bit magic number, the 16-bit
+ * boot count, the 32-bit sequence number of the page, and the 64-bit base time
+ * of the page, all little-endian. The records follow until the first 0xFF
+ * byte. A record is a tag byte (bits 0-2: event type, bit 3: a button id
+ * follows, otherwise the button is that of the previous record of the page),
+ * the optional button id as an unsigned LEB128 varint, and the time since the
+ * previous record of the page (or since the base time) as another varint. A
+ * record with a delta below 128 ms and the same button takes 2 bytes.
+ *
+ * A boot marker (tag kTagBootMarker, the boot count as a varint, and a new
+ * base time as a varint) is written when a later boot appends to the page.
+ * The records which follow it belong to that boot, and their times are
+ * relative to its base time, because the clock restarts at each boot.
+ *
+ * The pages of kMagicV1 (written before ACE_BUTTON_WIDE_INDEX) store the
+ * button id as a single byte. They are still decoded, but never appended to.
+ */
+class EventLogFormat {
+  public:
+    static const uint16_t kMagic = 0xAB1F;
+    static const uint16_t kMagicV1 = 0xAB1E;
+    static const uint32_t kHeaderSize = 16;
+    static const uint8_t kTagButtonId = 0x08;
+    static const uint8_t kTagEventTypeMask = 0x07;
+    static const uint8_t kTagBootMarker = 0x10;
+    static const uint8_t kMaxVarintSize = 10;
+    static const uint8_t kMaxButtonIdSize = 3;
+    static const uint8_t kMaxRecordSize = 1 + kMaxButtonIdSize + kMaxVarintSize;
+    static const uint8_t kMaxBootMarkerSize = 1 + 3 + kMaxVarintSize;
+
+    static_assert(sizeof(ButtonIdType) <= sizeof(uint16_t),
+        "EventLogRecord::buttonId must hold a ButtonIdType");
+
+    /** A decoded page header. */
+    struct Header {
+      int64_t baseTime;
+      uint32_t sequence;
+      uint16_t bootCount;
+      uint16_t magic;
+    };
+
+    static void encodeHeader(const Header& header, uint8_t* data) {
+      putLittleEndian(data, kMagic, 2);
+      putLittleEndian(data + 2, header.bootCount, 2);
+      putLittleEndian(data + 4, header.sequence, 4);
+      putLittleEndian(data + 8, (uint64_t) header.baseTime, 8);
+    }
+
+    /** Decode the header, returning false if the page has none. */
+    static bool decodeHeader(const uint8_t* data, Header& header) {
+      header.magic = (uint16_t) getLittleEndian(data, 2);
+      if (header.magic != kMagic && header.magic != kMagicV1) return false;
+      header.bootCount = (uint16_t) getLittleEndian(data + 2, 2);
+      header.sequence = (uint32_t) getLittleEndian(data + 4, 4);
+      header.baseTime = (int64_t) getLittleEndian(data + 8, 8);
+      return true;
+    }
+
+    /** Encode the value as a varint, returning its size. */
+    static uint8_t encodeVarint(uint64_t value, uint8_t* data) {
+      uint8_t size = 0;
+      while (value >= 0x80) {
+        data[size++] = (uint8_t) (value | 0x80);
+        value >>= 7;
+      }
+      data[size++] = (uint8_t) value;
+      return size;
+    }
+
+  private:
+    static void putLittleEndian(uint8_t* data, uint64_t value, uint8_t size) {
+      for (uint8_t i = 0; i < size; i++) {
+        data[i] = (uint8_t) (value >> (8 * i));
+      }
+    }
+
+    static uint64_t getLittleEndian(const uint8_t* data, uint8_t size) {
+      uint64_t value = 0;
+      for (uint8_t i = 0; i < size; i++) {
+        value |= (uint64_t) data[i] << (8 * i);
+      }
+      return value;
+    }
+};
+
+/**
+ * Sequential reader of the records of one page of an EventLogStorage, through
+ * a small window to limit the number of storage reads.
+ */
+class EventLogPageReader {
+  public:
+    explicit EventLogPageReader(EventLogStorage* storage):
+        mStorage(storage) {}
+
+    /**
+     * Start reading the page. Returns false if it does not hold a valid
+     * header.
+     */
+    bool open(uint32_t page) {
+      mPageSize = mStorage->getPageSize();
+      mAddress = page * mPageSize;
+      mWindowStart = mPageSize; // empty window
+      uint8_t data[EventLogFormat::kHeaderSize];
+      if (! mStorage->read(mAddress, data, sizeof(data))) return false;
+      if (! EventLogFormat::decodeHeader(data, mHeader)) return false;
+      mOffset = EventLogFormat::kHeaderSize;
+      mLastTime = mHeader.baseTime;
+      mBootCount = mHeader.bootCount;
+      mLastButtonId = 0;
+      mHasButtonId = false;
+      return true;
+    }
+
+    const EventLogFormat::Header& getHeader() const { return mHeader; }
+
+    /** The boot count of the records read so far, after the boot markers. */
+    uint16_t getBootCount() const { return mBootCount; }
+
+    /** Offset of the next record, i.e. the end of the valid records. */
+    uint32_t getOffset() const { return mOffset; }
+
+    int64_t getLastTime() const { return mLastTime; }
+
+    /**
+     * Decode the next record. Returns false at the end of the page, or at the
+     * first corrupted (e.g. torn by a power loss) record.
+     */
+    bool next(EventLogRecord& record) {
+      uint32_t offset = mOffset;
+      uint8_t tag;
+      if (! readByte(offset++, tag)) return false;
+      while (tag == EventLogFormat::kTagBootMarker
+          && mHeader.magic != EventLogFormat::kMagicV1) {
+        uint64_t bootCount;
+        uint64_t baseTime;
+        if (! readVarint(offset, 3, bootCount)
+            || bootCount > UINT16_MAX
+            || ! readVarint(offset, EventLogFormat::kMaxVarintSize, baseTime)) {
+          return false;
+        }
+        mOffset = offset;
+        mBootCount = (uint16_t) bootCount;
+        mLastTime = (int64_t) baseTime;
+        mHasButtonId = false;
+        if (! readByte(offset++, tag)) return false;
+      }
+      if (tag & ~(EventLogFormat::kTagButtonId
+          | EventLogFormat::kTagEventTypeMask)) {
+        return false; // 0xFF (erased) or corrupted
+      }
+
+      uint16_t buttonId = mLastButtonId;
+      if (tag & EventLogFormat::kTagButtonId) {
+        if (mHeader.magic == EventLogFormat::kMagicV1) {
+          uint8_t b;
+          if (! readByte(offset++, b)) return false;
+          buttonId = b;
+        } else {
+          uint64_t id;
+          if (! readVarint(offset, EventLogFormat::kMaxButtonIdSize, id)
+              || id > UINT16_MAX) {
+            return false;
+          }
+          buttonId = (uint16_t) id;
+        }
+      } else if (! mHasButtonId) {
+        return false;
+      }
+
+      uint64_t delta;
+      if (! readVarint(offset, EventLogFormat::kMaxVarintSize, delta)) {
+        return false;
+      }
+
+      mOffset = offset;
+      mLastTime += (int64_t) delta;
+      mLastButtonId = buttonId;
+      mHasButtonId = true;
+      record.eventTime = mLastTime;
+      record.sequence = mHeader.sequence;
+      record.bootCount = mBootCount;
+      record.buttonId = buttonId;
+      record.eventType = tag & EventLogFormat::kTagEventTypeMask;
+      return true;
+    }
+
+  private:
+    static const uint32_t kWindowSize = 64;
+
+    /** Read a varint of at most maxSize bytes, advancing offset. */
+    bool readVarint(uint32_t& offset, uint8_t maxSize, uint64_t& value) {
+      value = 0;
+      for (uint8_t i = 0; ; i++) {
+        uint8_t b;
+        if (i >= maxSize) return false;
+        if (! readByte(offset++, b)) return false;
+        value |= (uint64_t) (b & 0x7F) << (7 * i);
+        if ((b & 0x80) == 0) return true;
+      }
+    }
+
+    bool readByte(uint32_t offset, uint8_t& b) {
+      if (offset >= mPageSize) return false;
+      if (offset < mWindowStart || offset >= mWindowStart + kWindowSize) {
+        uint32_t size = mPageSize - offset;
+        if (size > kWindowSize) size = kWindowSize;
+        if (! mStorage->read(mAddress + offset, mWindow, size)) return false;
+        mWindowStart = offset;
+      }
+      b = mWindow[offset - mWindowStart];
+      return true;
+    }
+
+    EventLogStorage* const mStorage;
+    uint32_t mPageSize;
+    uint32_t mAddress;
+    uint32_t mOffset;
+    uint32_t mWindowStart;
+    EventLogFormat::Header mHeader;
+    int64_t mLastTime;
+    uint16_t mBootCount;
+    uint16_t mLastButtonId;
+    bool mHasButtonId;
+    uint8_t mWindow[kWindowSize];
+};
+
+/**
+ * An append-only log of button events in an EventLogStorage, for post-mortem
+ * analysis. Each event takes typically 2-4 bytes: its type, its button id
+ * (omitted if unchanged), and the time since the previous event as a varint
+ * (see EventLogFormat). The pages are used as a ring: when a page is full,
+ * the next one is erased and written, so that the oldest events are dropped
+ * and every page is erased once per pass over the storage, which levels the
+ * wear of the flash.
+ *
+ * Each begin() increments the boot count, because the clock restarts at each
+ * boot. The events of the new boot are appended to the newest page after a
+ * boot marker, so that a reboot does not erase a page. A new page is started
+ * only when the newest one is full, was written by an older version, or ends
+ * with a record torn by a power loss. Events are written to the storage
+ * immediately, so append() takes the time of a flash write, and should be
+ * called from a low priority task (e.g. the consumer of an EventBus or
+ * EventChannel), not from the event handler of the scan task.
+ *
+ * Usage:
+ *
+ * @code{.cpp}
+ * PartitionLogStorage storage;
+ * EventLog eventLog(&storage);
+ *
+ * void setup() {
+ *   storage.begin("buttonlog");
+ *   eventLog.begin();
+ * }
+ *
+ * void consumerTask() {
+ *   ButtonEvent event;
+ *   while (channel.waitForEvent(event, EventSignal::kWaitForever)) {
+ *     eventLog.append(event);
+ *   }
+ * }
+ * @endcode
+ */
+class EventLog {
+  public:
+    explicit EventLog(EventLogStorage* storage):
+        mStorage(storage) {}
+
+    /**
+     * Find the newest page of the storage and the end of its records, and
+     * prepare to append a boot marker there at the first append(). Returns
+     * false if the storage could not be read.
+     */
+    bool begin() {
+      mPageSize = mStorage->getPageSize();
+      mNumPages = mStorage->getNumPages();
+      if (mNumPages == 0
+          || mPageSize < EventLogFormat::kHeaderSize
+              + EventLogFormat::kMaxRecordSize) {
+        return false;
+      }
+
+      EventLogPageReader reader(mStorage);
+      bool found = false;
+      mPage = mNumPages - 1;
+      mSequence = 0;
+      mBootCount = 0;
+      for (uint32_t page = 0; page < mNumPages; page++) {
+        if (! reader.open(page)) continue;
+        const EventLogFormat::Header& header = reader.getHeader();
+        if (! found || (int32_t) (header.sequence - mSequence) > 0) {
+          found = true;
+          mPage = page;
+          mSequence = header.sequence;
+        }
+      }
+      mOffset = mPageSize; // start a new page at the first append()
+      mNeedBootMarker = false;
+      mNumPagesWritten = 0;
+      mLastTime = 0;
+      mLastButtonId = 0;
+      mHasButtonId = false;
+      if (! found) return true;
+
+      // Find the end of the records, and the boot count of the last one.
+      EventLogRecord record;
+      reader.open(mPage);
+      while (reader.next(record)) {}
+      mBootCount = reader.getBootCount() + 1;
+      if (reader.getHeader().magic == EventLogFormat::kMagic
+          && isErased(reader.getOffset())) {
+        mOffset = reader.getOffset();
+        mNeedBootMarker = true;
+      }
+      return true;
+    }
+
+    /**
+     * Append the event. Returns false if the storage could not be written.
+     */
+    bool append(ButtonIdType buttonId, uint8_t eventType, int64_t eventTime) {
+      uint8_t data[EventLogFormat::kMaxBootMarkerSize
+          + EventLogFormat::kMaxRecordSize];
+      uint8_t size = encode(buttonId, eventType, eventTime, data);
+      if (mOffset + size > mPageSize) {
+        if (! startPage(eventTime)) return false;
+        size = encode(buttonId, eventType, eventTime, data);
+      }
+      if (! mStorage->write(mPage * mPageSize + mOffset, data, size)) {
+        return false;
+      }
+      mOffset += size;
+      mNeedBootMarker = false;
+      mLastTime = eventTime;
+      mLastButtonId = buttonId;
+      mHasButtonId = true;
+      return true;
+    }
+
+    /** Append a ButtonEvent. */
+    bool append(const ButtonEvent& event) {
+      return append(event.buttonId, event.eventType, event.eventTime);
+    }
+
+    /** The boot count written in the pages of this boot. */
+    uint16_t getBootCount() const { return mBootCount; }
+
+    /** Number of pages erased and started since begin(). */
+    uint32_t getNumPagesWritten() const { return mNumPagesWritten; }
+
+  private:
+    // Disable copy-constructor and assignment operator
+    EventLog(const EventLog&) = delete;
+    EventLog& operator=(const EventLog&) = delete;
+
+    uint8_t encode(ButtonIdType buttonId, uint8_t eventType, int64_t eventTime,
+        uint8_t* data) const {
+      uint8_t size = 0;
+      int64_t lastTime = mLastTime;
+      bool hasButtonId = mHasButtonId;
+      if (mNeedBootMarker) {
+        data[size++] = EventLogFormat::kTagBootMarker;
+        size += EventLogFormat::encodeVarint(mBootCount, data + size);
+        lastTime = (eventTime > 0) ? eventTime : 0;
+        size += EventLogFormat::encodeVarint((uint64_t) lastTime, data + size);
+        hasButtonId = false;
+      }
+
+      bool sameButton = hasButtonId && buttonId == mLastButtonId;
+      data[size++] = (eventType & EventLogFormat::kTagEventTypeMask)
+          | (sameButton ? 0 : EventLogFormat::kTagButtonId);
+      if (! sameButton) {
+        size += EventLogFormat::encodeVarint(buttonId, data + size);
+      }
+      int64_t delta = eventTime - lastTime;
+      size += EventLogFormat::encodeVarint(
+          (delta > 0) ? (uint64_t) delta : 0, data + size);
+      return size;
+    }
+
+    bool startPage(int64_t baseTime) {
+      mPage = (mPage + 1) % mNumPages;
+      mSequence++;
+      if (! mStorage->erasePage(mPage)) return false;
+
+      EventLogFormat::Header header;
+      header.baseTime = baseTime;
+      header.sequence = mSequence;
+      header.bootCount = mBootCount;
+      uint8_t data[EventLogFormat::kHeaderSize];
+      EventLogFormat::encodeHeader(header, data);
+      if (! mStorage->write(mPage * mPageSize, data, sizeof(data))) {
+        return false;
+      }
+
+      mOffset = EventLogFormat::kHeaderSize;
+      mNeedBootMarker = false;
+      mLastTime = baseTime;
+      mHasButtonId = false;
+      mNumPagesWritten++;
+      return true;
+    }
+
+    /**
+     * Return true if the page is still erased from the offset, i.e. the
+     * records do not end with a torn write which cannot be overwritten.
+     */
+    bool isErased(uint32_t offset) {
+      uint8_t data[EventLogFormat::kMaxBootMarkerSize
+          + EventLogFormat::kMaxRecordSize];
+      if (offset + sizeof(data) > mPageSize) return false;
+      if (! mStorage->read(mPage * mPageSize + offset, data, sizeof(data))) {
+        return false;
+      }
+      for (uint8_t i = 0; i < sizeof(data); i++) {
+        if (data[i] != 0xFF) return false;
+      }
+      return true;
+    }
+
+    EventLogStorage* const mStorage;
+    uint32_t mPageSize;
+    uint32_t mNumPages;
+    uint32_t mPage;
+    uint32_t mOffset;
+    uint32_t mSequence;
+    uint32_t mNumPagesWritten;
+    int64_t mLastTime;
+    uint16_t mBootCount;
+    ButtonIdType mLastButtonId;
+    bool mHasButtonId;
+    bool mNeedBootMarker;
+};
+
+/**
+ * Decodes all the records of an EventLogStorage, from the oldest to the
+ * newest. Runs on the device, or on the host on an image of the partition
+ * (e.g. saved with `esptool.py read_flash` or `parttool.py read_partition`)
+ * with a FileLogStorage.
+ */
+class EventLogReader {
+  public:
+    explicit EventLogReader(EventLogStorage* storage):
+        mStorage(storage),
+        mPageReader(storage) {}
+
+    /** Start from the oldest page. */
+    void rewind() {
+      mNumPages = mStorage->getNumPages();
+      mCount = 0;
+      mPageOpen = false;
+
+      // Pages are written in ring order, so the oldest one follows the newest.
+      EventLogPageReader reader(mStorage);
+      bool found = false;
+      uint32_t newestSequence = 0;
+      mPage = 0;
+      for (uint32_t page = 0; page < mNumPages; page++) {
+        if (! reader.open(page)) continue;
+        uint32_t sequence = reader.getHeader().sequence;
+        if (! found || (int32_t) (sequence - newestSequence) > 0) {
+          found = true;
+          newestSequence = sequence;
+          mPage = (page + 1) % mNumPages;
+        }
+      }
+    }
+
+    /** Decode the next record. Returns false after the newest one. */
+    bool next(EventLogRecord& record) {
+      while (true) {
+        if (mPageOpen && mPageReader.next(record)) return true;
+        if (mCount >= mNumPages) return false;
+        mPageOpen = mPageReader.open(mPage);
+        mPage = (mPage + 1) % mNumPages;
+        mCount++;
+      }
+    }
+
+  private:
+    // Disable copy-constructor and assignment operator
+    EventLogReader(const EventLogReader&) = delete;
+    EventLogReader& operator=(const EventLogReader&) = delete;
+
+    EventLogStorage* const mStorage;
+    EventLogPageReader mPageReader;
+    uint32_t mNumPages;
+    uint32_t mPage;
+    uint32_t mCount;
+    bool mPageOpen;
+};
+
+}
+
+#endif
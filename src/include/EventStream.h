@@ -0,0 +1,335 @@
+/*
+MIT License
+
+Copyright (c) 2026 Brian T. Park
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#ifndef ACE_BUTTON_EVENT_STREAM_H
+#define ACE_BUTTON_EVENT_STREAM_H
+
+#include <stdint.h>
+#include <string.h>
+#include "AceButton.h"
+#include "ButtonConfig.h"
+#include "ButtonEvent.h"
+#include "ButtonStats.h"
+#include "EventDelegate.h"
+#include "RingBuffer.h"
+
+namespace ace_button {
+
+/**
+ * The binary wire format of an EventStreamWriter, decoded by an
+ * EventStreamDecoder.
+ *
+ * A message is a payload followed by its CRC-16/CCITT-FALSE (little-endian),
+ * encoded with Consistent Overhead Byte Stuffing (COBS) so that it contains no
+ * 0x00 byte, and terminated by a 0x00 delimiter. A receiver which starts in the
+ * middle of the stream, or loses bytes, resynchronizes at the next 0x00.
+ *
+ * The payload starts with the message type (1 byte) and a 16-bit sequence
+ * number, incremented for each message including those dropped by the
+ * sender, so that the receiver can count the lost messages. All multi-byte
+ * fields are little-endian.
+ *
+ * - kMessageEvent: buttonId (2), eventType (1), buttonState (1), eventTime
+ *   (lower 32 bits of the milliseconds, 4), duration (4), count (2).
+ * - kMessageEventV1: the same with a 1-byte buttonId. Sent by the writers
+ *   older than ACE_BUTTON_WIDE_INDEX, and still accepted by the decoder.
+ * - kMessageCounters: counter set (1), number of counters n (1), and n
+ *   32-bit counters. The counter set kCounterSetStream holds the number of
+ *   messages sent and dropped by the sender, kCounterSetStats the fields of a
+ *   ButtonStats in declaration order.
+ */
+class EventWireFormat {
+  public:
+    static const uint8_t kMessageEventV1 = 1;
+    static const uint8_t kMessageCounters = 2;
+    static const uint8_t kMessageEvent = 3;
+
+    static const uint8_t kCounterSetStream = 0;
+    static const uint8_t kCounterSetStats = 1;
+
+    static const uint8_t kHeaderSize = 3;
+    static const uint8_t kEventPayloadSize = kHeaderSize + 14;
+    static const uint8_t kEventV1PayloadSize = kHeaderSize + 13;
+    static const uint8_t kMaxCounters = 32;
+    static const uint8_t kMaxPayloadSize = kHeaderSize + 2 + 4 * kMaxCounters;
+
+    static_assert(sizeof(ButtonIdType) <= sizeof(uint16_t),
+        "the buttonId of kMessageEvent must hold a ButtonIdType");
+
+    /** Maximum size of a frame, including the CRC, COBS and delimiter. */
+    static const uint8_t kMaxFrameSize = kMaxPayloadSize + 2 + 2 + 1;
+
+    /** CRC-16/CCITT-FALSE: polynomial 0x1021, initial value 0xFFFF. */
+    static uint16_t crc16(const uint8_t* data, uint32_t size) {
+      uint16_t crc = 0xFFFF;
+      for (uint32_t i = 0; i < size; i++) {
+        crc ^= (uint16_t) data[i] << 8;
+        for (uint8_t bit = 0; bit < 8; bit++) {
+          crc = (crc & 0x8000) ? (uint16_t) ((crc << 1) ^ 0x1021)
+              : (uint16_t) (crc << 1);
+        }
+      }
+      return crc;
+    }
+
+    /**
+     * COBS-encode size bytes into output, which must hold size + size/254 + 1
+     * bytes. The delimiter is not appended. Returns the encoded size.
+     */
+    static uint32_t cobsEncode(const uint8_t* data, uint32_t size,
+        uint8_t* output) {
+      uint32_t codeIndex = 0;
+      uint32_t outIndex = 1;
+      uint8_t code = 1;
+      for (uint32_t i = 0; i < size; i++) {
+        if (data[i] != 0) {
+          output[outIndex++] = data[i];
+          code++;
+        }
+        if (data[i] == 0 || code == 0xFF) {
+          output[codeIndex] = code;
+          codeIndex = outIndex++;
+          code = 1;
+        }
+      }
+      output[codeIndex] = code;
+      return outIndex;
+    }
+
+    /**
+     * Decode size COBS bytes (without the delimiter) into output, which must
+     * hold size bytes. Returns the decoded size, or -1 if the input is
+     * invalid.
+     */
+    static int32_t cobsDecode(const uint8_t* data, uint32_t size,
+        uint8_t* output) {
+      uint32_t outIndex = 0;
+      uint32_t i = 0;
+      while (i < size) {
+        uint8_t code = data[i++];
+        if (code == 0 || i + code - 1 > size) return -1;
+        for (uint8_t j = 1; j < code; j++) {
+          output[outIndex++] = data[i++];
+        }
+        if (code != 0xFF && i < size) output[outIndex++] = 0;
+      }
+      return (int32_t) outIndex;
+    }
+
+    static void putUint16(uint8_t* data, uint16_t value) {
+      data[0] = (uint8_t) value;
+      data[1] = (uint8_t) (value >> 8);
+    }
+
+    static void putUint32(uint8_t* data, uint32_t value) {
+      for (uint8_t i = 0; i < 4; i++) data[i] = (uint8_t) (value >> (8 * i));
+    }
+
+    static uint16_t getUint16(const uint8_t* data) {
+      return (uint16_t) (data[0] | (data[1] << 8));
+    }
+
+    static uint32_t getUint32(const uint8_t* data) {
+      return (uint32_t) data[0] | ((uint32_t) data[1] << 8)
+          | ((uint32_t) data[2] << 16) | ((uint32_t) data[3] << 24);
+    }
+};
+
+/**
+ * Streams button events and counters to a host over a serial link, in the
+ * binary EventWireFormat. The messages are framed into a lock-free transmit
+ * ring of T_TX_CAPACITY bytes by the task which checks the buttons, without
+ * blocking: if the ring is full, the message is dropped and counted. Another
+ * task (or the same one, later) drains the ring into the UART with drain().
+ *
+ * Usage on ESP-IDF, with the non-blocking uart_tx_chars():
+ *
+ * @code{.cpp}
+ * EventStreamWriter<1024> stream;
+ *
+ * void setup() {
+ *   ...
+ *   stream.attach(&buttonConfig);
+ * }
+ *
+ * void loop() {
+ *   button.check();
+ *   stream.drain([](const uint8_t* data, uint32_t size) -> uint32_t {
+ *     int n = uart_tx_chars(UART_NUM_1, (const char*) data, size);
+ *     return (n > 0) ? n : 0;
+ *   });
+ * }
+ * @endcode
+ *
+ * All the publish methods must be called by the same task.
+ *
+ * @tparam T_TX_CAPACITY size of the transmit ring in bytes, a power of 2
+ */
+template <uint32_t T_TX_CAPACITY>
+class EventStreamWriter {
+  public:
+    EventStreamWriter():
+        mSequence(0),
+        mNumSent(0),
+        mNumDropped(0) {}
+
+    /** Install the writer as the event handler of the ButtonConfig. */
+    void attach(ButtonConfig* buttonConfig) {
+      buttonConfig->setEventDelegate(
+          EventDelegate::fromMethod2<EventStreamWriter,
+              &EventStreamWriter::handleEvent>(this));
+    }
+
+    /** Event handler which publishes the event. */
+    void handleEvent(AceButton* button, uint8_t eventType,
+        uint8_t buttonState, int64_t eventTime, int64_t duration) {
+      publishEvent(button->getId(), eventType, buttonState, eventTime,
+          (uint32_t) duration, 1);
+    }
+
+    /** Publish a ButtonEvent, e.g. taken from an EventBus. */
+    bool publish(const ButtonEvent& event) {
+      return publishEvent(event.buttonId, event.eventType,
+          event.buttonState, event.eventTime, (uint32_t) event.duration,
+          event.count);
+    }
+
+    /** Publish an event message. Returns false if it was dropped. */
+    bool publishEvent(ButtonIdType buttonId, uint8_t eventType,
+        uint8_t buttonState, int64_t eventTime, uint32_t duration,
+        uint16_t count) {
+      uint8_t payload[EventWireFormat::kEventPayloadSize];
+      uint8_t* p = startPayload(payload, EventWireFormat::kMessageEvent);
+      EventWireFormat::putUint16(p, buttonId);
+      p[2] = eventType;
+      p[3] = buttonState;
+      EventWireFormat::putUint32(p + 4, (uint32_t) eventTime);
+      EventWireFormat::putUint32(p + 8, duration);
+      EventWireFormat::putUint16(p + 12, count);
+      return sendFrame(payload, sizeof(payload));
+    }
+
+    /**
+     * Publish n (at most EventWireFormat::kMaxCounters) counters of the given
+     * counter set. Returns false if the message was dropped.
+     */
+    bool publishCounters(uint8_t counterSet, const uint32_t* counters,
+        uint8_t n) {
+      if (n > EventWireFormat::kMaxCounters) return false;
+      uint8_t payload[EventWireFormat::kMaxPayloadSize];
+      uint8_t* p = startPayload(payload, EventWireFormat::kMessageCounters);
+      p[0] = counterSet;
+      p[1] = n;
+      for (uint8_t i = 0; i < n; i++) {
+        EventWireFormat::putUint32(p + 2 + 4 * i, counters[i]);
+      }
+      return sendFrame(payload, EventWireFormat::kHeaderSize + 2 + 4 * n);
+    }
+
+    /** Publish the number of messages sent and dropped by this writer. */
+    bool publishStreamCounters() {
+      uint32_t counters[2] = {mNumSent, mNumDropped};
+      return publishCounters(EventWireFormat::kCounterSetStream, counters, 2);
+    }
+
+  #if ACE_BUTTON_ENABLE_STATS
+    /** Publish the ButtonStats of a ButtonConfig. */
+    bool publishStats(const ButtonStats& stats) {
+      static_assert(sizeof(ButtonStats) % sizeof(uint32_t) == 0,
+          "ButtonStats must contain only uint32_t");
+      uint32_t counters[sizeof(ButtonStats) / sizeof(uint32_t)];
+      memcpy(counters, &stats, sizeof(stats));
+      return publishCounters(EventWireFormat::kCounterSetStats, counters,
+          sizeof(counters) / sizeof(counters[0]));
+    }
+  #endif
+
+    /**
+     * Give the pending bytes to the write function, which is called with
+     * (const uint8_t* data, uint32_t size) and returns the number of bytes it
+     * accepted without blocking. Returns the number of bytes drained. May be
+     * called by a different task than the publishers.
+     */
+    template <typename W>
+    uint32_t drain(W&& write) {
+      uint32_t total = 0;
+      while (true) {
+        const uint8_t* data;
+        uint32_t size = mRing.peek(data);
+        if (size == 0) break;
+        uint32_t n = write(data, size);
+        mRing.consume(n);
+        total += n;
+        if (n < size) break;
+      }
+      return total;
+    }
+
+    /** Number of bytes waiting to be drained. */
+    uint32_t getPendingSize() const { return mRing.size(); }
+
+    /** Number of messages written to the transmit ring. */
+    uint32_t getNumSent() const { return mNumSent; }
+
+    /** Number of messages dropped because the transmit ring was full. */
+    uint32_t getNumDropped() const { return mNumDropped; }
+
+  private:
+    // Disable copy-constructor and assignment operator
+    EventStreamWriter(const EventStreamWriter&) = delete;
+    EventStreamWriter& operator=(const EventStreamWriter&) = delete;
+
+    /** Write the header and return a pointer to the body. */
+    uint8_t* startPayload(uint8_t* payload, uint8_t messageType) {
+      payload[0] = messageType;
+      EventWireFormat::putUint16(payload + 1, mSequence++);
+      return payload + EventWireFormat::kHeaderSize;
+    }
+
+    bool sendFrame(uint8_t* payload, uint32_t size) {
+      uint8_t data[EventWireFormat::kMaxPayloadSize + 2];
+      memcpy(data, payload, size);
+      EventWireFormat::putUint16(data + size,
+          EventWireFormat::crc16(payload, size));
+
+      uint8_t frame[EventWireFormat::kMaxFrameSize];
+      uint32_t frameSize = EventWireFormat::cobsEncode(data, size + 2, frame);
+      frame[frameSize++] = 0;
+      if (! mRing.write(frame, frameSize)) {
+        mNumDropped++;
+        return false;
+      }
+      mNumSent++;
+      return true;
+    }
+
+    ByteRingBuffer<T_TX_CAPACITY> mRing;
+    uint16_t mSequence;
+    uint32_t mNumSent;
+    uint32_t mNumDropped;
+};
+
+}
+
+#endif
@@ -0,0 +1,206 @@
+/*
+MIT License
+
+Copyright (c) 2026 Brian T. Park
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#ifndef ACE_BUTTON_EVENT_STREAM_DECODER_H
+#define ACE_BUTTON_EVENT_STREAM_DECODER_H
+
+#include <stdint.h>
+#include "EventStream.h"
+
+namespace ace_button {
+
+/** A message decoded by an EventStreamDecoder. */
+struct WireMessage {
+  /**
+   * EventWireFormat::kMessageXxx. A kMessageEventV1 is reported as a
+   * kMessageEvent.
+   */
+  uint8_t type;
+
+  /** Sequence number of the message. */
+  uint16_t sequence;
+
+  // kMessageEvent
+  uint16_t buttonId;
+  uint8_t eventType;
+  uint8_t buttonState;
+  uint32_t eventTime;
+  uint32_t duration;
+  uint16_t count;
+
+  // kMessageCounters
+  uint8_t counterSet;
+  uint8_t numCounters;
+  uint32_t counters[EventWireFormat::kMaxCounters];
+};
+
+/**
+ * Decoder of the byte stream of an EventStreamWriter, e.g. read from a serial
+ * port on the host. Portable C++, without dynamic allocation. Corrupted frames
+ * are counted and skipped, and the gaps in the sequence numbers are counted
+ * as lost messages.
+ *
+ * @code{.cpp}
+ * EventStreamDecoder decoder;
+ * WireMessage message;
+ * uint8_t buffer[256];
+ * ssize_t n = read(fd, buffer, sizeof(buffer));
+ * for (ssize_t i = 0; i < n; i++) {
+ *   if (decoder.decode(buffer[i], message)) {
+ *     ...
+ *   }
+ * }
+ * @endcode
+ */
+class EventStreamDecoder {
+  public:
+    EventStreamDecoder() { reset(); }
+
+    /** Forget the partial frame, the sequence and the counters. */
+    void reset() {
+      mSize = 0;
+      mOverflow = false;
+      mHasSequence = false;
+      mNextSequence = 0;
+      mNumMessages = 0;
+      mNumCorrupted = 0;
+      mNumLost = 0;
+    }
+
+    /**
+     * Decode the next byte of the stream. Returns true if it completes a
+     * valid message, which is then copied into message.
+     */
+    bool decode(uint8_t b, WireMessage& message) {
+      if (b != 0) {
+        if (mSize < sizeof(mFrame)) {
+          mFrame[mSize++] = b;
+        } else {
+          mOverflow = true;
+        }
+        return false;
+      }
+
+      // End of frame.
+      uint32_t size = mSize;
+      bool overflow = mOverflow;
+      mSize = 0;
+      mOverflow = false;
+      if (size == 0) return false; // consecutive delimiters
+      if (overflow || ! parseFrame(size, message)) {
+        mNumCorrupted++;
+        return false;
+      }
+
+      if (mHasSequence) {
+        mNumLost += (uint16_t) (message.sequence - mNextSequence);
+      }
+      mHasSequence = true;
+      mNextSequence = message.sequence + 1;
+      mNumMessages++;
+      return true;
+    }
+
+    /** Number of valid messages. */
+    uint32_t getNumMessages() const { return mNumMessages; }
+
+    /** Number of frames with a bad COBS encoding, length or CRC. */
+    uint32_t getNumCorrupted() const { return mNumCorrupted; }
+
+    /**
+     * Number of messages missing from the sequence numbers, dropped by the
+     * sender or corrupted on the link.
+     */
+    uint32_t getNumLost() const { return mNumLost; }
+
+  private:
+    bool parseFrame(uint32_t size, WireMessage& message) {
+      uint8_t data[sizeof(mFrame)];
+      int32_t n = EventWireFormat::cobsDecode(mFrame, size, data);
+      if (n < EventWireFormat::kHeaderSize + 2) return false;
+      uint32_t payloadSize = (uint32_t) n - 2;
+      uint16_t crc = EventWireFormat::getUint16(data + payloadSize);
+      if (crc != EventWireFormat::crc16(data, payloadSize)) return false;
+
+      const uint8_t* p = data + EventWireFormat::kHeaderSize;
+      message.type = data[0];
+      message.sequence = EventWireFormat::getUint16(data + 1);
+      switch (message.type) {
+        case EventWireFormat::kMessageEvent:
+          if (payloadSize != EventWireFormat::kEventPayloadSize) return false;
+          message.buttonId = EventWireFormat::getUint16(p);
+          message.eventType = p[2];
+          message.buttonState = p[3];
+          message.eventTime = EventWireFormat::getUint32(p + 4);
+          message.duration = EventWireFormat::getUint32(p + 8);
+          message.count = EventWireFormat::getUint16(p + 12);
+          return true;
+
+        case EventWireFormat::kMessageEventV1:
+          if (payloadSize != EventWireFormat::kEventV1PayloadSize) {
+            return false;
+          }
+          message.type = EventWireFormat::kMessageEvent;
+          message.buttonId = p[0];
+          message.eventType = p[1];
+          message.buttonState = p[2];
+          message.eventTime = EventWireFormat::getUint32(p + 3);
+          message.duration = EventWireFormat::getUint32(p + 7);
+          message.count = EventWireFormat::getUint16(p + 11);
+          return true;
+
+        case EventWireFormat::kMessageCounters:
+          if (payloadSize < EventWireFormat::kHeaderSize + 2u) return false;
+          message.counterSet = p[0];
+          message.numCounters = p[1];
+          if (message.numCounters > EventWireFormat::kMaxCounters
+              || payloadSize != EventWireFormat::kHeaderSize + 2u
+                  + 4u * message.numCounters) {
+            return false;
+          }
+          for (uint8_t i = 0; i < message.numCounters; i++) {
+            message.counters[i] = EventWireFormat::getUint32(p + 2 + 4 * i);
+          }
+          return true;
+
+        default:
+          // Unknown message types of a newer sender are skipped, but keep
+          // their sequence number.
+          return true;
+      }
+    }
+
+    uint8_t mFrame[EventWireFormat::kMaxFrameSize];
+    uint32_t mSize;
+    bool mOverflow;
+    bool mHasSequence;
+    uint16_t mNextSequence;
+    uint32_t mNumMessages;
+    uint32_t mNumCorrupted;
+    uint32_t mNumLost;
+};
+
+}
+
+#endif
@@ -0,0 +1,193 @@
+/*
+MIT License
+
+Copyright (c) 2026 Brian T. Park
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#ifndef ACE_BUTTON_EVENT_SUBSCRIBERS_H
+#define ACE_BUTTON_EVENT_SUBSCRIBERS_H
+
+#include "AceButton.h"
+
+namespace ace_button {
+
+/**
+ * A fixed-capacity table of event handlers that allows several independent
+ * listeners (e.g. the UI, a logger and a power manager) to receive the events
+ * of a single ButtonConfig, without writing a fan-out IEventHandler. Each
+ * subscriber has an event mask, and optionally a button id filter, so that an
+ * event is delivered only to the subscribers that asked for it. The filters
+ * are evaluated using bit tests. No heap allocation is performed.
+ *
+ * The table installs itself as the EventDelegate of the ButtonConfig using
+ * attach(), so a ButtonConfig that does not use subscribers pays nothing.
+ *
+ * @code
+ * EventSubscribers<3> subscribers;
+ *
+ * void setup() {
+ *   subscribers.attach(&buttonConfig);
+ *   subscribers.subscribe(EventDelegate::fromHandler(&ui));
+ *   subscribers.subscribe(EventDelegate::fromHandler(&logger),
+ *       EventSubscribers<3>::kEventMaskPressed
+ *       | EventSubscribers<3>::kEventMaskReleased);
+ *   subscribers.subscribe(EventDelegate::fromHandler(&power),
+ *       EventSubscribers<3>::kEventMaskLongPressed, POWER_BUTTON_ID);
+ * }
+ * @endcode
+ *
+ * @tparam T_CAPACITY maximum number of subscribers
+ */
+template <uint8_t T_CAPACITY>
+class EventSubscribers {
+  public:
+    /**
+     * Type of the event mask. One bit per event type, so it must be widened if
+     * more than 8 event types are defined.
+     */
+    typedef uint8_t EventMaskType;
+
+    static const EventMaskType kEventMaskPressed =
+        1 << AceButton::kEventPressed;
+    static const EventMaskType kEventMaskReleased =
+        1 << AceButton::kEventReleased;
+    static const EventMaskType kEventMaskClicked =
+        1 << AceButton::kEventClicked;
+    static const EventMaskType kEventMaskDoubleClicked =
+        1 << AceButton::kEventDoubleClicked;
+    static const EventMaskType kEventMaskLongPressed =
+        1 << AceButton::kEventLongPressed;
+    static const EventMaskType kEventMaskRepeatPressed =
+        1 << AceButton::kEventRepeatPressed;
+    static const EventMaskType kEventMaskLongReleased =
+        1 << AceButton::kEventLongReleased;
+    static const EventMaskType kEventMaskHeartBeat =
+        1 << AceButton::kEventHeartBeat;
+    static const EventMaskType kEventMaskAll = 0xFF;
+
+    EventSubscribers():
+        mNumSubscribers(0) {}
+
+    /**
+     * Install this table as the event handler of the given ButtonConfig. The
+     * table may be attached to more than one ButtonConfig.
+     */
+    void attach(ButtonConfig* buttonConfig) {
+      buttonConfig->setEventDelegate(
+          EventDelegate::fromMethod2<EventSubscribers,
+              &EventSubscribers::handleEvent>(this));
+    }
+
+    /**
+     * Add a subscriber for the events selected by eventMask, from all buttons.
+     * Returns false if the table is full.
+     */
+    bool subscribe(const EventDelegate& eventDelegate,
+        EventMaskType eventMask = kEventMaskAll) {
+      return add(eventDelegate, eventMask, 0, false);
+    }
+
+    /**
+     * Add a subscriber for the events selected by eventMask, only from the
+     * buttons whose AceButton::getId() is equal to buttonId. Returns false if
+     * the table is full.
+     */
+    bool subscribe(const EventDelegate& eventDelegate,
+        EventMaskType eventMask, ButtonIdType buttonId) {
+      return add(eventDelegate, eventMask, buttonId, true);
+    }
+
+    /**
+     * Remove all subscriptions of the given delegate. The relative order of the
+     * remaining subscribers is preserved. Returns true if any subscription was
+     * removed.
+     */
+    bool unsubscribe(const EventDelegate& eventDelegate) {
+      uint8_t j = 0;
+      for (uint8_t i = 0; i < mNumSubscribers; i++) {
+        if (mSubscribers[i].eventDelegate != eventDelegate) {
+          mSubscribers[j++] = mSubscribers[i];
+        }
+      }
+      bool removed = (j != mNumSubscribers);
+      mNumSubscribers = j;
+      return removed;
+    }
+
+    /** Remove all subscribers. */
+    void clear() { mNumSubscribers = 0; }
+
+    /** Return the number of subscribers. */
+    uint8_t getNumSubscribers() const { return mNumSubscribers; }
+
+    /** Return the maximum number of subscribers. */
+    static uint8_t getCapacity() { return T_CAPACITY; }
+
+    /**
+     * Deliver the event to every subscriber whose filters match. This is meant
+     * to be an internal method, called through the EventDelegate installed by
+     * attach().
+     */
+    void handleEvent(AceButton* button, uint8_t eventType,
+        uint8_t buttonState, int64_t eventTime, int64_t duration) {
+      EventMaskType eventBit = 1 << eventType;
+      ButtonIdType buttonId = button->getId();
+      for (uint8_t i = 0; i < mNumSubscribers; i++) {
+        const Subscriber& subscriber = mSubscribers[i];
+        if (! (subscriber.eventMask & eventBit)) continue;
+        if (subscriber.filterById && subscriber.buttonId != buttonId) continue;
+        subscriber.eventDelegate(
+            button, eventType, buttonState, eventTime, duration);
+      }
+    }
+
+  private:
+    // Disable copy-constructor and assignment operator
+    EventSubscribers(const EventSubscribers&) = delete;
+    EventSubscribers& operator=(const EventSubscribers&) = delete;
+
+    struct Subscriber {
+      EventDelegate eventDelegate;
+      EventMaskType eventMask;
+      ButtonIdType buttonId;
+      bool filterById;
+    };
+
+    bool add(const EventDelegate& eventDelegate, EventMaskType eventMask,
+        ButtonIdType buttonId, bool filterById) {
+      if (mNumSubscribers >= T_CAPACITY) return false;
+
+      Subscriber& subscriber = mSubscribers[mNumSubscribers];
+      subscriber.eventDelegate = eventDelegate;
+      subscriber.eventMask = eventMask;
+      subscriber.buttonId = buttonId;
+      subscriber.filterById = filterById;
+      mNumSubscribers++;
+      return true;
+    }
+
+    Subscriber mSubscribers[T_CAPACITY];
+    uint8_t mNumSubscribers;
+};
+
+}
+
+#endif
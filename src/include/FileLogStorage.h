@@ -0,0 +1,130 @@
+/*
+MIT License
+
+Copyright (c) 2026 Brian T. Park
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#ifndef ACE_BUTTON_FILE_LOG_STORAGE_H
+#define ACE_BUTTON_FILE_LOG_STORAGE_H
+
+#include <stdint.h>
+#include <stdio.h>
+#include "EventLog.h"
+
+namespace ace_button {
+
+/**
+ * An EventLogStorage in a file, which stands in for the flash partition on the
+ * host. The file is an image of the partition: it can be decoded by an
+ * EventLogReader after it was dumped from the device, or used to test the
+ * format and the throughput of an EventLog. A write clears bits like NOR
+ * flash, i.e. the new data is AND-ed with the current contents.
+ */
+class FileLogStorage: public EventLogStorage {
+  public:
+    FileLogStorage(uint32_t pageSize, uint32_t numPages):
+        mFile(nullptr),
+        mPageSize(pageSize),
+        mNumPages(numPages) {}
+
+    ~FileLogStorage() { close(); }
+
+    /**
+     * Open the image file, creating it erased (0xFF) if it does not exist, and
+     * extending it to pageSize * numPages if it is shorter. Returns false on
+     * error.
+     */
+    bool open(const char* path) {
+      close();
+      mFile = fopen(path, "r+b");
+      if (mFile == nullptr) mFile = fopen(path, "w+b");
+      if (mFile == nullptr) return false;
+
+      if (fseek(mFile, 0, SEEK_END) != 0) return false;
+      long size = ftell(mFile);
+      long imageSize = (long) mPageSize * mNumPages;
+      for (; size < imageSize; size++) {
+        if (fputc(0xFF, mFile) == EOF) return false;
+      }
+      return fflush(mFile) == 0;
+    }
+
+    /** Close the image file. */
+    void close() {
+      if (mFile != nullptr) {
+        fclose(mFile);
+        mFile = nullptr;
+      }
+    }
+
+    uint32_t getPageSize() const override { return mPageSize; }
+
+    uint32_t getNumPages() const override { return mNumPages; }
+
+    bool read(uint32_t address, void* data, uint32_t size) override {
+      if (! isValid(address, size)) return false;
+      if (fseek(mFile, address, SEEK_SET) != 0) return false;
+      return fread(data, 1, size, mFile) == size;
+    }
+
+    bool write(uint32_t address, const void* data, uint32_t size) override {
+      uint8_t current[64];
+      const uint8_t* bytes = static_cast<const uint8_t*>(data);
+      while (size > 0) {
+        uint32_t n = (size < sizeof(current)) ? size : sizeof(current);
+        if (! read(address, current, n)) return false;
+        for (uint32_t i = 0; i < n; i++) current[i] &= bytes[i];
+        if (fseek(mFile, address, SEEK_SET) != 0) return false;
+        if (fwrite(current, 1, n, mFile) != n) return false;
+        address += n;
+        bytes += n;
+        size -= n;
+      }
+      return true;
+    }
+
+    bool erasePage(uint32_t page) override {
+      if (page >= mNumPages) return false;
+      if (fseek(mFile, (long) page * mPageSize, SEEK_SET) != 0) return false;
+      for (uint32_t i = 0; i < mPageSize; i++) {
+        if (fputc(0xFF, mFile) == EOF) return false;
+      }
+      return true;
+    }
+
+  private:
+    // Disable copy-constructor and assignment operator
+    FileLogStorage(const FileLogStorage&) = delete;
+    FileLogStorage& operator=(const FileLogStorage&) = delete;
+
+    bool isValid(uint32_t address, uint32_t size) const {
+      return mFile != nullptr
+          && (uint64_t) address + size <= (uint64_t) mPageSize * mNumPages;
+    }
+
+    FILE* mFile;
+    uint32_t const mPageSize;
+    uint32_t const mNumPages;
+};
+
+}
+
+#endif
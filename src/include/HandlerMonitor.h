@@ -0,0 +1,250 @@
+/*
+MIT License
+
+Copyright (c) 2026 Brian T. Park
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#ifndef ACE_BUTTON_HANDLER_MONITOR_H
+#define ACE_BUTTON_HANDLER_MONITOR_H
+
+#include <stdint.h>
+#include "esp_timer.h"
+#include "AceButton.h"
+#include "ButtonConfig.h"
+#include "EventDelegate.h"
+
+namespace ace_button {
+
+/**
+ * An opt-in monitor which times each invocation of the event handler of a
+ * ButtonConfig. A slow handler delays the next AceButton::check(), which
+ * degrades the debouncing and the click timing when check() is no longer
+ * called every few milliseconds.
+ *
+ * The monitor is installed in place of the event handler, and forwards each
+ * event to it. It keeps the T_NUM_OFFENDERS (event type, button id) pairs with
+ * the longest handler invocations, and counts the invocations which exceeded
+ * the budget. The optional overrun callback is called when the budget is
+ * exceeded, at most once per minimum interval, so that a persistently slow
+ * handler does not flood the log.
+ *
+ * @code
+ * void onOverrun(AceButton* button, uint8_t eventType, uint32_t elapsedMicros,
+ *     uint32_t budgetMicros) {
+ *   ESP_LOGW(TAG, "slow handler: button %d event %d took %u us", ...);
+ * }
+ *
+ * HandlerMonitor<4> monitor;
+ *
+ * void setup() {
+ *   buttonConfig.setEventHandler(handleEvent);
+ *   monitor.setOverrunCallback(onOverrun, 10000);
+ *   monitor.attach(&buttonConfig); // budget = getDebounceDelay() / 4
+ * }
+ * @endcode
+ *
+ * All methods must be called from the task which checks the buttons, or while
+ * it is not running.
+ *
+ * @tparam T_NUM_OFFENDERS number of worst offenders to keep
+ */
+template <uint8_t T_NUM_OFFENDERS>
+class HandlerMonitor {
+  public:
+    /** The worst handler invocation for an event type of a button. */
+    struct Offender {
+      /** Largest duration of the handler, in microseconds. */
+      uint32_t maxMicros;
+
+      /** Number of invocations which exceeded the budget. */
+      uint32_t numOverruns;
+
+      /** AceButton::getId() of the button. */
+      ButtonIdType buttonId;
+
+      /** The AceButton::kEventXxx event type. */
+      uint8_t eventType;
+    };
+
+    /** Called when a handler invocation exceeds the budget. */
+    typedef void (*OverrunCallback)(AceButton* button, uint8_t eventType,
+        uint32_t elapsedMicros, uint32_t budgetMicros);
+
+    HandlerMonitor():
+        mBudgetMicros(0),
+        mOverrunCallback(nullptr),
+        mMinCallbackIntervalMicros(0),
+        mLastCallbackMicros(0),
+        mNumOffenders(0),
+        mNumOverruns(0),
+        mNumSuppressedCallbacks(0),
+        mCallbackFired(false) {}
+
+    /**
+     * Install the monitor in front of the current event handler of the
+     * ButtonConfig, which must be set before. If no budget was set, it
+     * defaults to a quarter of the debounce delay.
+     */
+    void attach(ButtonConfig* buttonConfig) {
+      mHandler = buttonConfig->getEventDelegate();
+      if (mBudgetMicros == 0) {
+        mBudgetMicros =
+            (uint32_t) (buttonConfig->getDebounceDelay() * 1000 / 4);
+      }
+      buttonConfig->setEventDelegate(
+          EventDelegate::fromMethod2<HandlerMonitor,
+              &HandlerMonitor::handleEvent>(this));
+    }
+
+    /** Replace the monitored event handler. */
+    void setEventDelegate(const EventDelegate& handler) { mHandler = handler; }
+
+    /** Set the budget of a handler invocation, in microseconds. */
+    void setBudgetMicros(uint32_t budgetMicros) {
+      mBudgetMicros = budgetMicros;
+    }
+
+    /** Return the budget of a handler invocation, in microseconds. */
+    uint32_t getBudgetMicros() const { return mBudgetMicros; }
+
+    /**
+     * Set the callback fired when the budget is exceeded, at most once every
+     * minIntervalMillis milliseconds. Overruns within the interval are still
+     * counted and recorded, and counted by getNumSuppressedCallbacks().
+     */
+    void setOverrunCallback(OverrunCallback callback,
+        uint32_t minIntervalMillis) {
+      mOverrunCallback = callback;
+      mMinCallbackIntervalMicros = (int64_t) minIntervalMillis * 1000;
+    }
+
+    /** Time the event handler and record its duration. */
+    void handleEvent(AceButton* button, uint8_t eventType,
+        uint8_t buttonState, int64_t eventTime, int64_t duration) {
+      int64_t startMicros = esp_timer_get_time();
+      mHandler(button, eventType, buttonState, eventTime, duration);
+      int64_t endMicros = esp_timer_get_time();
+      uint32_t elapsedMicros = (uint32_t) (endMicros - startMicros);
+
+      bool isOverrun = elapsedMicros > mBudgetMicros;
+      record(button->getId(), eventType, elapsedMicros, isOverrun);
+      if (! isOverrun) return;
+
+      mNumOverruns++;
+      if (mOverrunCallback == nullptr) return;
+      if (mCallbackFired
+          && endMicros - mLastCallbackMicros < mMinCallbackIntervalMicros) {
+        mNumSuppressedCallbacks++;
+        return;
+      }
+      mCallbackFired = true;
+      mLastCallbackMicros = endMicros;
+      mOverrunCallback(button, eventType, elapsedMicros, mBudgetMicros);
+    }
+
+    /** Number of offenders recorded, at most T_NUM_OFFENDERS. */
+    uint8_t getNumOffenders() const { return mNumOffenders; }
+
+    /**
+     * Return the offender at the given rank, 0 being the slowest handler
+     * invocation.
+     */
+    const Offender& getOffender(uint8_t rank) const {
+      return mOffenders[rank];
+    }
+
+    /** Total number of handler invocations which exceeded the budget. */
+    uint32_t getNumOverruns() const { return mNumOverruns; }
+
+    /** Number of overrun callbacks skipped by the rate limit. */
+    uint32_t getNumSuppressedCallbacks() const {
+      return mNumSuppressedCallbacks;
+    }
+
+    /** Clear the offenders and the counters. */
+    void clear() {
+      mNumOffenders = 0;
+      mNumOverruns = 0;
+      mNumSuppressedCallbacks = 0;
+      mCallbackFired = false;
+    }
+
+  private:
+    // Disable copy-constructor and assignment operator
+    HandlerMonitor(const HandlerMonitor&) = delete;
+    HandlerMonitor& operator=(const HandlerMonitor&) = delete;
+
+    /**
+     * Update the offender of (buttonId, eventType), or insert it if it is
+     * slower than the fastest offender, then keep the table sorted by
+     * decreasing maxMicros.
+     */
+    void record(ButtonIdType buttonId, uint8_t eventType,
+        uint32_t elapsedMicros, bool isOverrun) {
+      uint8_t i = 0;
+      for (; i < mNumOffenders; i++) {
+        if (mOffenders[i].buttonId == buttonId
+            && mOffenders[i].eventType == eventType) break;
+      }
+
+      if (i == mNumOffenders) {
+        if (mNumOffenders < T_NUM_OFFENDERS) {
+          mNumOffenders++;
+        } else if (elapsedMicros > mOffenders[i - 1].maxMicros) {
+          i--; // replace the fastest offender
+        } else {
+          return;
+        }
+        mOffenders[i].maxMicros = 0;
+        mOffenders[i].numOverruns = 0;
+        mOffenders[i].buttonId = buttonId;
+        mOffenders[i].eventType = eventType;
+      }
+
+      Offender& offender = mOffenders[i];
+      if (isOverrun) offender.numOverruns++;
+      if (elapsedMicros <= offender.maxMicros) return;
+      offender.maxMicros = elapsedMicros;
+
+      // Move up to keep the table sorted.
+      while (i > 0 && mOffenders[i - 1].maxMicros < mOffenders[i].maxMicros) {
+        Offender tmp = mOffenders[i - 1];
+        mOffenders[i - 1] = mOffenders[i];
+        mOffenders[i] = tmp;
+        i--;
+      }
+    }
+
+    EventDelegate mHandler;
+    uint32_t mBudgetMicros;
+    OverrunCallback mOverrunCallback;
+    int64_t mMinCallbackIntervalMicros;
+    int64_t mLastCallbackMicros;
+    Offender mOffenders[T_NUM_OFFENDERS];
+    uint8_t mNumOffenders;
+    uint32_t mNumOverruns;
+    uint32_t mNumSuppressedCallbacks;
+    bool mCallbackFired;
+};
+
+}
+
+#endif
@@ -0,0 +1,67 @@
+/*
+MIT License
+
+Copyright (c) 2026 Brian T. Park
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#ifndef ACE_BUTTON_IEVENT_HANDLER2_H
+#define ACE_BUTTON_IEVENT_HANDLER2_H
+
+#include <stdint.h>
+
+namespace ace_button {
+
+class AceButton;
+
+/**
+ * Extended version of IEventHandler which also receives the timing
+ * information that AceButton already computed while detecting the event.
+ * Register an implementation using ButtonConfig::setIEventHandler2().
+ *
+ * The eventTime is the value of ButtonConfig::getClock() sampled once at the
+ * start of AceButton::checkState(), so the handler does not need to read the
+ * clock again. The duration is the number of milliseconds between the
+ * kEventPressed and the release of the button, and is provided for
+ * kEventReleased, kEventLongReleased and kEventClicked. This removes the need
+ * for the handler to keep its own per-button press timestamps.
+ */
+class IEventHandler2 {
+  public:
+    /**
+     * Handle the button event.
+     *
+     * @param button pointer to the AceButton that generated the event
+     * @param eventType the event type which trigger the call
+     * @param buttonState the state of the button that triggered the event
+     * @param eventTime the clock time (milliseconds) when the event was
+     *        detected
+     * @param duration milliseconds the button was held down for
+     *        kEventReleased, kEventLongReleased and kEventClicked; 0 for all
+     *        other events, or if the press time is not known (e.g. the button
+     *        was already pressed when the device booted)
+     */
+    virtual void handleEvent(AceButton* button, uint8_t eventType,
+        uint8_t buttonState, int64_t eventTime, int64_t duration) = 0;
+};
+
+}
+
+#endif
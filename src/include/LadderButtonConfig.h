@@ -26,6 +26,7 @@ SOFTWARE.
 #define ACE_BUTTON_LADDER_BUTTON_CONFIG_H
 
 #include "ButtonConfig.h"
+#include "ButtonCore.h" // ButtonCore::SavedState
 
 // Unit test
 class LadderButtonConfig_extractIndex;
@@ -58,10 +59,29 @@ class LadderButtonConfig : public ButtonConfig {
      *        is in the released state. For a pull-up wiring, the state of the
      *        pin is HIGH when the button is released.
      */
-    LadderButtonConfig(uint8_t pin, uint8_t numLevels, const uint16_t levels[],
-        uint8_t numButtons, AceButton* const buttons[],
+    LadderButtonConfig(uint8_t pin, ButtonCountType numLevels,
+        const uint16_t levels[], ButtonCountType numButtons,
+        AceButton* const buttons[],
         uint8_t defaultReleasedState = HIGH);
 
+    /**
+     * Constructor which takes a contiguous array of buttons, e.g. the data()
+     * of a ButtonArray, instead of an array of pointers. See setButtons().
+     */
+    LadderButtonConfig(uint8_t pin, ButtonCountType numLevels,
+        const uint16_t levels[], ButtonCountType numButtons,
+        AceButton buttons[],
+        uint8_t defaultReleasedState = HIGH);
+
+    /**
+     * Replace the buttons with a contiguous array of buttons, and attach them
+     * to this ButtonConfig. The array must not be modified while
+     * checkButtons() is running. The number of buttons and the pointer are
+     * cached, so this must be called again after every change to the array;
+     * ButtonArray::attach() does that automatically.
+     */
+    void setButtons(ButtonCountType numButtons, AceButton buttons[]);
+
     /**
      * Return state of the button corresponding to the virtual 'pin' number.
      * LOW means that the corresponding encoded virtual pin was pushed.
@@ -69,7 +89,7 @@ class LadderButtonConfig : public ButtonConfig {
      * This method is not expected to be used. Use the checkButtons() method
      * instead for this class.
      */
-    int readButton(uint8_t pin) override;
+    int readButton(ButtonPinType pin) override;
 
     /**
      * Read the single mPin once, calculate the virtual pin number of the
@@ -89,8 +109,32 @@ class LadderButtonConfig : public ButtonConfig {
      */
     void checkButtons() const;
 
+    /**
+     * Read the virtual pin numSamples times (at most 15), then prime each
+     * button with the state given by the virtual pin seen by the majority of
+     * the samples (or getNoButtonPin() if there is no majority), see
+     * AceButton::prime(). Call it in setup() so that checkButtons() starts
+     * from the known states, without the initial debouncing period. Returns
+     * the number of pressed buttons.
+     */
+    ButtonCountType primeButtons(uint8_t numSamples = 1);
+
+    /**
+     * Save the state of the buttons into the states array, which must hold
+     * as many elements as there are buttons. See AceButton::saveState().
+     */
+    void saveButtons(ButtonCore::SavedState states[]) const;
+
+    /**
+     * Restore the states saved by saveButtons(), elapsedMillis after they were
+     * saved. See AceButton::restoreState(). Returns the number of buttons
+     * whose state was valid.
+     */
+    ButtonCountType restoreButtons(const ButtonCore::SavedState states[],
+        int64_t elapsedMillis = 0);
+
     /** The virtual button pin number corresponding to "no button" pressed. */
-    uint8_t getNoButtonPin() const {
+    ButtonPinType getNoButtonPin() const {
       return mNumLevels - 1;
     }
 
@@ -101,9 +145,18 @@ class LadderButtonConfig : public ButtonConfig {
      * this returns (numLevels - 1), which does not correspond to any valid
      * button.
      */
-    virtual uint8_t getVirtualPin() const;
+    virtual ButtonPinType getVirtualPin() const;
+
+    /**
+     * Return the virtual pin seen by the majority of numSamples calls to
+     * getVirtualPin(), or getNoButtonPin() if there is no majority.
+     */
+    ButtonPinType sampleVirtualPin(uint8_t numSamples) const;
 
   private:
+    /** Maximum number of samples of sampleVirtualPin(). */
+    static const uint8_t kMaxPrimeSamples = 15;
+
     // Allow unit test to access extractIndex().
     friend class ::LadderButtonConfig_extractIndex;
 
@@ -115,17 +168,22 @@ class LadderButtonConfig : public ButtonConfig {
      * Return the index of 'levels[]' which matches the given 'level'. Extracted
      * as a static function for unit testing.
      */
-    static uint8_t extractIndex(uint8_t numLevels, uint16_t const levels[],
-        uint16_t level);
+    static ButtonPinType extractIndex(ButtonCountType numLevels,
+        uint16_t const levels[], uint16_t level);
 
   private:
     // Arranged for efficient packing on 32-bit processors
     uint8_t const mPin;
-    uint8_t const mNumLevels;
-    uint8_t const mNumButtons;
     uint8_t const mPressedState;
+    ButtonCountType const mNumLevels;
+    ButtonCountType mNumButtons;
     uint16_t const* const mLevels;
-    AceButton* const* const mButtons;
+
+    /** Array of pointers to the buttons, or nullptr if mButtonArray is used. */
+    AceButton* const* mButtons;
+
+    /** Contiguous array of buttons, or nullptr if mButtons is used. */
+    AceButton* mButtonArray;
 };
 
 }
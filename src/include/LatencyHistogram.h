@@ -0,0 +1,228 @@
+/*
+MIT License
+
+Copyright (c) 2026 Brian T. Park
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#ifndef ACE_BUTTON_LATENCY_HISTOGRAM_H
+#define ACE_BUTTON_LATENCY_HISTOGRAM_H
+
+#include <stdint.h>
+#include <atomic>
+
+/**
+ * Set to 1 to record the duration of each AceButton::checkState() and of each
+ * checkButtons() of EncodedButtonConfig and LadderButtonConfig, in units of
+ * readCycleCounter(), into a LatencyHistogram of the ButtonConfig. Must be
+ * defined identically for all translation units. When 0 (the default), no
+ * timing code is compiled in.
+ */
+#ifndef ACE_BUTTON_ENABLE_CHECK_TIMING
+  #define ACE_BUTTON_ENABLE_CHECK_TIMING 0
+#endif
+
+/**
+ * Set to 1 to record the latency from the first raw edge of a button to the
+ * dispatch of its kEventPressed or kEventReleased in a LatencyHistogram of each
+ * ButtonConfig, see AceButton::getEdgeTime(). Must be defined identically for
+ * all translation units. When 0 (the default), no code is compiled in.
+ */
+#ifndef ACE_BUTTON_ENABLE_EDGE_LATENCY
+  #define ACE_BUTTON_ENABLE_EDGE_LATENCY 0
+#endif
+
+namespace ace_button {
+
+/** The tail latency summary of a LatencyHistogram. */
+struct LatencyPercentiles {
+  /** Number of samples. */
+  uint32_t count;
+
+  /** Median. */
+  uint32_t p50;
+
+  /** 99th percentile. */
+  uint32_t p99;
+
+  /** 99.9th percentile. */
+  uint32_t p999;
+
+  /** Largest sample. */
+  uint32_t max;
+};
+
+/**
+ * A histogram of 32-bit durations with logarithmic buckets. Each power of 2 is
+ * split into 2^T_SUB_BUCKET_BITS linear sub-buckets, so a percentile is
+ * reported with a relative error of at most 1/2^T_SUB_BUCKET_BITS, while the
+ * memory stays fixed at about (33 - T_SUB_BUCKET_BITS) * 2^T_SUB_BUCKET_BITS
+ * counters regardless of the range of the samples.
+ *
+ * The samples are recorded by a single task with plain increments, between two
+ * increments of a sequence number. Any other task can compute the percentiles
+ * consistently with readPercentiles(), which is retried if a sample was
+ * recorded during the computation.
+ *
+ * @tparam T_SUB_BUCKET_BITS log2 of the number of sub-buckets per power of 2
+ */
+template <uint8_t T_SUB_BUCKET_BITS = 2>
+class LatencyHistogram {
+  static_assert(T_SUB_BUCKET_BITS >= 1 && T_SUB_BUCKET_BITS <= 4,
+      "T_SUB_BUCKET_BITS must be between 1 and 4");
+
+  public:
+    /** Number of buckets. */
+    static const uint16_t kNumBuckets =
+        (33 - T_SUB_BUCKET_BITS) << T_SUB_BUCKET_BITS;
+
+    constexpr LatencyHistogram():
+        mSequence(0),
+        mResetRequested(false),
+        mCount(0),
+        mMax(0),
+        mCounts() {}
+
+    /** Record a sample. Recording task only. */
+    void record(uint32_t value) {
+      if (mResetRequested.load(std::memory_order_relaxed)) {
+        mResetRequested.store(false, std::memory_order_relaxed);
+        beginUpdate();
+        clear();
+        endUpdate();
+      }
+
+      beginUpdate();
+      mCounts[toBucket(value)]++;
+      mCount++;
+      if (value > mMax) mMax = value;
+      endUpdate();
+    }
+
+    /**
+     * Compute the percentiles of the samples recorded so far. Returns false
+     * if the recording task kept recording during maxAttempts attempts. Safe
+     * to call from any task.
+     */
+    bool readPercentiles(LatencyPercentiles& percentiles,
+        uint8_t maxAttempts = 8) const {
+      for (uint8_t i = 0; i < maxAttempts; i++) {
+        uint32_t sequence = mSequence.load(std::memory_order_acquire);
+        if (sequence & 1) continue;
+        percentiles.count = mCount;
+        percentiles.max = mMax;
+        percentiles.p50 = getPercentile(50, 100);
+        percentiles.p99 = getPercentile(99, 100);
+        percentiles.p999 = getPercentile(999, 1000);
+        std::atomic_thread_fence(std::memory_order_acquire);
+        if (sequence == mSequence.load(std::memory_order_relaxed)) return true;
+      }
+      return false;
+    }
+
+    /**
+     * Return the smallest bucket upper bound below which at least
+     * (numerator / denominator) of the samples fall, capped at the largest
+     * sample. Returns 0 if there are no samples. Not synchronized with the
+     * recording task, use readPercentiles() from another task.
+     */
+    uint32_t getPercentile(uint32_t numerator, uint32_t denominator) const {
+      if (mCount == 0) return 0;
+      uint64_t rank = ((uint64_t) mCount * numerator + denominator - 1)
+          / denominator;
+      if (rank == 0) rank = 1;
+      uint64_t cumulative = 0;
+      for (uint16_t i = 0; i < kNumBuckets; i++) {
+        cumulative += mCounts[i];
+        if (cumulative >= rank) {
+          uint32_t upper = bucketUpperBound(i);
+          return (upper < mMax) ? upper : mMax;
+        }
+      }
+      return mMax;
+    }
+
+    /** Number of samples. */
+    uint32_t getCount() const { return mCount; }
+
+    /** Largest sample. */
+    uint32_t getMax() const { return mMax; }
+
+    /**
+     * Ask the recording task to clear the histogram before its next sample.
+     * Safe to call from any task.
+     */
+    void requestReset() {
+      mResetRequested.store(true, std::memory_order_relaxed);
+    }
+
+    /** Return the index of the bucket of the value. */
+    static uint16_t toBucket(uint32_t value) {
+      if (value < kSubBuckets) return value;
+      uint8_t exponent = 31 - __builtin_clz(value);
+      uint8_t shift = exponent - T_SUB_BUCKET_BITS;
+      uint32_t mantissa = (value >> shift) & (kSubBuckets - 1);
+      return ((shift + 1) << T_SUB_BUCKET_BITS) | mantissa;
+    }
+
+    /** Return the largest value which falls in the bucket. */
+    static uint32_t bucketUpperBound(uint16_t bucket) {
+      if (bucket < kSubBuckets) return bucket;
+      uint8_t shift = (bucket >> T_SUB_BUCKET_BITS) - 1;
+      uint32_t mantissa = bucket & (kSubBuckets - 1);
+      uint32_t lower = ((kSubBuckets | mantissa) << shift);
+      return lower + (((uint32_t) 1 << shift) - 1);
+    }
+
+  private:
+    // Disable copy-constructor and assignment operator
+    LatencyHistogram(const LatencyHistogram&) = delete;
+    LatencyHistogram& operator=(const LatencyHistogram&) = delete;
+
+    static const uint32_t kSubBuckets = (uint32_t) 1 << T_SUB_BUCKET_BITS;
+
+    void beginUpdate() {
+      mSequence.store(mSequence.load(std::memory_order_relaxed) + 1,
+          std::memory_order_relaxed);
+      std::atomic_thread_fence(std::memory_order_release);
+    }
+
+    void endUpdate() {
+      mSequence.store(mSequence.load(std::memory_order_relaxed) + 1,
+          std::memory_order_release);
+    }
+
+    void clear() {
+      for (uint16_t i = 0; i < kNumBuckets; i++) mCounts[i] = 0;
+      mCount = 0;
+      mMax = 0;
+    }
+
+    /** Odd while the recording task is updating the histogram. */
+    std::atomic<uint32_t> mSequence;
+    std::atomic<bool> mResetRequested;
+    uint32_t mCount;
+    uint32_t mMax;
+    uint32_t mCounts[kNumBuckets];
+};
+
+}
+
+#endif
@@ -0,0 +1,87 @@
+/*
+MIT License
+
+Copyright (c) 2026 Brian T. Park
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#ifndef ACE_BUTTON_PARTITION_LOG_STORAGE_H
+#define ACE_BUTTON_PARTITION_LOG_STORAGE_H
+
+#include <stdint.h>
+#include "esp_partition.h"
+#include "EventLog.h"
+
+namespace ace_button {
+
+/**
+ * An EventLogStorage in a dedicated data partition of the flash, declared in
+ * the partition table of the application, e.g.
+ *
+ * @verbatim
+ * # Name,    Type, SubType, Offset, Size
+ * buttonlog, data, 0x40,    ,       64K
+ * @endverbatim
+ *
+ * A page is an erase sector of the partition (usually 4 kB).
+ */
+class PartitionLogStorage: public EventLogStorage {
+  public:
+    PartitionLogStorage():
+        mPartition(nullptr) {}
+
+    /** Find the data partition by label. Returns false if not found. */
+    bool begin(const char* label) {
+      mPartition = esp_partition_find_first(
+          ESP_PARTITION_TYPE_DATA, ESP_PARTITION_SUBTYPE_ANY, label);
+      return mPartition != nullptr;
+    }
+
+    uint32_t getPageSize() const override { return mPartition->erase_size; }
+
+    uint32_t getNumPages() const override {
+      return mPartition->size / mPartition->erase_size;
+    }
+
+    bool read(uint32_t address, void* data, uint32_t size) override {
+      return esp_partition_read(mPartition, address, data, size) == ESP_OK;
+    }
+
+    bool write(uint32_t address, const void* data, uint32_t size) override {
+      return esp_partition_write(mPartition, address, data, size) == ESP_OK;
+    }
+
+    bool erasePage(uint32_t page) override {
+      uint32_t pageSize = getPageSize();
+      return esp_partition_erase_range(
+          mPartition, page * pageSize, pageSize) == ESP_OK;
+    }
+
+  private:
+    // Disable copy-constructor and assignment operator
+    PartitionLogStorage(const PartitionLogStorage&) = delete;
+    PartitionLogStorage& operator=(const PartitionLogStorage&) = delete;
+
+    const esp_partition_t* mPartition;
+};
+
+}
+
+#endif
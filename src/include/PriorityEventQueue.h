@@ -0,0 +1,256 @@
+/*
+MIT License
+
+Copyright (c) 2026 Brian T. Park
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#ifndef ACE_BUTTON_PRIORITY_EVENT_QUEUE_H
+#define ACE_BUTTON_PRIORITY_EVENT_QUEUE_H
+
+#include <stdint.h>
+#include <atomic>
+#include "AceButton.h"
+#include "ButtonConfig.h"
+#include "ButtonEvent.h"
+#include "EventCoalescer.h"
+#include "RingBuffer.h"
+
+namespace ace_button {
+
+/**
+ * A lock-free single-producer single-consumer event queue with two priority
+ * classes, for buttons such as an emergency stop or a safety interlock whose
+ * events must never wait behind a flood of kEventRepeatPressed or
+ * kEventHeartBeat events from other buttons.
+ *
+ * An event is high priority if its button id (AceButton::getId()) was
+ * registered with setHighPriorityButton(), or if its event type is in the
+ * mask given to setHighPriorityEvents(). High priority events go into their
+ * own RingBuffer, bypassing the normal ring, and pop() always drains the high
+ * priority ring first.
+ *
+ * The worst-case delivery latency of a high priority event is therefore
+ * bounded by the time to process the event which the consumer is currently
+ * handling, plus the time to process the high priority events already queued
+ * ahead of it (at most T_HIGH_CAPACITY - 1), regardless of the number of normal
+ * events in the queue. If the high priority ring is full, the new event is
+ * dropped and counted by getHighDropCount(), so T_HIGH_CAPACITY should be
+ * sized for the worst burst of high priority events.
+ *
+ * If T_COALESCE_SLOTS is greater than 0, the kEventRepeatPressed and
+ * kEventHeartBeat events of the normal class are merged by an EventCoalescer
+ * while the consumer is behind, the other normal events are queued behind
+ * them instead of being dropped, and the producer should call flush() after
+ * each scan of its buttons.
+ *
+ * @code
+ * PriorityEventQueue<32, 4> queue;
+ *
+ * void setup() {
+ *   ...
+ *   queue.setHighPriorityButton(ESTOP_BUTTON_ID);
+ *   queue.attach(&buttonConfig);
+ * }
+ *
+ * void consumerTask() {
+ *   ButtonEvent event;
+ *   while (queue.pop(event)) {
+ *     ...
+ *   }
+ * }
+ * @endcode
+ *
+ * @tparam T_NORMAL_CAPACITY capacity of the normal ring, must be a power of 2
+ * @tparam T_HIGH_CAPACITY capacity of the high priority ring, must be a
+ *    power of 2
+ * @tparam T_COALESCE_SLOTS number of records of the EventCoalescer of the
+ *    normal ring, 0 to disable coalescing
+ */
+template <uint32_t T_NORMAL_CAPACITY, uint32_t T_HIGH_CAPACITY,
+    uint8_t T_COALESCE_SLOTS = 0>
+class PriorityEventQueue {
+  public:
+    /** Priority class of the normal ring. */
+    static const uint8_t kPriorityNormal = 0;
+
+    /** Priority class of the high priority ring. */
+    static const uint8_t kPriorityHigh = 1;
+
+    PriorityEventQueue():
+        mHighPriorityEvents(0),
+        mNormalDropCount(0),
+        mHighDropCount(0) {
+      for (uint32_t i = 0; i < kNumButtonWords; i++) {
+        mHighPriorityButtons[i] = 0;
+      }
+    }
+
+    /**
+     * Install this queue as the event handler of the ButtonConfig. All
+     * ButtonConfig instances attached to the same queue must be scanned by
+     * the same task.
+     */
+    void attach(ButtonConfig* buttonConfig) {
+      buttonConfig->setEventDelegate(
+          EventDelegate::fromMethod2<PriorityEventQueue,
+              &PriorityEventQueue::handleEvent>(this));
+    }
+
+    /**
+     * Set the event types which are always high priority, for any button. The
+     * mask contains one bit per event type, for example
+     * (1 << AceButton::kEventPressed) | (1 << AceButton::kEventLongPressed).
+     * Should be called before the producer starts.
+     */
+    void setHighPriorityEvents(uint8_t eventMask) {
+      mHighPriorityEvents = eventMask;
+    }
+
+    /** Return the mask of the high priority event types. */
+    uint8_t getHighPriorityEvents() const { return mHighPriorityEvents; }
+
+    /**
+     * Make all events of the button with the given id high priority, or
+     * normal again if isHigh is false. Should be called before the producer
+     * starts. Returns false, and changes nothing, if the id does not fit in
+     * ButtonIdType (e.g. 256 or more without ACE_BUTTON_WIDE_INDEX), so that
+     * such a button can never silently lose its priority.
+     */
+    bool setHighPriorityButton(uint32_t buttonId, bool isHigh = true) {
+      if (buttonId >= kNumButtonIds) return false;
+      uint32_t bit = (uint32_t) 1 << (buttonId & 0x1F);
+      if (isHigh) {
+        mHighPriorityButtons[buttonId >> 5] |= bit;
+      } else {
+        mHighPriorityButtons[buttonId >> 5] &= ~bit;
+      }
+      return true;
+    }
+
+    /** Return the priority class of the given event. */
+    uint8_t getPriority(ButtonIdType buttonId, uint8_t eventType) const {
+      if (mHighPriorityEvents & (1 << eventType)) return kPriorityHigh;
+      uint32_t bit = (uint32_t) 1 << (buttonId & 0x1F);
+      return (mHighPriorityButtons[buttonId >> 5] & bit)
+          ? kPriorityHigh : kPriorityNormal;
+    }
+
+    /** Queue the event in the ring of its priority class. Producer only. */
+    void handleEvent(AceButton* button, uint8_t eventType,
+        uint8_t buttonState, int64_t eventTime, int64_t duration) {
+      ButtonEvent event;
+      event.eventTime = eventTime;
+      event.button = button;
+      event.buttonId = button->getId();
+      event.pin = button->getPin();
+      event.duration = (int32_t) duration;
+      event.eventType = eventType;
+      event.buttonState = buttonState;
+      event.source = getPriority(button->getId(), eventType);
+      event.count = 1;
+      publish(event);
+    }
+
+    /**
+     * Queue the given event in the ring of the priority class given by
+     * event.source. Producer only.
+     */
+    void publish(const ButtonEvent& event) {
+      if (event.source == kPriorityHigh) {
+        if (! mHighRing.push(event)) increment(mHighDropCount);
+      } else {
+        if (! mCoalescer.publish(mNormalRing, event)) {
+          increment(mNormalDropCount);
+        }
+      }
+    }
+
+    /**
+     * Move the events held by the EventCoalescer into the normal ring if it
+     * has room. Producer only.
+     */
+    void flush() { mCoalescer.flush(mNormalRing); }
+
+    /**
+     * Remove the next event and copy it into event, taking the high priority
+     * events first. The priority class of the event is returned in
+     * event.source. Returns false if the queue is empty. Consumer only.
+     */
+    bool pop(ButtonEvent& event) {
+      if (mHighRing.pop(event)) return true;
+      return mNormalRing.pop(event);
+    }
+
+    /** Number of events in the queue, for both priority classes. */
+    uint32_t size() const { return mHighRing.size() + mNormalRing.size(); }
+
+    /** Number of high priority events in the queue. */
+    uint32_t getHighSize() const { return mHighRing.size(); }
+
+    /** Number of normal events dropped because the normal ring was full. */
+    uint32_t getNormalDropCount() const {
+      return mNormalDropCount.load(std::memory_order_relaxed);
+    }
+
+    /** Number of high priority events dropped because their ring was full. */
+    uint32_t getHighDropCount() const {
+      return mHighDropCount.load(std::memory_order_relaxed);
+    }
+
+  private:
+    // Disable copy-constructor and assignment operator
+    PriorityEventQueue(const PriorityEventQueue&) = delete;
+    PriorityEventQueue& operator=(const PriorityEventQueue&) = delete;
+
+    /**
+     * Number of distinct button ids: 256, or 65536 with
+     * ACE_BUTTON_WIDE_INDEX, which makes the bitmap 8 kB.
+     */
+    static const uint32_t kNumButtonIds = (uint32_t) 1
+        << (8 * sizeof(ButtonIdType));
+
+    /** Number of uint32_t words in the bitmap of the button ids. */
+    static const uint32_t kNumButtonWords = kNumButtonIds / 32;
+
+    /** Increment a counter owned by the producer. */
+    static void increment(std::atomic<uint32_t>& counter) {
+      counter.store(
+          counter.load(std::memory_order_relaxed) + 1,
+          std::memory_order_relaxed);
+    }
+
+    RingBuffer<ButtonEvent, T_HIGH_CAPACITY> mHighRing;
+    RingBuffer<ButtonEvent, T_NORMAL_CAPACITY> mNormalRing;
+    EventCoalescer<T_COALESCE_SLOTS> mCoalescer;
+
+    /** Bitmap of the high priority button ids. */
+    uint32_t mHighPriorityButtons[kNumButtonWords];
+
+    /** Mask of the high priority event types. */
+    uint8_t mHighPriorityEvents;
+
+    std::atomic<uint32_t> mNormalDropCount;
+    std::atomic<uint32_t> mHighDropCount;
+};
+
+}
+
+#endif
@@ -0,0 +1,211 @@
+/*
+MIT License
+
+Copyright (c) 2026 Brian T. Park
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#ifndef ACE_BUTTON_RING_BUFFER_H
+#define ACE_BUTTON_RING_BUFFER_H
+
+#include <stdint.h>
+#include <atomic>
+
+namespace ace_button {
+
+/**
+ * A lock-free, fixed-capacity, single-producer single-consumer queue. The
+ * producer (e.g. the task calling AceButton::check()) and the consumer (e.g.
+ * the application task) may run concurrently on different cores without any
+ * lock. Each side only writes its own index, and the elements are published
+ * to the other side using release/acquire ordering on that index.
+ *
+ * The indexes are free-running uint32_t counters, so the number of elements is
+ * (tail - head) even after they roll over.
+ *
+ * @tparam T type of the element, which should be trivially copyable
+ * @tparam T_CAPACITY number of elements, must be a power of 2
+ */
+template <typename T, uint32_t T_CAPACITY>
+class RingBuffer {
+  static_assert(T_CAPACITY > 0 && (T_CAPACITY & (T_CAPACITY - 1)) == 0,
+      "T_CAPACITY must be a power of 2");
+
+  public:
+    RingBuffer():
+        mHead(0),
+        mTail(0) {}
+
+    /**
+     * Append the element to the queue. Returns false if the queue is full.
+     * Producer only.
+     */
+    bool push(const T& element) {
+      uint32_t tail = mTail.load(std::memory_order_relaxed);
+      uint32_t head = mHead.load(std::memory_order_acquire);
+      if (tail - head >= T_CAPACITY) return false;
+
+      mElements[tail & kMask] = element;
+      mTail.store(tail + 1, std::memory_order_release);
+      return true;
+    }
+
+    /**
+     * Return a pointer to the element at the front of the queue, or nullptr if
+     * the queue is empty. The element remains valid until pop() is called.
+     * Consumer only.
+     */
+    const T* front() const {
+      uint32_t head = mHead.load(std::memory_order_relaxed);
+      uint32_t tail = mTail.load(std::memory_order_acquire);
+      if (head == tail) return nullptr;
+      return &mElements[head & kMask];
+    }
+
+    /**
+     * Remove the element at the front of the queue and copy it into element.
+     * Returns false if the queue is empty. Consumer only.
+     */
+    bool pop(T& element) {
+      uint32_t head = mHead.load(std::memory_order_relaxed);
+      uint32_t tail = mTail.load(std::memory_order_acquire);
+      if (head == tail) return false;
+
+      element = mElements[head & kMask];
+      mHead.store(head + 1, std::memory_order_release);
+      return true;
+    }
+
+    /**
+     * Return the number of elements in the queue. The value is exact when
+     * called from the producer or the consumer while the other side is idle,
+     * and a snapshot otherwise.
+     */
+    uint32_t size() const {
+      uint32_t tail = mTail.load(std::memory_order_acquire);
+      uint32_t head = mHead.load(std::memory_order_acquire);
+      return tail - head;
+    }
+
+    /** Return true if the queue is empty. */
+    bool isEmpty() const { return size() == 0; }
+
+    /** Return the maximum number of elements. */
+    static uint32_t getCapacity() { return T_CAPACITY; }
+
+  private:
+    // Disable copy-constructor and assignment operator
+    RingBuffer(const RingBuffer&) = delete;
+    RingBuffer& operator=(const RingBuffer&) = delete;
+
+    static const uint32_t kMask = T_CAPACITY - 1;
+
+    /** Index of the next element to pop. Written by the consumer. */
+    std::atomic<uint32_t> mHead;
+
+    /** Index of the next element to push. Written by the producer. */
+    std::atomic<uint32_t> mTail;
+
+    T mElements[T_CAPACITY];
+};
+
+/**
+ * A lock-free, single-producer single-consumer ring of bytes, e.g. the
+ * transmit buffer of a serial port. The producer appends whole blocks (e.g.
+ * frames) or nothing, and the consumer reads contiguous chunks in place, so
+ * that they can be given directly to a driver.
+ *
+ * @tparam T_CAPACITY number of bytes, must be a power of 2
+ */
+template <uint32_t T_CAPACITY>
+class ByteRingBuffer {
+  static_assert(T_CAPACITY > 0 && (T_CAPACITY & (T_CAPACITY - 1)) == 0,
+      "T_CAPACITY must be a power of 2");
+
+  public:
+    ByteRingBuffer():
+        mHead(0),
+        mTail(0) {}
+
+    /**
+     * Append all the size bytes, or none if there is not enough space.
+     * Returns false if the bytes were not appended. Producer only.
+     */
+    bool write(const uint8_t* data, uint32_t size) {
+      uint32_t tail = mTail.load(std::memory_order_relaxed);
+      uint32_t head = mHead.load(std::memory_order_acquire);
+      if (T_CAPACITY - (tail - head) < size) return false;
+
+      for (uint32_t i = 0; i < size; i++) {
+        mBytes[(tail + i) & kMask] = data[i];
+      }
+      mTail.store(tail + size, std::memory_order_release);
+      return true;
+    }
+
+    /**
+     * Return the number of contiguous bytes at the front of the ring, and set
+     * data to point to them. The bytes remain valid until consume(). Consumer
+     * only.
+     */
+    uint32_t peek(const uint8_t*& data) const {
+      uint32_t head = mHead.load(std::memory_order_relaxed);
+      uint32_t tail = mTail.load(std::memory_order_acquire);
+      uint32_t size = tail - head;
+      uint32_t contiguous = T_CAPACITY - (head & kMask);
+      data = &mBytes[head & kMask];
+      return (size < contiguous) ? size : contiguous;
+    }
+
+    /** Remove size bytes returned by peek(). Consumer only. */
+    void consume(uint32_t size) {
+      uint32_t head = mHead.load(std::memory_order_relaxed);
+      mHead.store(head + size, std::memory_order_release);
+    }
+
+    /** Return the number of bytes in the ring (a snapshot). */
+    uint32_t size() const {
+      uint32_t tail = mTail.load(std::memory_order_acquire);
+      uint32_t head = mHead.load(std::memory_order_acquire);
+      return tail - head;
+    }
+
+    /** Return the maximum number of bytes. */
+    static uint32_t getCapacity() { return T_CAPACITY; }
+
+  private:
+    // Disable copy-constructor and assignment operator
+    ByteRingBuffer(const ByteRingBuffer&) = delete;
+    ByteRingBuffer& operator=(const ByteRingBuffer&) = delete;
+
+    static const uint32_t kMask = T_CAPACITY - 1;
+
+    /** Index of the next byte to read. Written by the consumer. */
+    std::atomic<uint32_t> mHead;
+
+    /** Index of the next byte to write. Written by the producer. */
+    std::atomic<uint32_t> mTail;
+
+    uint8_t mBytes[T_CAPACITY];
+};
+
+}
+
+#endif
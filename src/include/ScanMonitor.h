@@ -0,0 +1,158 @@
+/*
+MIT License
+
+Copyright (c) 2026 Brian T. Park
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#ifndef ACE_BUTTON_SCAN_MONITOR_H
+#define ACE_BUTTON_SCAN_MONITOR_H
+
+#include <stdint.h>
+#include <atomic>
+#include "LatencyHistogram.h"
+
+/**
+ * Set to 1 to measure the interval between consecutive scans of the buttons of
+ * each ButtonConfig in a ScanMonitor. Must be defined identically for all
+ * translation units. When 0 (the default), no code is compiled in.
+ */
+#ifndef ACE_BUTTON_ENABLE_SCAN_MONITOR
+  #define ACE_BUTTON_ENABLE_SCAN_MONITOR 0
+#endif
+
+namespace ace_button {
+
+class ButtonCore;
+
+/**
+ * Detects when the buttons of a ButtonConfig are not scanned often enough. The
+ * debouncing and the click timing assume that AceButton::check() is called at
+ * least every getDebounceDelay() / 4 milliseconds. A late scan usually means
+ * that other tasks of the same or higher priority starve the scanning task.
+ *
+ * A scan is a pass over all the buttons of the ButtonConfig. The first button
+ * checked after a reset becomes the lead button, and the interval between two
+ * consecutive checks of the lead button is the scan interval. The monitor
+ * records the largest interval, a LatencyHistogram of the intervals in
+ * milliseconds, and the number of intervals longer than
+ * getDebounceDelay() / 4.
+ *
+ * Updated by the scanning task only. The counters and the histogram can be
+ * read from any task.
+ */
+class ScanMonitor {
+  public:
+    /** The histogram of the scan intervals, in milliseconds. */
+    typedef LatencyHistogram<2> GapHistogram;
+
+    constexpr ScanMonitor():
+        mLead(nullptr),
+        mLastScanTime(0),
+        mResetRequested(false),
+        mNumScans(0),
+        mNumLateScans(0),
+        mMaxGap(0) {}
+
+    /**
+     * Record a check of the button at the clock time now. Called by
+     * AceButton::checkState(). Scanning task only.
+     */
+    void recordScan(const ButtonCore* button, int64_t now,
+        int64_t debounceDelay) {
+      if (mResetRequested.load(std::memory_order_relaxed)) {
+        mResetRequested.store(false, std::memory_order_relaxed);
+        mLead = nullptr;
+        mNumScans.store(0, std::memory_order_relaxed);
+        mNumLateScans.store(0, std::memory_order_relaxed);
+        mMaxGap.store(0, std::memory_order_relaxed);
+        mGaps.requestReset();
+      }
+
+      if (mLead == nullptr) {
+        mLead = button;
+        mLastScanTime = now;
+        return;
+      }
+      if (button != mLead) return;
+
+      int64_t gap64 = now - mLastScanTime;
+      mLastScanTime = now;
+      uint32_t gap = (gap64 < 0) ? 0
+          : (gap64 > (int64_t) UINT32_MAX) ? UINT32_MAX : (uint32_t) gap64;
+
+      mGaps.record(gap);
+      increment(mNumScans);
+      if (gap > mMaxGap.load(std::memory_order_relaxed)) {
+        mMaxGap.store(gap, std::memory_order_relaxed);
+      }
+      if ((int64_t) gap * 4 > debounceDelay) increment(mNumLateScans);
+    }
+
+    /** Number of scan intervals measured. */
+    uint32_t getNumScans() const {
+      return mNumScans.load(std::memory_order_relaxed);
+    }
+
+    /** Number of scan intervals longer than getDebounceDelay() / 4. */
+    uint32_t getNumLateScans() const {
+      return mNumLateScans.load(std::memory_order_relaxed);
+    }
+
+    /** Largest scan interval, in milliseconds. */
+    uint32_t getMaxGap() const {
+      return mMaxGap.load(std::memory_order_relaxed);
+    }
+
+    /** The histogram of the scan intervals, in milliseconds. */
+    const GapHistogram& getGaps() const { return mGaps; }
+
+    /**
+     * Ask the scanning task to clear the measurements and to latch a new lead
+     * button at its next check. Safe to call from any task.
+     */
+    void requestReset() {
+      mResetRequested.store(true, std::memory_order_relaxed);
+    }
+
+  private:
+    // Disable copy-constructor and assignment operator
+    ScanMonitor(const ScanMonitor&) = delete;
+    ScanMonitor& operator=(const ScanMonitor&) = delete;
+
+    /** Increment a counter owned by the scanning task. */
+    static void increment(std::atomic<uint32_t>& counter) {
+      counter.store(
+          counter.load(std::memory_order_relaxed) + 1,
+          std::memory_order_relaxed);
+    }
+
+    const ButtonCore* mLead;
+    int64_t mLastScanTime;
+    std::atomic<bool> mResetRequested;
+    std::atomic<uint32_t> mNumScans;
+    std::atomic<uint32_t> mNumLateScans;
+    std::atomic<uint32_t> mMaxGap;
+    GapHistogram mGaps;
+};
+
+}
+
+#endif
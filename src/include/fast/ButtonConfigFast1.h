@@ -40,7 +40,7 @@ namespace ace_button {
 template <uint8_t T_PIN0>
 class ButtonConfigFast1 : public ButtonConfig {
   public:
-    int readButton(uint8_t /*pin*/) override {
+    int readButton(ButtonPinType /*pin*/) override {
       return digitalReadFast(T_PIN0);
     }
 };
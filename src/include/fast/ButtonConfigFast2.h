@@ -41,7 +41,7 @@ namespace ace_button {
 template <uint8_t T_PIN0, uint8_t T_PIN1>
 class ButtonConfigFast2 : public ButtonConfig {
   public:
-    int readButton(uint8_t pin) override {
+    int readButton(ButtonPinType pin) override {
       // Using nested if-else statements instead of switch saves 2 bytes of
       // flash on an AVR. Not worth it.
       switch (pin) {
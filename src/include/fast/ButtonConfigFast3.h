@@ -42,7 +42,7 @@ namespace ace_button {
 template <uint8_t T_PIN0, uint8_t T_PIN1, uint8_t T_PIN2>
 class ButtonConfigFast3 : public ButtonConfig {
   public:
-    int readButton(uint8_t pin) override {
+    int readButton(ButtonPinType pin) override {
       switch (pin) {
         case 0:
           return digitalReadFast(T_PIN0);
@@ -0,0 +1,126 @@
+/*
+MIT License
+
+Copyright (c) 2026 Brian T. Park
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#ifndef ACE_BUTTON_BOUNCE_SIMULATOR_H
+#define ACE_BUTTON_BOUNCE_SIMULATOR_H
+
+#include <../include/AceButton.h>
+#include <TestableButtonConfig.h>
+
+namespace ace_button {
+namespace testing {
+
+/**
+ * Simulates the contact bounce of a mechanical button, and scans an AceButton
+ * at a fixed interval like a loop() would. A transition() toggles the raw
+ * level of the button numBounces times, every bounceInterval milliseconds,
+ * before it settles to the new level. If interrupts are simulated, the first
+ * raw edge of each transition is passed to AceButton::markEdge() as a GPIO
+ * interrupt handler would.
+ */
+class BounceSimulator {
+  public:
+    BounceSimulator(
+        TestableButtonConfig* testableConfig,
+        AceButton* button,
+        uint8_t scanInterval):
+      mTestableConfig(testableConfig),
+      mButton(button),
+      mScanInterval(scanInterval) {}
+
+    /** Reset the simulation to the given raw level at time 0. */
+    void init(uint8_t level, bool simulateInterrupts = false) {
+      mNow = 0;
+      mLevel = level;
+      mPreviousLevel = level;
+      mEdgeTime = 0;
+      mNumBounces = 0;
+      mBounceInterval = 1;
+      mInterruptPending = false;
+      mSimulateInterrupts = simulateInterrupts;
+    }
+
+    /**
+     * Schedule a transition to the raw level, starting at edgeTime, which
+     * must not be earlier than the current simulated time.
+     */
+    void transition(int64_t edgeTime, uint8_t level, uint8_t numBounces,
+        uint8_t bounceInterval) {
+      mPreviousLevel = readLevel(edgeTime);
+      mEdgeTime = edgeTime;
+      mLevel = level;
+      mNumBounces = numBounces;
+      mBounceInterval = bounceInterval;
+      mInterruptPending = mSimulateInterrupts;
+    }
+
+    /** Scan the button every scanInterval until the given time. */
+    void runUntil(int64_t until) {
+      while (mNow + mScanInterval <= until) {
+        mNow += mScanInterval;
+        if (mInterruptPending && mEdgeTime <= mNow) {
+          mInterruptPending = false;
+        #if ACE_BUTTON_ENABLE_EDGE_LATENCY
+          mButton->markEdge((uint32_t) mEdgeTime);
+        #endif
+        }
+        mTestableConfig->setClock(mNow);
+        mButton->checkState(readLevel(mNow));
+      }
+    }
+
+    /** Return the raw level of the button at the given time. */
+    uint8_t readLevel(int64_t time) const {
+      if (time < mEdgeTime) return mPreviousLevel;
+      int64_t elapsed = time - mEdgeTime;
+      if (elapsed >= (int64_t) mNumBounces * mBounceInterval) return mLevel;
+      // The level toggles at each bounce, starting with the new level.
+      return ((elapsed / mBounceInterval) % 2 == 0) ? mLevel : mPreviousLevel;
+    }
+
+    /** Return the current simulated time. */
+    int64_t getNow() const { return mNow; }
+
+  private:
+    // Disable copy-constructor and assignment operator
+    BounceSimulator(const BounceSimulator&) = delete;
+    BounceSimulator& operator=(const BounceSimulator&) = delete;
+
+    TestableButtonConfig* mTestableConfig;
+    AceButton* mButton;
+    uint8_t mScanInterval;
+
+    int64_t mNow;
+    int64_t mEdgeTime;
+    uint8_t mLevel;
+    uint8_t mPreviousLevel;
+    uint8_t mNumBounces;
+    uint8_t mBounceInterval;
+    bool mInterruptPending;
+    bool mSimulateInterrupts;
+};
+
+}
+}
+#endif
@@ -0,0 +1,209 @@
+/*
+MIT License
+
+Copyright (c) 2026 Brian T. Park
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#ifndef ACE_BUTTON_DISCRETE_EVENT_SIMULATOR_H
+#define ACE_BUTTON_DISCRETE_EVENT_SIMULATOR_H
+
+#include <stdint.h>
+#include <../include/AceButton.h>
+#include <TestableButtonConfig.h>
+
+namespace ace_button {
+namespace testing {
+
+/**
+ * A host simulator which owns the clock of a TestableButtonConfig and jumps it
+ * directly to the next time at which something can happen, instead of
+ * checking the buttons at every scan interval.
+ *
+ * The simulated loop checks all buttons every scanInterval milliseconds,
+ * starting at time 0. An event calendar holds the scheduled changes of the
+ * raw button levels. The next visited scan is the first one at or after the
+ * earliest of the next input change and of AceButton::getNextDeadline() of
+ * every button. The skipped scans would not have changed anything, so the
+ * dispatched events and their times are the same as with polling at the scan
+ * interval, but a week of button activity runs in milliseconds.
+ *
+ * @tparam T_NUM_BUTTONS maximum number of buttons
+ * @tparam T_CALENDAR_SIZE maximum number of pending input changes
+ */
+template <uint8_t T_NUM_BUTTONS, uint32_t T_CALENDAR_SIZE>
+class DiscreteEventSimulator {
+  public:
+    DiscreteEventSimulator(
+        TestableButtonConfig* testableConfig,
+        uint32_t scanInterval):
+      mTestableConfig(testableConfig),
+      mScanInterval(scanInterval) {
+      init();
+    }
+
+    /** Remove the buttons and the pending changes, and reset the clock to 0. */
+    void init() {
+      mNow = 0;
+      mStarted = false;
+      mNumButtons = 0;
+      mCalendarSize = 0;
+      mSequence = 0;
+      mNumScans = 0;
+      mTestableConfig->setClock(0);
+    }
+
+    /** Add a button with its initial raw level. Returns its index. */
+    uint8_t addButton(AceButton* button, uint8_t level) {
+      mButtons[mNumButtons] = button;
+      mLevels[mNumButtons] = level;
+      return mNumButtons++;
+    }
+
+    /**
+     * Schedule a change of the raw level of the button at the given index.
+     * Changes may be scheduled in any order, but not before the current time.
+     * Returns false if the calendar is full.
+     */
+    bool schedule(int64_t time, uint8_t index, uint8_t level) {
+      if (mCalendarSize >= T_CALENDAR_SIZE) return false;
+
+      // Sift up in the binary min-heap.
+      InputChange change = {time, mSequence++, index, level};
+      uint32_t i = mCalendarSize++;
+      while (i > 0) {
+        uint32_t parent = (i - 1) / 2;
+        if (! isBefore(change, mCalendar[parent])) break;
+        mCalendar[i] = mCalendar[parent];
+        i = parent;
+      }
+      mCalendar[i] = change;
+      return true;
+    }
+
+    /** Number of pending input changes. */
+    uint32_t getCalendarSize() const { return mCalendarSize; }
+
+    /**
+     * Run the scans up to and including the given time. The clock is left at
+     * the last visited scan.
+     */
+    void runUntil(int64_t until) {
+      while (true) {
+        int64_t next = nextScan();
+        if (next > until) break;
+        scan(next);
+      }
+    }
+
+    /** Return the time of the last visited scan. */
+    int64_t getNow() const { return mNow; }
+
+    /** Number of scans actually performed. */
+    uint64_t getNumScans() const { return mNumScans; }
+
+  private:
+    // Disable copy-constructor and assignment operator
+    DiscreteEventSimulator(const DiscreteEventSimulator&) = delete;
+    DiscreteEventSimulator& operator=(const DiscreteEventSimulator&) = delete;
+
+    /** A scheduled change of a raw button level. */
+    struct InputChange {
+      int64_t time;
+      uint32_t sequence; // keeps the scheduling order of simultaneous changes
+      uint8_t index;
+      uint8_t level;
+    };
+
+    /** Return the first scan time at or after the given time. */
+    int64_t scanAtOrAfter(int64_t time) const {
+      int64_t first = mStarted ? mNow + mScanInterval : 0;
+      if (time <= first) return first;
+      int64_t intervals = (time + mScanInterval - 1) / mScanInterval;
+      return intervals * mScanInterval;
+    }
+
+    int64_t nextScan() const {
+      int64_t deadline = AceButton::kNoDeadline;
+      if (mCalendarSize > 0) deadline = mCalendar[0].time;
+      for (uint8_t i = 0; i < mNumButtons; i++) {
+        int64_t buttonDeadline = mButtons[i]->getNextDeadline();
+        if (buttonDeadline < deadline) deadline = buttonDeadline;
+      }
+      if (deadline == AceButton::kNoDeadline) return deadline;
+      return scanAtOrAfter(deadline);
+    }
+
+    void scan(int64_t now) {
+      mNow = now;
+      mStarted = true;
+      mNumScans++;
+      while (mCalendarSize > 0 && mCalendar[0].time <= now) {
+        mLevels[mCalendar[0].index] = mCalendar[0].level;
+        popCalendar();
+      }
+      mTestableConfig->setClock(now);
+      for (uint8_t i = 0; i < mNumButtons; i++) {
+        mButtons[i]->checkState(mLevels[i]);
+      }
+    }
+
+    /** Remove the earliest change, sifting down the last one. */
+    void popCalendar() {
+      InputChange last = mCalendar[--mCalendarSize];
+      uint32_t i = 0;
+      while (true) {
+        uint32_t child = 2 * i + 1;
+        if (child >= mCalendarSize) break;
+        if (child + 1 < mCalendarSize
+            && isBefore(mCalendar[child + 1], mCalendar[child])) {
+          child++;
+        }
+        if (! isBefore(mCalendar[child], last)) break;
+        mCalendar[i] = mCalendar[child];
+        i = child;
+      }
+      mCalendar[i] = last;
+    }
+
+    static bool isBefore(const InputChange& a, const InputChange& b) {
+      return (a.time < b.time)
+          || (a.time == b.time && a.sequence < b.sequence);
+    }
+
+    TestableButtonConfig* mTestableConfig;
+    uint32_t mScanInterval;
+
+    int64_t mNow;
+    bool mStarted;
+    uint64_t mNumScans;
+
+    AceButton* mButtons[T_NUM_BUTTONS];
+    uint8_t mLevels[T_NUM_BUTTONS];
+    uint8_t mNumButtons;
+
+    InputChange mCalendar[T_CALENDAR_SIZE];
+    uint32_t mCalendarSize;
+    uint32_t mSequence;
+};
+
+}
+}
+#endif
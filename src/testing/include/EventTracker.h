@@ -38,12 +38,12 @@ class EventRecord {
         mEventType(0),
         mButtonState(LOW) {}
 
-    EventRecord(uint8_t pin, uint8_t eventType, uint8_t buttonState):
+    EventRecord(ButtonPinType pin, uint8_t eventType, uint8_t buttonState):
         mPin(pin),
         mEventType(eventType),
         mButtonState(buttonState) {}
 
-    uint8_t getPin() const {
+    ButtonPinType getPin() const {
       return mPin;
     }
 
@@ -62,7 +62,7 @@ class EventRecord {
     EventRecord& operator=(const EventRecord&) = default;
 
   private:
-    uint8_t mPin;
+    ButtonPinType mPin;
     uint8_t mEventType;
     uint8_t mButtonState;
 };
@@ -78,7 +78,7 @@ class EventTracker {
         mNumEvents(0) {}
       
     /** Add event to a buffer of records, stopping when the buffer fills up. */
-    void addEvent(uint8_t pin, uint8_t eventType, uint8_t buttonState) {
+    void addEvent(ButtonPinType pin, uint8_t eventType, uint8_t buttonState) {
       if (mNumEvents < kMaxEvents) {
         mRecords[mNumEvents] = EventRecord(pin, eventType, buttonState);
         mNumEvents++;
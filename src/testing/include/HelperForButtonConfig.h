@@ -48,7 +48,8 @@ class HelperForButtonConfig {
       mEventTracker(eventTracker) {}
 
     /** Reinitilize to its pristine state. */
-    void init(uint8_t pin, uint8_t defaultReleasedState, uint8_t id) {
+    void init(ButtonPinType pin, uint8_t defaultReleasedState,
+        ButtonIdType id) {
       mPin = pin;
       mDefaultReleasedState = defaultReleasedState;
       mId = id;
@@ -99,9 +100,9 @@ class HelperForButtonConfig {
     AceButton* mButton;
     EventTracker* mEventTracker;
 
-    uint8_t mPin;
+    ButtonPinType mPin;
     uint8_t mDefaultReleasedState;
-    uint8_t mId;
+    ButtonIdType mId;
 };
 
 }
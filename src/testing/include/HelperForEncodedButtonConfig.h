@@ -56,7 +56,7 @@ class HelperForEncodedButtonConfig {
      * defaultReleasedState is determined by whether the button has a pullup
      * (HIGH) or pulldown (LOW) resistor.
      */
-    void pressButton(unsigned long time, uint8_t virtualPin) {
+    void pressButton(unsigned long time, ButtonPinType virtualPin) {
       mTestableConfig->setClock(time);
       mTestableConfig->setVirtualPin(virtualPin);
       mEventTracker->clear();
@@ -0,0 +1,253 @@
+/*
+MIT License
+
+Copyright (c) 2026 Brian T. Park
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#ifndef ACE_BUTTON_RING_EVENT_TRACKER_H
+#define ACE_BUTTON_RING_EVENT_TRACKER_H
+
+#include <stdint.h>
+#include <string.h>
+#include <../include/AceButton.h>
+
+namespace ace_button {
+namespace testing {
+
+/**
+ * A compact 8-byte record of an AceButton event (12 bytes if
+ * ACE_BUTTON_WIDE_INDEX is 1), with the lower 32 bits of the event time in
+ * milliseconds. Used by RingEventTracker for long replay and stress tests.
+ */
+struct TimedEventRecord {
+  /** Lower 32 bits of the eventTime, in milliseconds. */
+  uint32_t time;
+
+  /** AceButton::getId() */
+  ButtonIdType buttonId;
+
+  /** AceButton::getPin() */
+  ButtonPinType pin;
+
+  /** AceButton::kEventXxx */
+  uint8_t eventType;
+
+  /** HIGH or LOW */
+  uint8_t buttonState;
+};
+
+static_assert(sizeof(TimedEventRecord) == (ACE_BUTTON_WIDE_INDEX ? 12 : 8),
+    "TimedEventRecord must be 8 bytes, or 12 bytes with wide indexes");
+
+/**
+ * The first difference found by RingEventTracker::compare(). If matched is
+ * true, the other fields are not valid.
+ */
+struct EventDivergence {
+  /** True if the sequences are identical. */
+  bool matched;
+
+  /**
+   * Index of the first differing event, counted from the oldest event
+   * retained by the tracker. Equal to the length of the shorter sequence if
+   * one is a prefix of the other.
+   */
+  uint32_t index;
+
+  /** The expected record at index, zero if past the expected sequence. */
+  TimedEventRecord expected;
+
+  /** The recorded record at index, zero if past the recorded sequence. */
+  TimedEventRecord actual;
+};
+
+/**
+ * An event tracker for stress tests, which keeps the last T_CAPACITY events in
+ * a ring buffer of TimedEventRecord. When the buffer is full, the oldest event
+ * is overwritten and counted in getNumDropped(). The recorded sequence is
+ * compared in bulk against an expected sequence with compare().
+ *
+ * Usage:
+ *
+ * @code{.cpp}
+ * RingEventTracker<1024> tracker;
+ *
+ * void setup() {
+ *   tracker.attach(&buttonConfig);
+ *   ... // replay
+ *   EventDivergence d = tracker.compare(expected, numExpected);
+ * }
+ * @endcode
+ *
+ * @tparam T_CAPACITY number of records, a power of 2
+ */
+template <uint32_t T_CAPACITY>
+class RingEventTracker {
+  static_assert(T_CAPACITY > 0 && (T_CAPACITY & (T_CAPACITY - 1)) == 0,
+      "T_CAPACITY must be a power of 2");
+
+  public:
+    RingEventTracker():
+        mHead(0),
+        mNumEvents(0) {}
+
+    /** Install the tracker as the event handler of the ButtonConfig. */
+    void attach(ButtonConfig* buttonConfig) {
+      buttonConfig->setEventDelegate(
+          EventDelegate::fromMethod2<RingEventTracker,
+              &RingEventTracker::handleEvent>(this));
+    }
+
+    /** Event handler which records the event. */
+    void handleEvent(AceButton* button, uint8_t eventType,
+        uint8_t buttonState, int64_t eventTime, int64_t /*duration*/) {
+      addEvent(button->getId(), button->getPin(), eventType, buttonState,
+          eventTime);
+    }
+
+    /** Add an event, overwriting the oldest one if the buffer is full. */
+    void addEvent(ButtonIdType buttonId, ButtonPinType pin, uint8_t eventType,
+        uint8_t buttonState, int64_t eventTime) {
+      TimedEventRecord& record = mRecords[mHead];
+      record.time = (uint32_t) eventTime;
+      record.buttonId = buttonId;
+      record.pin = pin;
+      record.eventType = eventType;
+      record.buttonState = buttonState;
+      mHead = (mHead + 1) & kMask;
+      mNumEvents++;
+    }
+
+    /** Forget all events. */
+    void clear() {
+      mHead = 0;
+      mNumEvents = 0;
+    }
+
+    /** Number of events retained, at most T_CAPACITY. */
+    uint32_t size() const {
+      return (mNumEvents < T_CAPACITY) ? (uint32_t) mNumEvents : T_CAPACITY;
+    }
+
+    /** Total number of events since the last clear(). */
+    uint64_t getNumEvents() const { return mNumEvents; }
+
+    /** Number of events overwritten since the last clear(). */
+    uint64_t getNumDropped() const { return mNumEvents - size(); }
+
+    /** Return the i-th retained event, 0 being the oldest. */
+    const TimedEventRecord& getRecord(uint32_t i) const {
+      return mRecords[(oldest() + i) & kMask];
+    }
+
+    /**
+     * Compare the retained events with the expected sequence, field by field.
+     * The times may differ by up to timeTolerance milliseconds. Returns the
+     * first divergence, including a difference of lengths.
+     */
+    EventDivergence compare(const TimedEventRecord* expected,
+        uint32_t numExpected, uint32_t timeTolerance = 0) const {
+      EventDivergence result;
+      uint32_t numActual = size();
+      uint32_t n = (numActual < numExpected) ? numActual : numExpected;
+
+      // The retained events are at most 2 contiguous segments of the ring.
+      uint32_t start = oldest();
+      uint32_t firstLength = T_CAPACITY - start;
+      if (firstLength > n) firstLength = n;
+      uint32_t index = findMismatch(
+          &mRecords[start], expected, firstLength, timeTolerance);
+      if (index == firstLength && firstLength < n) {
+        index += findMismatch(mRecords, expected + firstLength,
+            n - firstLength, timeTolerance);
+      }
+
+      if (index == n && numActual == numExpected) {
+        memset(&result, 0, sizeof(result));
+        result.matched = true;
+        return result;
+      }
+
+      result.matched = false;
+      result.index = index;
+      if (index < numExpected) {
+        result.expected = expected[index];
+      } else {
+        memset(&result.expected, 0, sizeof(result.expected));
+      }
+      if (index < numActual) {
+        result.actual = getRecord(index);
+      } else {
+        memset(&result.actual, 0, sizeof(result.actual));
+      }
+      return result;
+    }
+
+  private:
+    // Disable copy-constructor and assignment operator
+    RingEventTracker(const RingEventTracker&) = delete;
+    RingEventTracker& operator=(const RingEventTracker&) = delete;
+
+    static const uint32_t kMask = T_CAPACITY - 1;
+
+    /** Ring index of the oldest retained event. */
+    uint32_t oldest() const {
+      return (mNumEvents < T_CAPACITY) ? 0 : mHead;
+    }
+
+    /**
+     * Return the index of the first mismatch in the n records, or n. An exact
+     * comparison is done with memcmp() on blocks, then narrowed down.
+     */
+    static uint32_t findMismatch(const TimedEventRecord* actual,
+        const TimedEventRecord* expected, uint32_t n, uint32_t timeTolerance) {
+      const uint32_t kBlock = 64;
+      uint32_t i = 0;
+      if (timeTolerance == 0) {
+        while (i + kBlock <= n && memcmp(&actual[i], &expected[i],
+            kBlock * sizeof(TimedEventRecord)) == 0) {
+          i += kBlock;
+        }
+      }
+      for (; i < n; i++) {
+        if (! isMatch(actual[i], expected[i], timeTolerance)) return i;
+      }
+      return n;
+    }
+
+    static bool isMatch(const TimedEventRecord& a, const TimedEventRecord& b,
+        uint32_t timeTolerance) {
+      uint32_t dt = (a.time > b.time) ? a.time - b.time : b.time - a.time;
+      return dt <= timeTolerance
+          && a.buttonId == b.buttonId
+          && a.pin == b.pin
+          && a.eventType == b.eventType
+          && a.buttonState == b.buttonState;
+    }
+
+    TimedEventRecord mRecords[T_CAPACITY];
+    uint32_t mHead;
+    uint64_t mNumEvents;
+};
+
+}
+}
+#endif
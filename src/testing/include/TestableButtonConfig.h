@@ -53,9 +53,9 @@ class TestableButtonConfig: public ButtonConfig {
       mButtonState = HIGH;
     }
 
-    unsigned long getClock() override { return mMillis; }
+    int64_t getClock() override { return mMillis; }
 
-    int readButton(uint8_t /* pin */) override { return mButtonState; }
+    int readButton(ButtonPinType /* pin */) override { return mButtonState; }
 
     /** Set the time of the fake clock. */
     void setClock(unsigned long millis) { mMillis = millis; }
@@ -0,0 +1,72 @@
+/*
+MIT License
+
+Copyright (c) 2026 Brian T. Park
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#ifndef ACE_BUTTON_TESTABLE_BUTTON_PANEL_H
+#define ACE_BUTTON_TESTABLE_BUTTON_PANEL_H
+
+#include "../include/ButtonPanel.h"
+
+namespace ace_button {
+namespace testing {
+
+/**
+ * A subclass of ButtonPanel which overrides getClock() and getVirtualPin() so
+ * that their values can be controlled manually. This is intended to be used
+ * for unit testing. Like ButtonPanel, it can be constant-initialized.
+ */
+template <const auto& T_PANEL>
+class TestableButtonPanel: public ButtonPanel<T_PANEL> {
+  public:
+    constexpr TestableButtonPanel():
+        mMillis(0),
+        mVirtualPin(T_PANEL.getNoButtonPin()) {}
+
+    /**
+     * Initialize to its pristine state. This method is needed because AUnit
+     * does not create a new instance of the Test class for each test case.
+     */
+    void init() {
+      this->resetFeatures();
+      mMillis = 0;
+      mVirtualPin = T_PANEL.getNoButtonPin();
+    }
+
+    int64_t getClock() override { return mMillis; }
+
+    ButtonPinType getVirtualPin() const override { return mVirtualPin; }
+
+    /** Set the time of the fake clock. */
+    void setClock(unsigned long millis) { mMillis = millis; }
+
+    /** Set the virtual pin number of the pressed button. */
+    void setVirtualPin(ButtonPinType pin) { mVirtualPin = pin; }
+
+  private:
+    unsigned long mMillis;
+    ButtonPinType mVirtualPin;
+};
+
+}
+}
+#endif
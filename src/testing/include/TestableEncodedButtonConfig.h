@@ -38,7 +38,15 @@ namespace testing {
 class TestableEncodedButtonConfig: public EncodedButtonConfig {
   public:
     TestableEncodedButtonConfig(uint8_t numPins, uint8_t const pins[],
-        uint8_t numButtons, AceButton* const buttons[],
+        ButtonCountType numButtons, AceButton* const buttons[],
+        uint8_t defaultReleasedState = HIGH):
+      EncodedButtonConfig(numPins, pins, numButtons, buttons,
+        defaultReleasedState),
+      mMillis(0),
+      mVirtualPin(0) {}
+
+    TestableEncodedButtonConfig(uint8_t numPins, uint8_t const pins[],
+        ButtonCountType numButtons, AceButton buttons[],
         uint8_t defaultReleasedState = HIGH):
       EncodedButtonConfig(numPins, pins, numButtons, buttons,
         defaultReleasedState),
@@ -57,15 +65,15 @@ class TestableEncodedButtonConfig: public EncodedButtonConfig {
       mVirtualPin = 0;
     }
 
-    unsigned long getClock() override { return mMillis; }
+    int64_t getClock() override { return mMillis; }
 
-    uint8_t getVirtualPin() const override { return mVirtualPin; }
+    ButtonPinType getVirtualPin() const override { return mVirtualPin; }
 
     /** Set the time of the fake clock. */
     void setClock(unsigned long millis) { mMillis = millis; }
 
     /** Set the virtual pin number. 0 means "no button pressed". */
-    void setVirtualPin(uint8_t pin) { mVirtualPin = pin; }
+    void setVirtualPin(ButtonPinType pin) { mVirtualPin = pin; }
 
   private:
     // Disable copy-constructor and assignment operator
@@ -74,7 +82,7 @@ class TestableEncodedButtonConfig: public EncodedButtonConfig {
       = delete;
 
     unsigned long mMillis;
-    uint8_t mVirtualPin;
+    ButtonPinType mVirtualPin;
 };
 
 }
@@ -0,0 +1,205 @@
+#line 2 "ButtonArrayTest.ino"
+
+#include <AUnit.h>
+#include <AceButton.h>
+#include <ButtonArray.h>
+#include <ace_button/testing/TestableButtonConfig.h>
+#include <ace_button/testing/TestableEncodedButtonConfig.h>
+#include <ace_button/testing/RingEventTracker.h>
+
+using namespace aunit;
+using namespace ace_button;
+using namespace ace_button::testing;
+
+// --------------------------------------------------------------------------
+
+TestableButtonConfig testableConfig;
+RingEventTracker<64> tracker;
+
+// A board description, as it could be read at runtime.
+struct BoardButton {
+  uint8_t pin;
+  uint8_t id;
+};
+
+const BoardButton BOARD[] = {{1, 10}, {2, 11}, {3, 12}, {5, 13}};
+const uint8_t NUM_BOARD_BUTTONS = sizeof(BOARD) / sizeof(BOARD[0]);
+
+const uint8_t ENCODER_PINS[] = {2, 3, 4};
+TestableEncodedButtonConfig encodedConfig(
+    3, ENCODER_PINS, 0, (AceButton*) nullptr);
+
+void setup() {
+#if ! defined(EPOXY_DUINO)
+  delay(1000); // wait to prevent garbage on SERIAL_PORT_MONITOR
+#endif
+
+  SERIAL_PORT_MONITOR.begin(115200);
+  while (!SERIAL_PORT_MONITOR); // wait until ready - Leonardo/Micro only
+}
+
+void loop() {
+  TestRunner::run();
+}
+
+// --------------------------------------------------------------------------
+
+test(ButtonArray, move_keeps_state) {
+  testableConfig.init();
+  tracker.clear();
+  tracker.attach(&testableConfig);
+
+  AceButton original(&testableConfig, 7, HIGH, 3);
+  testableConfig.setClock(0);
+  original.checkState(HIGH);
+  testableConfig.setClock(50);
+  original.checkState(HIGH);
+  testableConfig.setClock(100);
+  original.checkState(LOW);
+  testableConfig.setClock(120);
+  original.checkState(LOW);
+  assertEqual((uint32_t) 1, tracker.size());
+
+  // The moved button is still pressed, and releases normally.
+  AceButton moved(std::move(original));
+  assertTrue(moved.getButtonConfig() == &testableConfig);
+  assertEqual((uint8_t) 7, moved.getPin());
+  assertEqual((uint8_t) 3, moved.getId());
+  assertEqual(LOW, moved.getLastButtonState());
+
+  testableConfig.setClock(200);
+  moved.checkState(HIGH);
+  testableConfig.setClock(220);
+  moved.checkState(HIGH);
+  assertEqual((uint32_t) 2, tracker.size());
+  assertEqual(AceButton::kEventReleased, tracker.getRecord(1).eventType);
+  assertEqual((uint8_t) 3, tracker.getRecord(1).buttonId);
+}
+
+test(ButtonArray, add_and_remove) {
+  ButtonArray<4> buttons;
+  for (uint8_t i = 0; i < NUM_BOARD_BUTTONS; i++) {
+    assertTrue(buttons.add(&testableConfig, BOARD[i].pin, HIGH, BOARD[i].id)
+        != nullptr);
+  }
+  assertEqual((uint16_t) 4, buttons.size());
+  assertTrue(buttons.add(AceButton(&testableConfig)) == nullptr);
+
+  // Stored contiguously.
+  assertTrue(&buttons[3] == buttons.data() + 3);
+
+  // The last button is relocated into the removed slot.
+  buttons.remove(1);
+  assertEqual((uint16_t) 3, buttons.size());
+  assertEqual((uint8_t) 10, buttons[0].getId());
+  assertEqual((uint8_t) 13, buttons[1].getId());
+  assertEqual((uint8_t) 5, buttons[1].getPin());
+  assertEqual((uint8_t) 12, buttons[2].getId());
+
+  uint16_t count = 0;
+  for (AceButton& button : buttons) {
+    assertTrue(button.getButtonConfig() == &testableConfig);
+    count++;
+  }
+  assertEqual((uint16_t) 3, count);
+
+  // Out of range indexes are rejected.
+  assertFalse(buttons.remove(3));
+  assertEqual((uint16_t) 3, buttons.size());
+
+  buttons.clear();
+  assertEqual((uint16_t) 0, buttons.size());
+  assertFalse(buttons.remove(0));
+  assertEqual((uint16_t) 0, buttons.size());
+}
+
+test(ButtonArray, encoded_config_uses_array) {
+  ButtonArray<4> buttons;
+  for (uint8_t i = 0; i < NUM_BOARD_BUTTONS; i++) {
+    buttons.add(nullptr, BOARD[i].pin, HIGH, BOARD[i].id);
+  }
+  encodedConfig.init();
+  encodedConfig.setButtons(buttons.size(), buttons.data());
+  assertTrue(buttons[2].getButtonConfig() == &encodedConfig);
+
+  tracker.clear();
+  tracker.attach(&encodedConfig);
+
+  encodedConfig.setVirtualPin(0);
+  encodedConfig.setClock(0);
+  encodedConfig.checkButtons();
+  encodedConfig.setClock(50);
+  encodedConfig.checkButtons();
+
+  // Press the button on virtual pin 3.
+  encodedConfig.setVirtualPin(3);
+  encodedConfig.setClock(100);
+  encodedConfig.checkButtons();
+  encodedConfig.setClock(120);
+  encodedConfig.checkButtons();
+
+  assertEqual((uint32_t) 1, tracker.size());
+  assertEqual((uint8_t) 12, tracker.getRecord(0).buttonId);
+  assertEqual(AceButton::kEventPressed, tracker.getRecord(0).eventType);
+}
+
+// Press and release the button on the given virtual pin, and return the id
+// reported by the Pressed event, or 0xFF if there is none.
+static uint8_t pressVirtualPin(uint8_t virtualPin, unsigned long& now) {
+  tracker.clear();
+  encodedConfig.setVirtualPin(virtualPin);
+  for (uint8_t i = 0; i < 2; i++) {
+    encodedConfig.setClock(now += 50);
+    encodedConfig.checkButtons();
+  }
+  encodedConfig.setVirtualPin(0);
+  for (uint8_t i = 0; i < 2; i++) {
+    encodedConfig.setClock(now += 50);
+    encodedConfig.checkButtons();
+  }
+  for (uint32_t i = 0; i < tracker.size(); i++) {
+    if (tracker.getRecord(i).eventType == AceButton::kEventPressed) {
+      return tracker.getRecord(i).buttonId;
+    }
+  }
+  return 0xFF;
+}
+
+test(ButtonArray, attached_config_follows_changes) {
+  ButtonArray<5> buttons;
+  encodedConfig.init();
+  buttons.attach(&encodedConfig);
+  for (uint8_t i = 0; i < NUM_BOARD_BUTTONS; i++) {
+    buttons.add(nullptr, BOARD[i].pin, HIGH, BOARD[i].id);
+  }
+  assertTrue(buttons[3].getButtonConfig() == &encodedConfig);
+  tracker.attach(&encodedConfig);
+
+  unsigned long now = 0;
+  encodedConfig.setVirtualPin(0);
+  encodedConfig.setClock(now);
+  encodedConfig.checkButtons();
+  encodedConfig.setClock(now += 50);
+  encodedConfig.checkButtons();
+  assertEqual((uint8_t) 13, pressVirtualPin(5, now));
+
+  // The button on pin 5 is moved into slot 1, and the old slot 3 is no longer
+  // scanned.
+  assertTrue(buttons.remove(1));
+  assertEqual((uint8_t) 0xFF, pressVirtualPin(2, now));
+  assertEqual((uint8_t) 13, pressVirtualPin(5, now));
+
+  // A new button is scanned without calling setButtons() again, once it has
+  // seen its initial released state.
+  assertTrue(buttons.add(nullptr, 6, HIGH, 14) != nullptr);
+  assertTrue(buttons[3].getButtonConfig() == &encodedConfig);
+  encodedConfig.setClock(now += 50);
+  encodedConfig.checkButtons();
+  encodedConfig.setClock(now += 50);
+  encodedConfig.checkButtons();
+  assertEqual((uint8_t) 14, pressVirtualPin(6, now));
+
+  buttons.clear();
+  assertEqual((uint8_t) 0xFF, pressVirtualPin(5, now));
+  buttons.detach();
+}
@@ -0,0 +1,196 @@
+#line 2 "ButtonCoroutineTest.ino"
+
+// In C++20, <atomic> declares std::atomic_flag::test(), which collides with
+// the test() macro of AUnit, so the AceButton headers must come first.
+#include <AceButton.h>
+#include <ButtonCoroutine.h>
+#include <ButtonGroup.h>
+#include <AUnit.h>
+#include <ace_button/testing/TestableButtonConfig.h>
+#include <ace_button/testing/EventTracker.h>
+#include <ace_button/testing/HelperForButtonConfig.h>
+
+using namespace aunit;
+using namespace ace_button;
+using namespace ace_button::testing;
+
+#if ! defined(__cpp_impl_coroutine)
+  #error Requires C++20 coroutines, e.g. -std=gnu++20
+#endif
+
+// --------------------------------------------------------------------------
+
+const uint8_t PIN_A = 2;
+const uint8_t PIN_B = 3;
+
+TestableButtonConfig buttonConfig;
+AceButton buttonA(&buttonConfig);
+AceButton buttonB(&buttonConfig);
+EventTracker eventTracker;
+HelperForButtonConfig helperA(&buttonConfig, &buttonA, &eventTracker);
+HelperForButtonConfig helperB(&buttonConfig, &buttonB, &eventTracker);
+
+ButtonAwaitDispatcher dispatcher;
+
+TestableButtonConfig groupConfig;
+CompactButton groupButtons[3];
+ButtonGroup group(&groupConfig, groupButtons, 3);
+
+void setup() {
+#if ! defined(EPOXY_DUINO)
+  delay(1000); // wait to prevent garbage on SERIAL_PORT_MONITOR
+#endif
+
+  SERIAL_PORT_MONITOR.begin(115200);
+  while (!SERIAL_PORT_MONITOR); // wait until ready - Leonardo/Micro only
+
+  dispatcher.attach(&buttonConfig);
+  dispatcher.attach(&groupConfig);
+}
+
+void loop() {
+  TestRunner::run();
+}
+
+// Host executor: drive both buttons through the TestableButtonConfig clock.
+// The coroutines are resumed inline from ButtonConfig::dispatchEvent().
+void initButtons() {
+  helperA.init(PIN_A, HIGH, 0);
+  helperB.init(PIN_B, HIGH, 1);
+  buttonConfig.setFeature(ButtonConfig::kFeatureClick);
+  helperA.releaseButton(0);
+  helperB.releaseButton(0);
+  helperA.releaseButton(50);
+  helperB.releaseButton(50);
+}
+
+void click(HelperForButtonConfig& helper, unsigned long time) {
+  helper.pressButton(time);
+  helper.pressButton(time + 50);
+  helper.releaseButton(time + 100);
+  helper.releaseButton(time + 150);
+}
+
+// --------------------------------------------------------------------------
+
+uint8_t step;
+ButtonEvent lastEvent;
+
+ButtonTask sequence() {
+  step = 1;
+  lastEvent = co_await dispatcher.next(&buttonA, AceButton::kEventPressed);
+  step = 2;
+  lastEvent = co_await dispatcher.next(&buttonB, AceButton::kEventClicked);
+  step = 3;
+}
+
+test(ButtonCoroutine, straight_line_sequence) {
+  uint8_t freeFrames = getButtonTaskFramePool().getNumFree();
+  initButtons();
+
+  assertTrue(sequence().isValid());
+  assertEqual(1, step);
+  assertEqual(1, dispatcher.getNumWaiting());
+  assertEqual(freeFrames - 1, getButtonTaskFramePool().getNumFree());
+
+  // B's click does not match the first await.
+  click(helperB, 100);
+  assertEqual(1, step);
+
+  helperA.pressButton(400);
+  helperA.pressButton(450);
+  assertEqual(2, step);
+  assertTrue(lastEvent.button == &buttonA);
+  assertEqual((int64_t) 450, lastEvent.eventTime);
+  helperA.releaseButton(500);
+  helperA.releaseButton(550);
+
+  click(helperB, 1000);
+  assertEqual(3, step);
+  assertTrue(lastEvent.button == &buttonB);
+  assertEqual((int32_t) 100, lastEvent.duration);
+
+  // The frame is released when the coroutine returns.
+  assertEqual(0, dispatcher.getNumWaiting());
+  assertEqual(freeFrames, getButtonTaskFramePool().getNumFree());
+}
+
+uint8_t numPressed;
+
+ButtonTask countPresses() {
+  while (true) {
+    ButtonEvent event = co_await dispatcher.anyOf(&buttonA, &buttonB)
+        .pressed();
+    if (event.button == &buttonB) numPressed += 10;
+    else numPressed++;
+  }
+}
+
+test(ButtonCoroutine, any_of_and_cancel) {
+  uint8_t freeFrames = getButtonTaskFramePool().getNumFree();
+  initButtons();
+  numPressed = 0;
+
+  countPresses();
+  click(helperA, 100);
+  click(helperB, 400);
+  click(helperA, 700);
+  assertEqual(12, numPressed);
+  assertEqual(1, dispatcher.getNumWaiting());
+
+  dispatcher.cancelAll();
+  assertEqual(0, dispatcher.getNumWaiting());
+  assertEqual(freeFrames, getButtonTaskFramePool().getNumFree());
+}
+
+ButtonTask waitForever() {
+  co_await dispatcher.next(&buttonA, AceButton::kEventLongPressed);
+}
+
+test(ButtonCoroutine, pool_exhausted) {
+  uint8_t freeFrames = getButtonTaskFramePool().getNumFree();
+  for (uint8_t i = 0; i < freeFrames; i++) {
+    assertTrue(waitForever().isValid());
+  }
+  assertFalse(waitForever().isValid());
+  assertEqual(freeFrames, dispatcher.getNumWaiting());
+
+  dispatcher.cancelAll();
+  assertEqual(freeFrames, getButtonTaskFramePool().getNumFree());
+}
+
+ButtonTask waitForGroupButton() {
+  lastEvent = co_await dispatcher.next(group.getProxy(), 2,
+      AceButton::kEventPressed);
+  step = 2;
+}
+
+test(ButtonCoroutine, group_button_by_id) {
+  for (uint8_t i = 0; i < 3; i++) {
+    groupButtons[i].init(20 + i, HIGH, i);
+  }
+  groupConfig.setButtonState(HIGH);
+  groupConfig.setClock(0);
+  group.checkButtons();
+  groupConfig.setClock(50);
+  group.checkButtons();
+
+  step = 1;
+  waitForGroupButton();
+
+  // Button 1 of the group reports the same proxy, but not the awaited id.
+  groupConfig.setClock(100);
+  group.checkState(1, LOW);
+  groupConfig.setClock(150);
+  group.checkState(1, LOW);
+  assertEqual(1, step);
+
+  groupConfig.setClock(200);
+  group.checkState(2, LOW);
+  groupConfig.setClock(250);
+  group.checkState(2, LOW);
+  assertEqual(2, step);
+  assertEqual(2, lastEvent.buttonId);
+  assertEqual(22, lastEvent.pin);
+  assertEqual(0, dispatcher.getNumWaiting());
+}
@@ -0,0 +1,187 @@
+#line 2 "ButtonGroupTest.ino"
+
+#include <AUnit.h>
+#include <AceButton.h>
+#include <ButtonGroup.h>
+#include <EventBus.h>
+#include <ace_button/testing/TestableButtonConfig.h>
+#include <ace_button/testing/RingEventTracker.h>
+
+using namespace aunit;
+using namespace ace_button;
+using namespace ace_button::testing;
+
+// --------------------------------------------------------------------------
+
+const uint16_t NUM_BUTTONS = 3;
+
+TestableButtonConfig groupConfig;
+CompactButton buttons[NUM_BUTTONS];
+ButtonGroup group(&groupConfig, buttons, NUM_BUTTONS);
+RingEventTracker<64> groupTracker;
+EventBus<1, 8> groupBus;
+
+TestableButtonConfig aceConfig;
+AceButton aceButton(&aceConfig);
+RingEventTracker<64> aceTracker;
+
+void setup() {
+#if ! defined(EPOXY_DUINO)
+  delay(1000); // wait to prevent garbage on SERIAL_PORT_MONITOR
+#endif
+
+  SERIAL_PORT_MONITOR.begin(115200);
+  while (!SERIAL_PORT_MONITOR); // wait until ready - Leonardo/Micro only
+}
+
+void loop() {
+  TestRunner::run();
+}
+
+void init() {
+  groupConfig.init();
+  groupTracker.clear();
+  groupTracker.attach(&groupConfig);
+  for (uint16_t i = 0; i < NUM_BUTTONS; i++) {
+    buttons[i].init(10 + i, HIGH, i);
+  }
+
+  aceConfig.init();
+  aceTracker.clear();
+  aceTracker.attach(&aceConfig);
+  aceButton.init(&aceConfig, 11, HIGH, 1);
+}
+
+// Check every button of the group at the given time, with button 1 at the
+// given level and the others released.
+void scanGroup(unsigned long now, int level1) {
+  groupConfig.setClock(now);
+  for (uint16_t i = 0; i < NUM_BUTTONS; i++) {
+    group.checkState(i, (i == 1) ? level1 : HIGH);
+  }
+}
+
+// --------------------------------------------------------------------------
+
+test(ButtonGroup, compact_button_is_smaller) {
+  assertLess(sizeof(CompactButton), sizeof(AceButton));
+}
+
+test(ButtonGroup, proxy_identifies_button) {
+  init();
+
+  // Initialize the buttons to the released state.
+  scanGroup(0, HIGH);
+  scanGroup(50, HIGH);
+  assertEqual((uint32_t) 0, groupTracker.size());
+
+  // Press button 1, debounced after 20 ms.
+  scanGroup(100, LOW);
+  scanGroup(130, LOW);
+  assertEqual((uint32_t) 1, groupTracker.size());
+
+  const TimedEventRecord& pressed = groupTracker.getRecord(0);
+  assertEqual((uint32_t) 130, pressed.time);
+  assertEqual((uint8_t) 1, pressed.buttonId);
+  assertEqual((uint8_t) 11, pressed.pin);
+  assertEqual(AceButton::kEventPressed, pressed.eventType);
+  assertEqual(LOW, pressed.buttonState);
+
+  // The other buttons are untouched.
+  assertEqual(HIGH, buttons[0].getLastButtonState());
+  assertEqual(LOW, buttons[1].getLastButtonState());
+  assertEqual(HIGH, buttons[2].getLastButtonState());
+}
+
+test(ButtonGroup, same_events_as_ace_button) {
+  init();
+  groupConfig.setFeature(ButtonConfig::kFeatureClick);
+  groupConfig.setFeature(ButtonConfig::kFeatureDoubleClick);
+  groupConfig.setFeature(ButtonConfig::kFeatureLongPress);
+  aceConfig.setFeature(ButtonConfig::kFeatureClick);
+  aceConfig.setFeature(ButtonConfig::kFeatureDoubleClick);
+  aceConfig.setFeature(ButtonConfig::kFeatureLongPress);
+
+  // Click, double click, then a long press of button 1, scanned every 5 ms.
+  for (unsigned long now = 0; now < 3000; now += 5) {
+    int level = ((now >= 100 && now < 200)
+        || (now >= 300 && now < 400)
+        || (now >= 1000 && now < 2500)) ? LOW : HIGH;
+    scanGroup(now, level);
+    aceConfig.setClock(now);
+    aceButton.checkState(level);
+  }
+
+  TimedEventRecord expected[64];
+  uint32_t numExpected = aceTracker.size();
+  assertMore(numExpected, (uint32_t) 5);
+  for (uint32_t i = 0; i < numExpected; i++) {
+    expected[i] = aceTracker.getRecord(i);
+  }
+  EventDivergence divergence = groupTracker.compare(expected, numExpected);
+  assertTrue(divergence.matched);
+}
+
+test(ButtonGroup, check_buttons_and_deadline) {
+  init();
+  groupConfig.setFeature(ButtonConfig::kFeatureLongPress);
+
+  // checkButtons() reads every button through the ButtonConfig.
+  groupConfig.setButtonState(HIGH);
+  groupConfig.setClock(0);
+  group.checkButtons();
+  assertEqual((int64_t) 20, group.getNextDeadline());
+  groupConfig.setClock(20);
+  group.checkButtons();
+  assertEqual(ButtonCore::kNoDeadline, group.getNextDeadline());
+
+  // All three buttons are pressed at once.
+  groupConfig.setButtonState(LOW);
+  groupConfig.setClock(100);
+  group.checkButtons();
+  groupConfig.setClock(120);
+  group.checkButtons();
+  assertEqual((uint32_t) 3, groupTracker.size());
+  for (uint16_t i = 0; i < NUM_BUTTONS; i++) {
+    assertEqual((uint8_t) i, groupTracker.getRecord(i).buttonId);
+  }
+  assertEqual((int64_t) (120 + ButtonConfig::kLongPressDelay),
+      group.getNextDeadline());
+}
+
+test(ButtonGroup, queued_events_identify_button) {
+  init();
+  groupBus.attach(&groupConfig, 0);
+  ButtonEvent event;
+  while (groupBus.pop(event)) {}
+
+  // Press button 1, then button 2, then button 0, before popping any event.
+  groupConfig.setClock(0);
+  group.checkButtons();
+  groupConfig.setClock(50);
+  group.checkButtons();
+  const uint8_t order[NUM_BUTTONS] = {1, 2, 0};
+  unsigned long now = 100;
+  for (uint8_t i = 0; i < NUM_BUTTONS; i++) {
+    for (uint8_t j = 0; j < 2; j++) {
+      groupConfig.setClock(now);
+      for (uint16_t k = 0; k < NUM_BUTTONS; k++) {
+        bool pressed = false;
+        for (uint8_t p = 0; p <= i; p++) {
+          if (order[p] == k) pressed = true;
+        }
+        group.checkState(k, pressed ? LOW : HIGH);
+      }
+      now += 30;
+    }
+  }
+
+  // All events carry the same proxy pointer, but their own id and pin.
+  for (uint8_t i = 0; i < NUM_BUTTONS; i++) {
+    assertTrue(groupBus.pop(event));
+    assertEqual(AceButton::kEventPressed, event.eventType);
+    assertEqual(order[i], event.buttonId);
+    assertEqual((uint8_t) (10 + order[i]), event.pin);
+  }
+  assertFalse(groupBus.pop(event));
+}
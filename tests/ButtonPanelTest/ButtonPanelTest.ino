@@ -0,0 +1,160 @@
+#line 2 "ButtonPanelTest.ino"
+
+#include <AceButton.h>
+#include <ButtonPanel.h>
+#include <AUnit.h>
+#include <ace_button/testing/TestableButtonPanel.h>
+#include <ace_button/testing/RingEventTracker.h>
+
+using namespace aunit;
+using namespace ace_button;
+using namespace ace_button::testing;
+
+// --------------------------------------------------------------------------
+
+// An 8-to-3 encoder with 5 buttons.
+constexpr uint8_t ENCODED_PINS[] = {2, 4, 5};
+constexpr PanelButton ENCODED_BUTTONS[] = {
+  {1, 10}, {2, 11}, {3, 12}, {5, 13}, {6, 14},
+};
+constexpr auto ENCODED_PANEL = makeEncodedPanel(
+    ENCODED_PINS, ENCODED_BUTTONS);
+
+// A resistor ladder with 4 buttons on a 12-bit ADC.
+constexpr uint16_t LADDER_LEVELS[] = {0, 1000, 2000, 3000, 4095};
+constexpr PanelButton LADDER_BUTTONS[] = {{0, 0}, {1, 1}, {2, 2}, {3, 3}};
+constexpr auto LADDER_PANEL = makeLadderPanel(
+    36, LADDER_LEVELS, LADDER_BUTTONS);
+
+// Evaluated by the compiler.
+static_assert(ENCODED_PANEL.buttons[3].pin == 5, "virtual pin");
+static_assert(ENCODED_PANEL.buttons[3].id == 13, "id");
+static_assert(LADDER_PANEL.thresholds[0] == 500, "threshold");
+static_assert(LADDER_PANEL.thresholds[3] == 3547, "threshold");
+static_assert(LADDER_PANEL.getNoButtonPin() == 4, "no button");
+
+// Constant-initialized: no constructor runs at startup.
+ACE_BUTTON_CONSTINIT TestableButtonPanel<ENCODED_PANEL> encodedPanel;
+ACE_BUTTON_CONSTINIT TestableButtonPanel<LADDER_PANEL> ladderPanel;
+
+RingEventTracker<64> tracker;
+
+void setup() {
+#if ! defined(EPOXY_DUINO)
+  delay(1000); // wait to prevent garbage on SERIAL_PORT_MONITOR
+#endif
+
+  SERIAL_PORT_MONITOR.begin(115200);
+  while (!SERIAL_PORT_MONITOR); // wait until ready - Leonardo/Micro only
+}
+
+void loop() {
+  TestRunner::run();
+}
+
+// --------------------------------------------------------------------------
+
+test(ButtonPanel, constant_initialized_buttons) {
+  assertEqual((uint8_t) 5, encodedPanel.kNumButtons);
+  CompactButton& button = encodedPanel.getButton(3);
+  assertEqual((uint8_t) 5, button.getPin());
+  assertEqual((uint8_t) 13, button.getId());
+  assertEqual(HIGH, button.getDefaultReleasedState());
+
+  assertEqual((uint8_t) 4, ladderPanel.kNumButtons);
+  assertEqual((uint8_t) 2, ladderPanel.getButton(2).getPin());
+  assertEqual(ButtonConfig::kDebounceDelay, ladderPanel.getDebounceDelay());
+}
+
+test(ButtonPanel, ladder_extract_index) {
+  assertEqual((uint8_t) 0, LADDER_PANEL.extractIndex(0));
+  assertEqual((uint8_t) 0, LADDER_PANEL.extractIndex(499));
+  assertEqual((uint8_t) 1, LADDER_PANEL.extractIndex(500));
+  assertEqual((uint8_t) 3, LADDER_PANEL.extractIndex(3546));
+  assertEqual((uint8_t) 4, LADDER_PANEL.extractIndex(3547));
+  assertEqual((uint8_t) 4, LADDER_PANEL.extractIndex(4095));
+}
+
+test(ButtonPanel, encoded_panel_events) {
+  encodedPanel.init();
+  tracker.clear();
+  tracker.attach(&encodedPanel);
+
+  // Initialize the buttons to the released state.
+  encodedPanel.setVirtualPin(0);
+  encodedPanel.setClock(0);
+  encodedPanel.checkButtons();
+  encodedPanel.setClock(50);
+  encodedPanel.checkButtons();
+
+  // Press virtual pin 5, debounced after 20 ms.
+  encodedPanel.setVirtualPin(5);
+  encodedPanel.setClock(100);
+  encodedPanel.checkButtons();
+  encodedPanel.setClock(120);
+  encodedPanel.checkButtons();
+
+  assertEqual((uint32_t) 1, tracker.size());
+  const TimedEventRecord& record = tracker.getRecord(0);
+  assertEqual((uint8_t) 13, record.buttonId);
+  assertEqual((uint8_t) 5, record.pin);
+  assertEqual(AceButton::kEventPressed, record.eventType);
+  assertEqual(LOW, record.buttonState);
+  assertEqual(LOW, encodedPanel.readButton(5));
+  assertEqual(HIGH, encodedPanel.readButton(6));
+}
+
+test(ButtonPanel, ladder_panel_events) {
+  ladderPanel.init();
+  ladderPanel.setFeature(ButtonConfig::kFeatureClick);
+  tracker.clear();
+  tracker.attach(&ladderPanel);
+
+  ladderPanel.setClock(0);
+  ladderPanel.checkButtons();
+  ladderPanel.setClock(50);
+  ladderPanel.checkButtons();
+
+  // Click the button of level 2.
+  ladderPanel.setVirtualPin(2);
+  ladderPanel.setClock(100);
+  ladderPanel.checkButtons();
+  ladderPanel.setClock(120);
+  ladderPanel.checkButtons();
+  ladderPanel.setVirtualPin(ladderPanel.getNoButtonPin());
+  ladderPanel.setClock(200);
+  ladderPanel.checkButtons();
+  ladderPanel.setClock(220);
+  ladderPanel.checkButtons();
+
+  assertEqual((uint32_t) 3, tracker.size());
+  assertEqual(AceButton::kEventPressed, tracker.getRecord(0).eventType);
+  assertEqual(AceButton::kEventClicked, tracker.getRecord(1).eventType);
+  assertEqual(AceButton::kEventReleased, tracker.getRecord(2).eventType);
+  for (uint32_t i = 0; i < 3; i++) {
+    assertEqual((uint8_t) 2, tracker.getRecord(i).buttonId);
+  }
+}
+
+test(ButtonPanel, prime_buttons) {
+  ladderPanel.init();
+  tracker.clear();
+  tracker.attach(&ladderPanel);
+
+  // The button of level 1 is held at boot.
+  ladderPanel.setVirtualPin(1);
+  assertEqual((uint8_t) 1, ladderPanel.primeButtons(3));
+  assertTrue(ladderPanel.getButton(1).isPressed());
+  assertFalse(ladderPanel.getButton(2).isPressed());
+
+  // Its release is detected after a single debounce delay.
+  ladderPanel.setVirtualPin(ladderPanel.getNoButtonPin());
+  ladderPanel.setClock(1000);
+  ladderPanel.checkButtons();
+  ladderPanel.setClock(1020);
+  ladderPanel.checkButtons();
+
+  assertEqual((uint32_t) 1, tracker.size());
+  assertEqual(AceButton::kEventReleased, tracker.getRecord(0).eventType);
+  assertEqual((uint8_t) 1, tracker.getRecord(0).buttonId);
+}
@@ -0,0 +1,108 @@
+#line 2 "ButtonStatsTest.ino"
+
+#include <AUnit.h>
+#include <AceButton.h>
+#include <ace_button/testing/TestableButtonConfig.h>
+#include <ace_button/testing/EventTracker.h>
+#include <ace_button/testing/HelperForButtonConfig.h>
+
+using namespace aunit;
+using namespace ace_button;
+using namespace ace_button::testing;
+
+#if ! ACE_BUTTON_ENABLE_STATS
+  #error Requires -DACE_BUTTON_ENABLE_STATS=1
+#endif
+
+// --------------------------------------------------------------------------
+
+const uint8_t PIN = 13;
+const uint8_t BUTTON_ID = 1;
+
+TestableButtonConfig testableConfig;
+AceButton button(&testableConfig);
+EventTracker eventTracker;
+HelperForButtonConfig helper(&testableConfig, &button, &eventTracker);
+
+void setup() {
+#if ! defined(EPOXY_DUINO)
+  delay(1000); // wait to prevent garbage on SERIAL_PORT_MONITOR
+#endif
+
+  SERIAL_PORT_MONITOR.begin(115200);
+  while (!SERIAL_PORT_MONITOR); // wait until ready - Leonardo/Micro only
+}
+
+void loop() {
+  TestRunner::run();
+}
+
+// Reset the button and the counters. The reset takes effect at the next check.
+void init() {
+  helper.init(PIN, HIGH, BUTTON_ID);
+  testableConfig.resetStats();
+  helper.releaseButton(0);
+  helper.releaseButton(50);
+}
+
+ButtonStats readStats() {
+  ButtonStats stats;
+  testableConfig.readStats(stats);
+  return stats;
+}
+
+// --------------------------------------------------------------------------
+
+test(ButtonStats, edges_and_events) {
+  init();
+  testableConfig.setFeature(ButtonConfig::kFeatureClick);
+
+  helper.pressButton(100);
+  helper.pressButton(150); // Pressed
+  helper.releaseButton(200);
+  helper.releaseButton(250); // Clicked, Released
+
+  ButtonStats stats = readStats();
+  assertEqual((uint32_t) 6, stats.numChecks);
+  assertEqual((uint32_t) 3, stats.numEdges); // unknown->HIGH, press, release
+  assertEqual((uint32_t) 0, stats.numEdgesRejected);
+  assertEqual((uint32_t) 1, stats.numEvents[AceButton::kEventPressed]);
+  assertEqual((uint32_t) 1, stats.numEvents[AceButton::kEventClicked]);
+  assertEqual((uint32_t) 1, stats.numEvents[AceButton::kEventReleased]);
+  assertEqual((uint32_t) 0, stats.numEvents[AceButton::kEventLongPressed]);
+}
+
+test(ButtonStats, bounce_rejected) {
+  init();
+
+  // A short glitch: the button is back HIGH when debouncing ends.
+  helper.pressButton(100);
+  helper.releaseButton(110);
+  helper.releaseButton(130);
+
+  ButtonStats stats = readStats();
+  assertEqual((uint32_t) 2, stats.numEdges);
+  assertEqual((uint32_t) 1, stats.numEdgesRejected);
+  assertEqual((uint32_t) 0, stats.numEvents[AceButton::kEventPressed]);
+}
+
+test(ButtonStats, postponed_click_cancelled) {
+  init();
+  testableConfig.setFeature(ButtonConfig::kFeatureDoubleClick);
+  testableConfig.setFeature(
+      ButtonConfig::kFeatureSuppressClickBeforeDoubleClick);
+
+  helper.pressButton(100);
+  helper.pressButton(150);
+  helper.releaseButton(200);
+  helper.releaseButton(250); // Clicked postponed
+  helper.pressButton(300);
+  helper.pressButton(350);
+  helper.releaseButton(400);
+  helper.releaseButton(450); // DoubleClicked cancels the postponed Clicked
+
+  ButtonStats stats = readStats();
+  assertEqual((uint32_t) 1, stats.numPostponedClicksCancelled);
+  assertEqual((uint32_t) 1, stats.numEvents[AceButton::kEventDoubleClicked]);
+  assertEqual((uint32_t) 0, stats.numEvents[AceButton::kEventClicked]);
+}
@@ -0,0 +1,165 @@
+#line 2 "ConfigSnapshotTest.ino"
+
+#include <thread>
+#include <AUnit.h>
+#include <AceButton.h>
+
+using namespace aunit;
+using namespace ace_button;
+
+// --------------------------------------------------------------------------
+
+void handlerA(AceButton*, uint8_t, uint8_t) {}
+void handlerB(AceButton*, uint8_t, uint8_t) {}
+
+class Handler: public IEventHandler {
+  public:
+    void handleEvent(AceButton*, uint8_t, uint8_t) override {}
+};
+
+Handler handler;
+
+void setup() {
+#if ! defined(EPOXY_DUINO)
+  delay(1000); // wait to prevent garbage on SERIAL_PORT_MONITOR
+#endif
+
+  SERIAL_PORT_MONITOR.begin(115200);
+  while (!SERIAL_PORT_MONITOR); // wait until ready - Leonardo/Micro only
+}
+
+void loop() {
+  TestRunner::run();
+}
+
+// --------------------------------------------------------------------------
+
+test(ConfigSnapshot, setters_publish_snapshot) {
+  ButtonConfig config;
+  config.setDebounceDelay(5);
+  config.setHeartBeatInterval(700);
+  config.setFeature(ButtonConfig::kFeatureClick);
+
+  ButtonConfig::Snapshot snapshot;
+  config.readSnapshot(snapshot);
+  assertEqual((int64_t) 5, snapshot.debounceDelay);
+  assertEqual((int64_t) 700, snapshot.heartBeatInterval);
+  assertEqual(ButtonConfig::kClickDelay, snapshot.clickDelay);
+  assertTrue(snapshot.isFeature(ButtonConfig::kFeatureClick));
+  assertFalse(snapshot.isFeature(ButtonConfig::kFeatureLongPress));
+
+  config.clearFeature(ButtonConfig::kFeatureClick);
+  assertFalse(config.isFeature(ButtonConfig::kFeatureClick));
+  assertEqual((int64_t) 5, config.getDebounceDelay());
+}
+
+test(ConfigSnapshot, handler_and_flag_change_together) {
+  ButtonConfig config;
+
+  config.setIEventHandler(&handler);
+  ButtonConfig::Snapshot snapshot = config.getSnapshot();
+  assertTrue(snapshot.eventDelegate == EventDelegate::fromHandler(&handler));
+  assertTrue(snapshot.isFeature(ButtonConfig::kInternalFeatureIEventHandler));
+
+  config.setEventHandler(handlerA);
+  snapshot = config.getSnapshot();
+  assertTrue(snapshot.eventDelegate == EventDelegate::fromFunction(handlerA));
+  assertFalse(snapshot.isFeature(ButtonConfig::kInternalFeatureIEventHandler));
+}
+
+test(ConfigSnapshot, shared_timing_profile) {
+  const ButtonConfig::TimingProfile slow = {
+    50, 300, 600, 2000, 1500, 250, 10000
+  };
+  ButtonConfig config1;
+  ButtonConfig config2;
+  config1.setTimingProfile(&slow);
+  config2.setTimingProfile(&slow);
+  config2.setFeature(ButtonConfig::kFeatureLongPress);
+
+  // Both configs read the shared profile. Setting a feature keeps it.
+  assertTrue(config2.getTimingProfile() == &slow);
+  ButtonConfig::Snapshot snapshot = config2.getSnapshot();
+  assertEqual((int64_t) 50, snapshot.debounceDelay);
+  assertEqual((int64_t) 2000, snapshot.longPressDelay);
+  assertEqual((int64_t) 10000, snapshot.heartBeatInterval);
+  assertEqual((int64_t) 600, config1.getDoubleClickDelay());
+
+  // A setter copies the profile into config1 and detaches it.
+  config1.setClickDelay(350);
+  assertTrue(config1.getTimingProfile() == nullptr);
+  assertEqual((int64_t) 350, config1.getClickDelay());
+  assertEqual((int64_t) 50, config1.getDebounceDelay());
+  assertEqual((int64_t) 300, config2.getClickDelay());
+
+  // The pointer to the profile is never visible as a feature.
+  config2.setFeature(0xFFFF & ~ButtonConfig::kInternalFeatureIEventHandler
+      & ~ButtonConfig::kInternalFeatureIEventHandler2);
+  assertTrue(config2.getTimingProfile() == &slow);
+  config2.clearFeature(0xFFFF);
+  assertTrue(config2.getTimingProfile() == &slow);
+  assertEqual((ButtonConfig::FeatureFlagType) 0,
+      config2.getSnapshot().featureFlags);
+  config2.setFeature(ButtonConfig::kFeatureLongPress);
+
+  // Back to the default delays.
+  config2.setTimingProfile(nullptr);
+  assertTrue(config2.getTimingProfile() == nullptr);
+  assertEqual(ButtonConfig::kDebounceDelay, config2.getDebounceDelay());
+  assertTrue(config2.isFeature(ButtonConfig::kFeatureLongPress));
+}
+
+test(ConfigSnapshot, delays_are_clamped) {
+  ButtonConfig config;
+  config.setLongPressDelay(100000);
+  config.setDebounceDelay(-5);
+  assertEqual(ButtonConfig::kMaxDelay, config.getLongPressDelay());
+  assertEqual((int64_t) 0, config.getDebounceDelay());
+
+  // 16-bit delays: the stored configuration is much smaller than two
+  // Snapshots.
+  assertLess(sizeof(ButtonConfig), 2 * sizeof(ButtonConfig::Snapshot));
+}
+
+// A writer thread keeps switching between two complete configurations while
+// the reader checks that every Snapshot is entirely one or the other.
+test(ConfigSnapshot, concurrent_reader_sees_consistent_snapshot) {
+  ButtonConfig config;
+  ButtonConfig::Snapshot a;
+  a.eventDelegate = EventDelegate::fromFunction(handlerA);
+  a.featureFlags = ButtonConfig::kFeatureClick;
+  a.debounceDelay = a.clickDelay = a.doubleClickDelay = a.longPressDelay
+      = a.repeatPressDelay = a.repeatPressInterval = a.heartBeatInterval = 10;
+  ButtonConfig::Snapshot b;
+  b.eventDelegate = EventDelegate::fromHandler(&handler);
+  b.featureFlags = ButtonConfig::kInternalFeatureIEventHandler;
+  b.debounceDelay = b.clickDelay = b.doubleClickDelay = b.longPressDelay
+      = b.repeatPressDelay = b.repeatPressInterval = b.heartBeatInterval = 20;
+  config.publishSnapshot(a);
+
+  std::atomic<bool> done(false);
+  std::thread writer([&]() {
+    for (uint32_t i = 0; i < 200000; i++) {
+      config.publishSnapshot((i & 1) ? a : b);
+    }
+    done = true;
+  });
+
+  uint32_t numReads = 0;
+  uint32_t numTorn = 0;
+  while (! done || numReads < 1000) {
+    ButtonConfig::Snapshot s;
+    config.readSnapshot(s);
+    const ButtonConfig::Snapshot& expected = (s.debounceDelay == 10) ? a : b;
+    if (! (s.eventDelegate == expected.eventDelegate)
+        || s.featureFlags != expected.featureFlags
+        || s.clickDelay != expected.clickDelay
+        || s.heartBeatInterval != expected.heartBeatInterval) {
+      numTorn++;
+    }
+    numReads++;
+  }
+  writer.join();
+
+  assertEqual((uint32_t) 0, numTorn);
+}
@@ -0,0 +1,223 @@
+#line 2 "DiscreteEventSimulatorTest.ino"
+
+#include <AUnit.h>
+#include <AceButton.h>
+#include <ace_button/testing/TestableButtonConfig.h>
+#include <ace_button/testing/RingEventTracker.h>
+#include <ace_button/testing/DiscreteEventSimulator.h>
+
+using namespace aunit;
+using namespace ace_button;
+using namespace ace_button::testing;
+
+// --------------------------------------------------------------------------
+
+const uint32_t SCAN_INTERVAL = 5;
+const uint8_t NUM_BUTTONS = 2;
+const int64_t HOUR = (int64_t) 3600 * 1000;
+
+TestableButtonConfig testableConfig;
+AceButton button0(&testableConfig, 0, HIGH, 0);
+AceButton button1(&testableConfig, 1, HIGH, 1);
+AceButton* const BUTTONS[NUM_BUTTONS] = {&button0, &button1};
+
+RingEventTracker<(uint32_t) 1 << 16> pollingTracker;
+RingEventTracker<(uint32_t) 1 << 16> simulatorTracker;
+DiscreteEventSimulator<NUM_BUTTONS, 8192> simulator(
+    &testableConfig, SCAN_INTERVAL);
+
+void setup() {
+#if ! defined(EPOXY_DUINO)
+  delay(1000); // wait to prevent garbage on SERIAL_PORT_MONITOR
+#endif
+
+  SERIAL_PORT_MONITOR.begin(115200);
+  while (!SERIAL_PORT_MONITOR); // wait until ready - Leonardo/Micro only
+}
+
+void loop() {
+  TestRunner::run();
+}
+
+/** A raw input change of a button. */
+struct Change {
+  int64_t time;
+  uint8_t index;
+  uint8_t level;
+};
+
+/**
+ * Generates a deterministic random script of presses with contact bounce,
+ * including double clicks, long presses and repeat presses.
+ */
+class Script {
+  public:
+    void init(uint32_t seed) {
+      mSeed = seed;
+      for (uint8_t i = 0; i < NUM_BUTTONS; i++) mNextPress[i] = random(2000);
+    }
+
+    /** Generate the changes of all presses which start before until. */
+    uint32_t generate(int64_t until, Change* changes, uint32_t maxChanges,
+        uint32_t maxIdle) {
+      uint32_t n = 0;
+      for (uint8_t i = 0; i < NUM_BUTTONS; i++) {
+        while (mNextPress[i] < until && n + 8 <= maxChanges) {
+          int64_t t = mNextPress[i];
+          n = addBouncing(changes, n, t, i, LOW);
+          int64_t released = t + 30 + random(random(3) ? 600 : 3000);
+          n = addBouncing(changes, n, released, i, HIGH);
+          // Often a short gap, to produce double clicks.
+          mNextPress[i] = released + 50
+              + random(random(2) ? 400 : maxIdle);
+        }
+      }
+      return n;
+    }
+
+  private:
+    uint32_t random(uint32_t range) {
+      mSeed = mSeed * 1664525 + 1013904223;
+      return (mSeed >> 8) % range;
+    }
+
+    uint32_t addBouncing(Change* changes, uint32_t n, int64_t t, uint8_t index,
+        uint8_t level) {
+      uint8_t other = (level == LOW) ? HIGH : LOW;
+      uint32_t numBounces = random(3);
+      for (uint32_t b = 0; b < numBounces; b++) {
+        changes[n++] = {t, index, level};
+        t += 1 + random(2);
+        changes[n++] = {t, index, other};
+        t += 1 + random(2);
+      }
+      changes[n++] = {t, index, level};
+      return n;
+    }
+
+    uint32_t mSeed;
+    int64_t mNextPress[NUM_BUTTONS];
+};
+
+void initButtons() {
+  testableConfig.init();
+  testableConfig.setFeature(ButtonConfig::kFeatureClick);
+  testableConfig.setFeature(ButtonConfig::kFeatureDoubleClick);
+  testableConfig.setFeature(ButtonConfig::kFeatureLongPress);
+  testableConfig.setFeature(ButtonConfig::kFeatureRepeatPress);
+  testableConfig.setFeature(ButtonConfig::kFeatureHeartBeat);
+  testableConfig.setFeature(ButtonConfig::kFeatureSuppressAfterLongPress);
+  testableConfig.setFeature(
+      ButtonConfig::kFeatureSuppressClickBeforeDoubleClick);
+  for (uint8_t i = 0; i < NUM_BUTTONS; i++) BUTTONS[i]->init(i, HIGH, i);
+}
+
+Change changes[8192];
+
+// --------------------------------------------------------------------------
+
+test(DiscreteEventSimulator, next_deadline) {
+  initButtons();
+  testableConfig.clearFeature(ButtonConfig::kFeatureHeartBeat);
+  assertEqual(INT64_MIN, button0.getNextDeadline()); // initial state unknown
+
+  testableConfig.setClock(0);
+  button0.checkState(HIGH);
+  assertEqual((int64_t) 20, button0.getNextDeadline()); // debouncing
+  testableConfig.setClock(20);
+  button0.checkState(HIGH);
+  assertEqual(AceButton::kNoDeadline, button0.getNextDeadline());
+
+  testableConfig.setClock(100);
+  button0.checkState(LOW);
+  testableConfig.setClock(120);
+  button0.checkState(LOW); // Pressed
+  assertEqual((int64_t) 120 + testableConfig.getLongPressDelay(),
+      button0.getNextDeadline());
+}
+
+// The simulator dispatches exactly the same events as polling every
+// SCAN_INTERVAL, with a fraction of the checks.
+test(DiscreteEventSimulator, same_events_as_polling) {
+  const int64_t duration = 2 * HOUR;
+  Script script;
+  script.init(42);
+  uint32_t numChanges = script.generate(duration, changes, 8192, 5000);
+
+  // Polling.
+  initButtons();
+  pollingTracker.clear();
+  pollingTracker.attach(&testableConfig);
+  uint8_t levels[NUM_BUTTONS] = {HIGH, HIGH};
+  // Changes are sorted per button, so apply them with one cursor per button.
+  uint32_t cursors[NUM_BUTTONS] = {0, 0};
+  uint64_t numPolls = 0;
+  for (int64_t now = 0; now <= duration; now += SCAN_INTERVAL) {
+    for (uint8_t i = 0; i < NUM_BUTTONS; i++) {
+      uint32_t& c = cursors[i];
+      while (c < numChanges
+          && (changes[c].index != i || changes[c].time <= now)) {
+        if (changes[c].index == i) levels[i] = changes[c].level;
+        c++;
+      }
+    }
+    testableConfig.setClock(now);
+    for (uint8_t i = 0; i < NUM_BUTTONS; i++) {
+      BUTTONS[i]->checkState(levels[i]);
+    }
+    numPolls++;
+  }
+
+  // Discrete event simulation.
+  initButtons();
+  simulatorTracker.clear();
+  simulatorTracker.attach(&testableConfig);
+  simulator.init();
+  for (uint8_t i = 0; i < NUM_BUTTONS; i++) {
+    simulator.addButton(BUTTONS[i], HIGH);
+  }
+  for (uint32_t c = 0; c < numChanges; c++) {
+    assertTrue(simulator.schedule(
+        changes[c].time, changes[c].index, changes[c].level));
+  }
+  simulator.runUntil(duration);
+
+  assertMore(pollingTracker.getNumEvents(), (uint64_t) 2000);
+  assertEqual((uint64_t) 0, pollingTracker.getNumDropped());
+  EventDivergence d = simulatorTracker.compare(
+      &pollingTracker.getRecord(0), (uint32_t) pollingTracker.size());
+  assertTrue(d.matched);
+  assertLess(simulator.getNumScans() * 10, numPolls);
+}
+
+// A week of sparse activity, scheduled one hour at a time.
+test(DiscreteEventSimulator, one_week) {
+  initButtons();
+  simulatorTracker.clear();
+  simulatorTracker.attach(&testableConfig);
+  simulator.init();
+  for (uint8_t i = 0; i < NUM_BUTTONS; i++) {
+    simulator.addButton(BUTTONS[i], HIGH);
+  }
+
+  Script script;
+  script.init(7);
+  for (int64_t hour = 1; hour <= 7 * 24; hour++) {
+    uint32_t n = script.generate(hour * HOUR, changes, 1024, 120000);
+    for (uint32_t c = 0; c < n; c++) {
+      simulator.schedule(changes[c].time, changes[c].index, changes[c].level);
+    }
+    simulator.runUntil(hour * HOUR);
+  }
+
+  // At least one HeartBeat every 5 s per button, with one scan per second on
+  // average instead of one every 5 ms.
+  assertMoreOrEqual(simulatorTracker.getNumEvents(),
+      (uint64_t) 2 * 7 * 24 * 720);
+  assertLess(simulator.getNumScans(), (uint64_t) 7 * 24 * HOUR / 1000);
+
+  // The last HeartBeat was at most 5 s ago, without drift.
+  const TimedEventRecord& last =
+      simulatorTracker.getRecord(simulatorTracker.size() - 1);
+  assertLessOrEqual((uint32_t) (7 * 24 * HOUR) - last.time, (uint32_t) 5000);
+}
@@ -0,0 +1,109 @@
+#line 2 "EdgeLatencyTest.ino"
+
+#include <AUnit.h>
+#include <AceButton.h>
+#include <ace_button/testing/TestableButtonConfig.h>
+#include <ace_button/testing/BounceSimulator.h>
+
+using namespace aunit;
+using namespace ace_button;
+using namespace ace_button::testing;
+
+#if ! ACE_BUTTON_ENABLE_EDGE_LATENCY
+  #error Requires -DACE_BUTTON_ENABLE_EDGE_LATENCY=1
+#endif
+
+// --------------------------------------------------------------------------
+
+const uint8_t SCAN_INTERVAL = 5;
+
+TestableButtonConfig testableConfig;
+AceButton button(&testableConfig);
+BounceSimulator simulator(&testableConfig, &button, SCAN_INTERVAL);
+
+// Latency of the last Pressed event, as seen by the event handler.
+int64_t pressedLatency;
+
+void handleEvent(AceButton* button, uint8_t eventType,
+    uint8_t /*buttonState*/) {
+  if (eventType == AceButton::kEventPressed) {
+    pressedLatency = testableConfig.getClock() - button->getEdgeTime();
+  }
+}
+
+void setup() {
+#if ! defined(EPOXY_DUINO)
+  delay(1000); // wait to prevent garbage on SERIAL_PORT_MONITOR
+#endif
+
+  SERIAL_PORT_MONITOR.begin(115200);
+  while (!SERIAL_PORT_MONITOR); // wait until ready - Leonardo/Micro only
+}
+
+void loop() {
+  TestRunner::run();
+}
+
+// Start with a released button (pullup), settled at time 50.
+void init(bool simulateInterrupts) {
+  button.init(&testableConfig, 0, HIGH, 0);
+  testableConfig.init();
+  testableConfig.setEventHandler(handleEvent);
+  testableConfig.getEdgeLatencies().requestReset();
+  pressedLatency = -1;
+  simulator.init(HIGH, simulateInterrupts);
+  simulator.runUntil(50);
+}
+
+LatencyPercentiles readLatencies() {
+  LatencyPercentiles percentiles;
+  testableConfig.getEdgeLatencies().readPercentiles(percentiles);
+  return percentiles;
+}
+
+// --------------------------------------------------------------------------
+
+// Without interrupts, the edge is the first scan which sees the new level.
+test(EdgeLatency, edge_from_scan) {
+  init(false);
+
+  simulator.transition(102, LOW, 0, 1);
+  simulator.runUntil(150);
+  assertEqual((int64_t) 105, button.getEdgeTime());
+  assertEqual((int64_t) 20, pressedLatency);
+
+  simulator.transition(201, HIGH, 0, 1);
+  simulator.runUntil(250);
+
+  LatencyPercentiles percentiles = readLatencies();
+  assertEqual((uint32_t) 2, percentiles.count);
+  assertEqual((uint32_t) 20, percentiles.max);
+}
+
+// With interrupts, the latency includes the time hidden by the contact bounce
+// and by the scan interval.
+test(EdgeLatency, edge_from_interrupt_with_bounce) {
+  init(true);
+
+  // Bounces until 106: the scan at 105 sees HIGH, the scan at 110 sees LOW.
+  simulator.transition(102, LOW, 4, 1);
+  simulator.runUntil(150);
+  assertEqual((int64_t) 102, button.getEdgeTime());
+  assertEqual((int64_t) 28, pressedLatency);
+
+  LatencyPercentiles percentiles = readLatencies();
+  assertEqual((uint32_t) 1, percentiles.count);
+  assertEqual((uint32_t) 28, percentiles.max);
+}
+
+// An interrupt from a glitch which check() never saw is not attributed to a
+// later state change.
+test(EdgeLatency, stale_interrupt_ignored) {
+  init(false);
+
+  button.markEdge(60);
+  simulator.transition(102, LOW, 0, 1);
+  simulator.runUntil(150);
+  assertEqual((int64_t) 105, button.getEdgeTime());
+  assertEqual((int64_t) 20, pressedLatency);
+}
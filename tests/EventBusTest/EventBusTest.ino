@@ -0,0 +1,130 @@
+#line 2 "EventBusTest.ino"
+
+#include <AUnit.h>
+#include <AceButton.h>
+#include <EventBus.h>
+#include <ace_button/testing/TestableButtonConfig.h>
+#include <ace_button/testing/EventTracker.h>
+#include <ace_button/testing/HelperForButtonConfig.h>
+
+using namespace aunit;
+using namespace ace_button;
+using namespace ace_button::testing;
+
+// --------------------------------------------------------------------------
+
+const uint8_t PIN_A = 2;
+const uint8_t PIN_B = 3;
+
+TestableButtonConfig configA;
+TestableButtonConfig configB;
+AceButton buttonA(&configA);
+AceButton buttonB(&configB);
+EventTracker eventTracker;
+HelperForButtonConfig helperA(&configA, &buttonA, &eventTracker);
+HelperForButtonConfig helperB(&configB, &buttonB, &eventTracker);
+
+EventBus<2, 4> bus;
+
+void setup() {
+#if ! defined(EPOXY_DUINO)
+  delay(1000); // wait to prevent garbage on SERIAL_PORT_MONITOR
+#endif
+
+  SERIAL_PORT_MONITOR.begin(115200);
+  while (!SERIAL_PORT_MONITOR); // wait until ready - Leonardo/Micro only
+
+  bus.attach(&configA, 0);
+  bus.attach(&configB, 1);
+}
+
+void loop() {
+  TestRunner::run();
+}
+
+void drain() {
+  ButtonEvent event;
+  while (bus.pop(event)) {}
+}
+
+// --------------------------------------------------------------------------
+
+test(EventBus, empty) {
+  ButtonEvent event;
+  drain();
+  assertFalse(bus.pop(event));
+}
+
+test(EventBus, merged_in_time_order) {
+  ButtonEvent event;
+  uint8_t expected;
+  drain();
+
+  helperA.init(PIN_A, HIGH, 0);
+  helperB.init(PIN_B, HIGH, 0);
+  helperA.releaseButton(0);
+  helperB.releaseButton(0);
+  helperA.releaseButton(50);
+  helperB.releaseButton(50);
+
+  // B is scanned first, but A's Pressed is older.
+  helperB.pressButton(100);
+  helperB.pressButton(200); // B Pressed @200
+  helperA.pressButton(100);
+  helperA.pressButton(150); // A Pressed @150
+  helperB.releaseButton(300);
+  helperB.releaseButton(350); // B Released @350
+  helperA.releaseButton(250);
+  helperA.releaseButton(300); // A Released @300
+
+  assertTrue(bus.pop(event));
+  assertEqual(PIN_A, event.pin);
+  expected = AceButton::kEventPressed;
+  assertEqual(expected, event.eventType);
+  assertEqual((int64_t) 150, event.eventTime);
+  assertEqual(0, event.source);
+
+  assertTrue(bus.pop(event));
+  assertEqual(PIN_B, event.pin);
+  assertEqual((int64_t) 200, event.eventTime);
+  assertEqual(1, event.source);
+
+  assertTrue(bus.pop(event));
+  assertEqual(PIN_A, event.pin);
+  expected = AceButton::kEventReleased;
+  assertEqual(expected, event.eventType);
+  assertEqual((int32_t) 150, event.duration);
+
+  assertTrue(bus.pop(event));
+  assertEqual(PIN_B, event.pin);
+  assertEqual((int64_t) 350, event.eventTime);
+
+  assertFalse(bus.pop(event));
+}
+
+test(EventBus, horizon) {
+  ButtonEvent event;
+  drain();
+
+  helperA.init(PIN_A, HIGH, 0);
+  helperA.releaseButton(0);
+  helperA.releaseButton(50);
+  helperA.pressButton(100);
+  helperA.pressButton(150); // Pressed @150
+
+  assertFalse(bus.pop(event, 149));
+  assertTrue(bus.pop(event, 150));
+}
+
+test(EventBus, drop_count) {
+  drain();
+  uint32_t dropped = bus.getDropCount(1);
+
+  EventBus<2, 4>::Lane& lane = bus.getLane(1);
+  for (int i = 0; i < 6; i++) {
+    lane.handleEvent(&buttonB, AceButton::kEventHeartBeat, HIGH, i, 0);
+  }
+  assertEqual(dropped + 2, bus.getDropCount(1));
+  assertEqual((uint32_t) 0, bus.getDropCount(0));
+  drain();
+}
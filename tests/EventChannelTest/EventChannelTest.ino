@@ -0,0 +1,108 @@
+#line 2 "EventChannelTest.ino"
+
+#include <thread>
+#include <AUnit.h>
+#include <AceButton.h>
+#include <EventChannel.h>
+#include <ace_button/testing/TestableButtonConfig.h>
+#include <ace_button/testing/EventTracker.h>
+#include <ace_button/testing/HelperForButtonConfig.h>
+
+using namespace aunit;
+using namespace ace_button;
+using namespace ace_button::testing;
+
+// --------------------------------------------------------------------------
+
+const uint8_t PIN = 2;
+
+TestableButtonConfig buttonConfig;
+AceButton button(&buttonConfig);
+EventTracker eventTracker;
+HelperForButtonConfig helper(&buttonConfig, &button, &eventTracker);
+
+EventChannel<4> channel;
+
+void setup() {
+#if ! defined(EPOXY_DUINO)
+  delay(1000); // wait to prevent garbage on SERIAL_PORT_MONITOR
+#endif
+
+  SERIAL_PORT_MONITOR.begin(115200);
+  while (!SERIAL_PORT_MONITOR); // wait until ready - Leonardo/Micro only
+
+  channel.attach(&buttonConfig);
+}
+
+void loop() {
+  TestRunner::run();
+}
+
+void drain() {
+  ButtonEvent event;
+  while (channel.pop(event)) {}
+}
+
+// --------------------------------------------------------------------------
+
+test(EventChannel, poll_and_timeout) {
+  ButtonEvent event;
+  drain();
+
+  assertFalse(channel.waitForEvent(event, 0));
+
+  unsigned long start = millis();
+  assertFalse(channel.waitForEvent(event, 20));
+  assertMoreOrEqual(millis() - start, 20UL);
+}
+
+test(EventChannel, attached_to_button_config) {
+  ButtonEvent event;
+  uint8_t expected;
+  drain();
+
+  helper.init(PIN, HIGH, 0);
+  helper.releaseButton(0);
+  helper.releaseButton(50);
+  helper.pressButton(100);
+  helper.pressButton(150);
+
+  assertTrue(channel.waitForEvent(event, 0));
+  expected = AceButton::kEventPressed;
+  assertEqual(expected, event.eventType);
+  assertEqual((int64_t) 150, event.eventTime);
+  assertFalse(channel.waitForEvent(event, 0));
+}
+
+test(EventChannel, wakes_up_blocked_consumer) {
+  ButtonEvent event;
+  uint8_t expected;
+  drain();
+
+  // The consumer blocks before the producer publishes.
+  std::thread producer([]() {
+    std::this_thread::sleep_for(std::chrono::milliseconds(30));
+    channel.handleEvent(&button, AceButton::kEventClicked, HIGH, 1000, 120);
+  });
+
+  unsigned long start = millis();
+  bool received = channel.waitForEvent(event, EventChannel<4>::kWaitForever);
+  unsigned long elapsed = millis() - start;
+  producer.join();
+
+  assertTrue(received);
+  expected = AceButton::kEventClicked;
+  assertEqual(expected, event.eventType);
+  assertEqual((int32_t) 120, event.duration);
+  assertMoreOrEqual(elapsed, 25UL);
+}
+
+test(EventChannel, drop_count) {
+  drain();
+  uint32_t dropped = channel.getDropCount();
+  for (int i = 0; i < 6; i++) {
+    channel.handleEvent(&button, AceButton::kEventHeartBeat, HIGH, i, 0);
+  }
+  assertEqual(dropped + 2, channel.getDropCount());
+  drain();
+}
@@ -0,0 +1,189 @@
+#line 2 "EventCoalescerTest.ino"
+
+#include <AUnit.h>
+#include <AceButton.h>
+#include <EventCoalescer.h>
+#include <EventBus.h>
+#include <RingBuffer.h>
+
+using namespace aunit;
+using namespace ace_button;
+
+// --------------------------------------------------------------------------
+
+AceButton buttonA(nullptr, 2, HIGH, 0);
+AceButton buttonB(nullptr, 3, HIGH, 1);
+AceButton buttonC(nullptr, 4, HIGH, 2);
+
+void setup() {
+#if ! defined(EPOXY_DUINO)
+  delay(1000); // wait to prevent garbage on SERIAL_PORT_MONITOR
+#endif
+
+  SERIAL_PORT_MONITOR.begin(115200);
+  while (!SERIAL_PORT_MONITOR); // wait until ready - Leonardo/Micro only
+}
+
+void loop() {
+  TestRunner::run();
+}
+
+ButtonEvent makeEvent(AceButton* button, uint8_t eventType, int64_t time) {
+  ButtonEvent event;
+  event.eventTime = time;
+  event.button = button;
+  event.duration = 0;
+  event.eventType = eventType;
+  event.buttonState = LOW;
+  event.source = 0;
+  event.count = 1;
+  event.buttonId = button->getId();
+  event.pin = button->getPin();
+  return event;
+}
+
+// --------------------------------------------------------------------------
+
+test(EventCoalescer, coalesce_when_behind) {
+  RingBuffer<ButtonEvent, 4> ring;
+  EventCoalescer<3> coalescer;
+  ButtonEvent event;
+  uint8_t expected;
+
+  // Fill the ring.
+  for (int i = 0; i < 4; i++) {
+    assertTrue(coalescer.publish(ring,
+        makeEvent(&buttonC, AceButton::kEventPressed, i)));
+  }
+  assertEqual(0, coalescer.getNumStaged());
+
+  // RepeatPressed of A and HeartBeat of B are merged.
+  for (int i = 10; i < 20; i++) {
+    assertTrue(coalescer.publish(ring,
+        makeEvent(&buttonA, AceButton::kEventRepeatPressed, i)));
+    assertTrue(coalescer.publish(ring,
+        makeEvent(&buttonB, AceButton::kEventHeartBeat, i)));
+  }
+  assertEqual(2, coalescer.getNumStaged());
+
+  // The Released of A is queued behind the merged records.
+  assertTrue(coalescer.publish(ring,
+      makeEvent(&buttonA, AceButton::kEventReleased, 20)));
+  assertEqual(3, coalescer.getNumStaged());
+
+  // No slot left for C.
+  assertFalse(coalescer.publish(ring,
+      makeEvent(&buttonC, AceButton::kEventRepeatPressed, 21)));
+
+  // The consumer catches up, the staged records follow in order.
+  for (int i = 0; i < 4; i++) assertTrue(ring.pop(event));
+  coalescer.flush(ring);
+  assertEqual(0, coalescer.getNumStaged());
+
+  assertTrue(ring.pop(event));
+  assertTrue(event.button == &buttonA);
+  expected = AceButton::kEventRepeatPressed;
+  assertEqual(expected, event.eventType);
+  assertEqual((uint16_t) 10, event.count);
+  assertEqual((int64_t) 19, event.eventTime);
+
+  assertTrue(ring.pop(event));
+  assertTrue(event.button == &buttonB);
+  assertEqual((uint16_t) 10, event.count);
+
+  assertTrue(ring.pop(event));
+  assertTrue(event.button == &buttonA);
+  expected = AceButton::kEventReleased;
+  assertEqual(expected, event.eventType);
+  assertFalse(ring.pop(event));
+}
+
+test(EventCoalescer, order_preserved) {
+  RingBuffer<ButtonEvent, 4> ring;
+  EventCoalescer<2> coalescer;
+  ButtonEvent event;
+  uint8_t expected;
+
+  // The ring is not empty, so the RepeatPressed are held and merged.
+  assertTrue(coalescer.publish(ring,
+      makeEvent(&buttonA, AceButton::kEventPressed, 0)));
+  assertTrue(coalescer.publish(ring,
+      makeEvent(&buttonA, AceButton::kEventRepeatPressed, 1)));
+  assertTrue(coalescer.publish(ring,
+      makeEvent(&buttonA, AceButton::kEventRepeatPressed, 2)));
+  assertEqual(1, coalescer.getNumStaged());
+  assertEqual((uint32_t) 1, ring.size());
+
+  // The Released follows the merged RepeatPressed into the ring.
+  assertTrue(coalescer.publish(ring,
+      makeEvent(&buttonA, AceButton::kEventReleased, 3)));
+  assertEqual(0, coalescer.getNumStaged());
+  assertTrue(ring.pop(event));
+  expected = AceButton::kEventPressed;
+  assertEqual(expected, event.eventType);
+  assertTrue(ring.pop(event));
+  expected = AceButton::kEventRepeatPressed;
+  assertEqual(expected, event.eventType);
+  assertEqual((uint16_t) 2, event.count);
+  assertEqual((int64_t) 2, event.eventTime);
+  assertTrue(ring.pop(event));
+  expected = AceButton::kEventReleased;
+  assertEqual(expected, event.eventType);
+  assertFalse(ring.pop(event));
+}
+
+test(EventCoalescer, no_merge_across_released) {
+  RingBuffer<ButtonEvent, 1> ring;
+  EventCoalescer<4> coalescer;
+  ButtonEvent event;
+  uint8_t expected;
+
+  coalescer.publish(ring, makeEvent(&buttonC, AceButton::kEventPressed, 0));
+  coalescer.publish(ring,
+      makeEvent(&buttonA, AceButton::kEventRepeatPressed, 1));
+  coalescer.publish(ring, makeEvent(&buttonA, AceButton::kEventReleased, 2));
+  coalescer.publish(ring, makeEvent(&buttonA, AceButton::kEventPressed, 3));
+  coalescer.publish(ring,
+      makeEvent(&buttonA, AceButton::kEventRepeatPressed, 4));
+  assertEqual(4, coalescer.getNumStaged());
+
+  // The second RepeatPressed is not merged into the first one.
+  const uint8_t types[] = {
+    AceButton::kEventPressed,
+    AceButton::kEventRepeatPressed,
+    AceButton::kEventReleased,
+    AceButton::kEventPressed,
+    AceButton::kEventRepeatPressed,
+  };
+  for (uint8_t i = 0; i < 5; i++) {
+    coalescer.flush(ring);
+    assertTrue(ring.pop(event));
+    expected = types[i];
+    assertEqual(expected, event.eventType);
+    assertEqual((uint16_t) 1, event.count);
+  }
+  assertFalse(ring.pop(event));
+}
+
+test(EventCoalescer, event_bus_lane) {
+  EventBus<1, 2, 1> bus;
+  EventBus<1, 2, 1>::Lane& lane = bus.getLane(0);
+  ButtonEvent event;
+
+  for (int i = 0; i < 50; i++) {
+    lane.handleEvent(&buttonA, AceButton::kEventRepeatPressed, LOW, i, 0);
+  }
+  lane.handleEvent(&buttonA, AceButton::kEventReleased, LOW, 50, 0);
+  assertEqual((uint32_t) 0, bus.getDropCount(0));
+
+  assertTrue(bus.pop(event));
+  assertEqual((uint16_t) 1, event.count);
+  assertTrue(bus.pop(event));
+  assertEqual((uint16_t) 49, event.count);
+  assertEqual((int64_t) 49, event.eventTime);
+  lane.flush();
+  assertTrue(bus.pop(event));
+  uint8_t expected = AceButton::kEventReleased;
+  assertEqual(expected, event.eventType);
+  assertFalse(bus.pop(event));
+}
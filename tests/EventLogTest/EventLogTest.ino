@@ -0,0 +1,252 @@
+#line 2 "EventLogTest.ino"
+
+#include <stdio.h>
+#include <AUnit.h>
+#include <AceButton.h>
+#include <EventLog.h>
+#include <FileLogStorage.h>
+
+using namespace aunit;
+using namespace ace_button;
+
+// --------------------------------------------------------------------------
+
+const char IMAGE_PATH[] = "/tmp/AceButtonEventLogTest.img";
+const uint32_t PAGE_SIZE = 4096;
+const uint32_t NUM_PAGES = 8;
+
+// Events of the throughput test, more than the storage can hold.
+const uint32_t NUM_EVENTS = 50000;
+
+struct Event {
+  int64_t time;
+  uint8_t buttonId;
+  uint8_t eventType;
+};
+
+Event events[NUM_EVENTS];
+
+void setup() {
+#if ! defined(EPOXY_DUINO)
+  delay(1000); // wait to prevent garbage on SERIAL_PORT_MONITOR
+#endif
+
+  SERIAL_PORT_MONITOR.begin(115200);
+  while (!SERIAL_PORT_MONITOR); // wait until ready - Leonardo/Micro only
+}
+
+void loop() {
+  TestRunner::run();
+}
+
+// Generate a deterministic sequence of events of 4 buttons, mostly on the
+// same button, a few ms to a few minutes apart.
+void generateEvents(uint32_t n) {
+  uint32_t seed = 1;
+  int64_t time = 1000;
+  uint8_t buttonId = 0;
+  for (uint32_t i = 0; i < n; i++) {
+    seed = seed * 1664525 + 1013904223;
+    uint32_t r = seed >> 8;
+    if (r % 8 == 0) buttonId = (r >> 3) % 4;
+    time += (r % 4 == 0) ? (r >> 5) % 200000 : (r >> 5) % 400;
+    events[i] = {time, buttonId, (uint8_t) ((r >> 12) % 8)};
+  }
+}
+
+bool appendEvents(EventLog& eventLog, uint32_t begin, uint32_t end) {
+  for (uint32_t i = begin; i < end; i++) {
+    const Event& e = events[i];
+    if (! eventLog.append(e.buttonId, e.eventType, e.time)) return false;
+  }
+  return true;
+}
+
+bool isMatch(const EventLogRecord& record, const Event& event) {
+  return record.eventTime == event.time
+      && record.buttonId == event.buttonId
+      && record.eventType == event.eventType;
+}
+
+// --------------------------------------------------------------------------
+
+test(EventLog, varint) {
+  uint8_t data[EventLogFormat::kMaxVarintSize];
+  assertEqual((uint8_t) 1, EventLogFormat::encodeVarint(127, data));
+  assertEqual((uint8_t) 2, EventLogFormat::encodeVarint(128, data));
+  assertEqual((uint8_t) 0x80, data[0]);
+  assertEqual((uint8_t) 0x01, data[1]);
+  assertEqual((uint8_t) 10, EventLogFormat::encodeVarint(UINT64_MAX, data));
+}
+
+test(EventLog, round_trip) {
+  remove(IMAGE_PATH);
+  FileLogStorage storage(PAGE_SIZE, NUM_PAGES);
+  assertTrue(storage.open(IMAGE_PATH));
+  EventLog eventLog(&storage);
+  assertTrue(eventLog.begin());
+  assertEqual((uint16_t) 0, eventLog.getBootCount());
+
+  generateEvents(100);
+  assertTrue(appendEvents(eventLog, 0, 100));
+
+  EventLogReader reader(&storage);
+  reader.rewind();
+  EventLogRecord record;
+  for (uint32_t i = 0; i < 100; i++) {
+    assertTrue(reader.next(record));
+    assertTrue(isMatch(record, events[i]));
+    assertEqual((uint16_t) 0, record.bootCount);
+  }
+  assertFalse(reader.next(record));
+}
+
+// The ring keeps the newest pages, at a few bytes per event.
+test(EventLog, ring_keeps_newest) {
+  remove(IMAGE_PATH);
+  FileLogStorage storage(PAGE_SIZE, NUM_PAGES);
+  assertTrue(storage.open(IMAGE_PATH));
+  EventLog eventLog(&storage);
+  assertTrue(eventLog.begin());
+
+  generateEvents(NUM_EVENTS);
+  assertTrue(appendEvents(eventLog, 0, NUM_EVENTS));
+  assertMore(eventLog.getNumPagesWritten(), 2 * NUM_PAGES);
+
+  EventLogReader reader(&storage);
+  reader.rewind();
+  EventLogRecord record;
+  assertTrue(reader.next(record));
+
+  // Find the oldest retained event, then all the following ones must match.
+  uint32_t first = 0;
+  while (first < NUM_EVENTS && ! isMatch(record, events[first])) first++;
+  assertLess(first, NUM_EVENTS);
+  uint32_t numRetained = 1;
+  for (uint32_t i = first + 1; i < NUM_EVENTS; i++) {
+    assertTrue(reader.next(record));
+    assertTrue(isMatch(record, events[i]));
+    numRetained++;
+  }
+  assertFalse(reader.next(record));
+
+  // At least 7 full pages are retained, at less than 4 bytes per event.
+  assertMore(numRetained * 4, 7 * (PAGE_SIZE - EventLogFormat::kHeaderSize));
+}
+
+// A reboot starts a new page with the next boot count, after the old events.
+test(EventLog, reboot_and_torn_record) {
+  remove(IMAGE_PATH);
+  FileLogStorage storage(PAGE_SIZE, NUM_PAGES);
+  assertTrue(storage.open(IMAGE_PATH));
+  generateEvents(20);
+  {
+    EventLog eventLog(&storage);
+    assertTrue(eventLog.begin());
+    assertTrue(appendEvents(eventLog, 0, 10));
+  }
+
+  // Simulate a power loss in the middle of a record: a tag which announces a
+  // button id, followed by erased bytes.
+  EventLogRecord record;
+  EventLogReader reader(&storage);
+  uint32_t end = EventLogFormat::kHeaderSize;
+  {
+    EventLogPageReader pageReader(&storage);
+    assertTrue(pageReader.open(0));
+    while (pageReader.next(record)) {}
+    end = pageReader.getOffset();
+  }
+  uint8_t tag = EventLogFormat::kTagButtonId | AceButton::kEventPressed;
+  assertTrue(storage.write(end, &tag, 1));
+
+  EventLog eventLog(&storage);
+  assertTrue(eventLog.begin());
+  assertEqual((uint16_t) 1, eventLog.getBootCount());
+  assertTrue(appendEvents(eventLog, 10, 20));
+
+  reader.rewind();
+  for (uint32_t i = 0; i < 20; i++) {
+    assertTrue(reader.next(record));
+    assertTrue(isMatch(record, events[i]));
+    assertEqual((uint16_t) (i < 10 ? 0 : 1), record.bootCount);
+  }
+  assertFalse(reader.next(record));
+}
+
+// A reboot appends to the newest page after a boot marker, without erasing a
+// page, even though the clock restarted.
+test(EventLog, reboot_appends_to_page) {
+  remove(IMAGE_PATH);
+  FileLogStorage storage(PAGE_SIZE, NUM_PAGES);
+  assertTrue(storage.open(IMAGE_PATH));
+  generateEvents(20);
+  {
+    EventLog eventLog(&storage);
+    assertTrue(eventLog.begin());
+    assertTrue(appendEvents(eventLog, 0, 10));
+    assertEqual((uint32_t) 1, eventLog.getNumPagesWritten());
+  }
+
+  // The clock of the second boot starts again from 0.
+  for (uint32_t i = 10; i < 20; i++) {
+    events[i].time -= events[10].time - 5;
+  }
+  for (uint8_t boot = 1; boot <= 2; boot++) {
+    EventLog eventLog(&storage);
+    assertTrue(eventLog.begin());
+    assertEqual((uint16_t) boot, eventLog.getBootCount());
+    if (boot == 1) assertTrue(appendEvents(eventLog, 10, 20));
+    assertEqual((uint32_t) 0, eventLog.getNumPagesWritten());
+  }
+
+  EventLogRecord record;
+  EventLogReader reader(&storage);
+  reader.rewind();
+  for (uint32_t i = 0; i < 20; i++) {
+    assertTrue(reader.next(record));
+    assertTrue(isMatch(record, events[i]));
+    assertEqual((uint16_t) (i < 10 ? 0 : 1), record.bootCount);
+    assertEqual((uint32_t) 1, record.sequence);
+  }
+  assertFalse(reader.next(record));
+}
+
+// A page of the first format, with 1-byte button ids, is still decoded.
+test(EventLog, decodes_v1_page) {
+  remove(IMAGE_PATH);
+  FileLogStorage storage(PAGE_SIZE, NUM_PAGES);
+  assertTrue(storage.open(IMAGE_PATH));
+  for (uint32_t page = 0; page < NUM_PAGES; page++) {
+    assertTrue(storage.erasePage(page));
+  }
+
+  EventLogFormat::Header header;
+  header.baseTime = 1000;
+  header.sequence = 1;
+  header.bootCount = 3;
+  uint8_t data[EventLogFormat::kHeaderSize + 5];
+  EventLogFormat::encodeHeader(header, data);
+  data[0] = (uint8_t) EventLogFormat::kMagicV1;
+  data[1] = (uint8_t) (EventLogFormat::kMagicV1 >> 8);
+  uint8_t* record = data + EventLogFormat::kHeaderSize;
+  record[0] = EventLogFormat::kTagButtonId | AceButton::kEventPressed;
+  record[1] = 200; // 1-byte button id, not a varint
+  record[2] = 5;
+  record[3] = AceButton::kEventReleased; // same button
+  record[4] = 100;
+  assertTrue(storage.write(0, data, sizeof(data)));
+
+  EventLogReader reader(&storage);
+  reader.rewind();
+  EventLogRecord decoded;
+  assertTrue(reader.next(decoded));
+  assertEqual((uint16_t) 200, decoded.buttonId);
+  assertEqual((int64_t) 1005, decoded.eventTime);
+  assertEqual((uint16_t) 3, decoded.bootCount);
+  assertTrue(reader.next(decoded));
+  assertEqual((uint16_t) 200, decoded.buttonId);
+  assertEqual(AceButton::kEventReleased, decoded.eventType);
+  assertEqual((int64_t) 1105, decoded.eventTime);
+  assertFalse(reader.next(decoded));
+}
@@ -0,0 +1,257 @@
+#line 2 "EventStreamTest.ino"
+
+#include <fcntl.h>
+#include <stdlib.h>
+#include <termios.h>
+#include <unistd.h>
+#include <AUnit.h>
+#include <AceButton.h>
+#include <EventStream.h>
+#include <EventStreamDecoder.h>
+#include <ace_button/testing/TestableButtonConfig.h>
+
+using namespace aunit;
+using namespace ace_button;
+using namespace ace_button::testing;
+
+#if ! ACE_BUTTON_ENABLE_STATS
+  #error Requires -DACE_BUTTON_ENABLE_STATS=1
+#endif
+
+// --------------------------------------------------------------------------
+
+const uint8_t BUTTON_ID = 5;
+
+TestableButtonConfig testableConfig;
+AceButton button(&testableConfig, 2, HIGH, BUTTON_ID);
+
+void setup() {
+#if ! defined(EPOXY_DUINO)
+  delay(1000); // wait to prevent garbage on SERIAL_PORT_MONITOR
+#endif
+
+  SERIAL_PORT_MONITOR.begin(115200);
+  while (!SERIAL_PORT_MONITOR); // wait until ready - Leonardo/Micro only
+}
+
+void loop() {
+  TestRunner::run();
+}
+
+/**
+ * A pseudo-terminal pair in raw mode, standing in for the UART link. The
+ * device writes to the master side, the host reads from the slave side.
+ */
+class PtyLink {
+  public:
+    bool open() {
+      mMaster = posix_openpt(O_RDWR | O_NOCTTY);
+      if (mMaster < 0) return false;
+      if (grantpt(mMaster) != 0 || unlockpt(mMaster) != 0) return false;
+      mSlave = ::open(ptsname(mMaster), O_RDWR | O_NOCTTY | O_NONBLOCK);
+      if (mSlave < 0) return false;
+
+      return makeRaw(mMaster) && makeRaw(mSlave)
+          && fcntl(mMaster, F_SETFL, O_NONBLOCK) == 0;
+    }
+
+    void close() {
+      ::close(mSlave);
+      ::close(mMaster);
+    }
+
+    /** Non-blocking write function for EventStreamWriter::drain(). */
+    uint32_t write(const uint8_t* data, uint32_t size) {
+      ssize_t n = ::write(mMaster, data, size);
+      return (n > 0) ? (uint32_t) n : 0;
+    }
+
+    /** Read and decode the available bytes into messages. */
+    uint32_t receive(EventStreamDecoder& decoder, WireMessage* messages,
+        uint32_t maxMessages) {
+      uint32_t numMessages = 0;
+      uint8_t buffer[256];
+      ssize_t n;
+      while ((n = ::read(mSlave, buffer, sizeof(buffer))) > 0) {
+        for (ssize_t i = 0; i < n; i++) {
+          if (decoder.decode(buffer[i], messages[numMessages])
+              && numMessages < maxMessages - 1) {
+            numMessages++;
+          }
+        }
+      }
+      return numMessages;
+    }
+
+  private:
+    static bool makeRaw(int fd) {
+      struct termios tio;
+      if (tcgetattr(fd, &tio) != 0) return false;
+      cfmakeraw(&tio);
+      return tcsetattr(fd, TCSANOW, &tio) == 0;
+    }
+
+    int mMaster;
+    int mSlave;
+};
+
+void checkAt(unsigned long now, int buttonState) {
+  testableConfig.setClock(now);
+  button.checkState(buttonState);
+}
+
+// --------------------------------------------------------------------------
+
+test(EventStream, crc_and_cobs) {
+  const uint8_t check[] = "123456789";
+  assertEqual((uint16_t) 0x29B1, EventWireFormat::crc16(check, 9));
+
+  const uint8_t data[] = {0x11, 0x22, 0x00, 0x33};
+  uint8_t encoded[8];
+  assertEqual((uint32_t) 5, EventWireFormat::cobsEncode(data, 4, encoded));
+  assertEqual((uint8_t) 0x03, encoded[0]);
+  assertEqual((uint8_t) 0x02, encoded[3]);
+
+  // A run longer than 254 non-zero bytes needs an extra code byte.
+  uint8_t longData[300];
+  for (int i = 0; i < 300; i++) longData[i] = (uint8_t) (i % 255 + 1);
+  longData[280] = 0;
+  uint8_t longEncoded[310];
+  uint8_t decoded[310];
+  uint32_t n = EventWireFormat::cobsEncode(longData, 300, longEncoded);
+  assertEqual((uint32_t) 302, n);
+  for (uint32_t i = 0; i < n; i++) assertNotEqual((uint8_t) 0, longEncoded[i]);
+  assertEqual((int32_t) 300,
+      EventWireFormat::cobsDecode(longEncoded, n, decoded));
+  assertEqual(0, memcmp(longData, decoded, 300));
+}
+
+// Events and counters of an AceButton, end to end over a pseudo-terminal.
+test(EventStream, pty_end_to_end) {
+  PtyLink link;
+  assertTrue(link.open());
+  EventStreamWriter<1024> writer;
+  EventStreamDecoder decoder;
+
+  testableConfig.init();
+  testableConfig.setFeature(ButtonConfig::kFeatureClick);
+  button.init(2, HIGH, BUTTON_ID);
+  writer.attach(&testableConfig);
+  testableConfig.resetStats();
+
+  checkAt(0, HIGH);
+  checkAt(50, HIGH);
+  checkAt(100, LOW);
+  checkAt(150, LOW); // Pressed
+  checkAt(200, HIGH);
+  checkAt(250, HIGH); // Clicked, Released
+  ButtonStats stats;
+  assertTrue(testableConfig.readStats(stats));
+  assertTrue(writer.publishStats(stats));
+  assertTrue(writer.publishStreamCounters());
+
+  auto write = [&link](const uint8_t* data, uint32_t size) {
+    return link.write(data, size);
+  };
+  assertMore(writer.drain(write), (uint32_t) 0);
+  assertEqual((uint32_t) 0, writer.getPendingSize());
+  usleep(10000);
+
+  WireMessage messages[8];
+  uint32_t n = link.receive(decoder, messages, 8);
+  link.close();
+
+  assertEqual((uint32_t) 5, n);
+  assertEqual((uint32_t) 0, decoder.getNumCorrupted());
+  assertEqual((uint32_t) 0, decoder.getNumLost());
+
+  assertEqual(EventWireFormat::kMessageEvent, messages[0].type);
+  assertEqual(BUTTON_ID, messages[0].buttonId);
+  assertEqual(AceButton::kEventPressed, messages[0].eventType);
+  assertEqual((uint8_t) LOW, messages[0].buttonState);
+  assertEqual((uint32_t) 150, messages[0].eventTime);
+  assertEqual(AceButton::kEventClicked, messages[1].eventType);
+  assertEqual(AceButton::kEventReleased, messages[2].eventType);
+  assertEqual((uint32_t) 100, messages[2].duration);
+  assertEqual((uint16_t) 1, messages[2].count);
+
+  assertEqual(EventWireFormat::kMessageCounters, messages[3].type);
+  assertEqual(EventWireFormat::kCounterSetStats, messages[3].counterSet);
+  assertEqual((uint8_t) (sizeof(ButtonStats) / 4), messages[3].numCounters);
+  assertEqual(stats.numChecks, messages[3].counters[0]);
+
+  assertEqual(EventWireFormat::kCounterSetStream, messages[4].counterSet);
+  assertEqual((uint32_t) 4, messages[4].counters[0]); // sent before this one
+  assertEqual((uint32_t) 0, messages[4].counters[1]); // dropped
+  assertEqual((uint16_t) 4, messages[4].sequence);
+}
+
+// Messages dropped by a full transmit ring, and bytes corrupted on the link,
+// are detected by the sequence numbers and the CRC.
+test(EventStream, drops_and_corruption) {
+  EventStreamWriter<64> writer;
+  EventStreamDecoder decoder;
+
+  // A 64-byte ring holds 3 frames of 21 bytes.
+  for (uint8_t i = 0; i < 5; i++) {
+    writer.publishEvent(BUTTON_ID, AceButton::kEventHeartBeat, HIGH, i, 0, 1);
+  }
+  assertEqual((uint32_t) 3, writer.getNumSent());
+  assertEqual((uint32_t) 2, writer.getNumDropped());
+
+  uint8_t bytes[256];
+  uint32_t size = 0;
+  auto capture = [&](const uint8_t* data, uint32_t n) {
+    memcpy(bytes + size, data, n);
+    size += n;
+    return n;
+  };
+  writer.drain(capture);
+  writer.publishEvent(BUTTON_ID, AceButton::kEventHeartBeat, HIGH, 5, 0, 1);
+  writer.publishEvent(BUTTON_ID, AceButton::kEventHeartBeat, HIGH, 6, 0, 1);
+  uint32_t secondBatch = size;
+  writer.drain(capture);
+
+  // Corrupt a byte of the frame of the event at time 5.
+  bytes[secondBatch + 8] ^= 0x40;
+
+  WireMessage message;
+  uint32_t times[8];
+  uint32_t n = 0;
+  for (uint32_t i = 0; i < size; i++) {
+    if (decoder.decode(bytes[i], message)) times[n++] = message.eventTime;
+  }
+
+  assertEqual((uint32_t) 4, n);
+  assertEqual((uint32_t) 0, times[0]);
+  assertEqual((uint32_t) 2, times[2]);
+  assertEqual((uint32_t) 6, times[3]);
+  assertEqual((uint32_t) 1, decoder.getNumCorrupted());
+  assertEqual((uint32_t) 3, decoder.getNumLost()); // 2 dropped, 1 corrupted
+}
+
+// An event message with the 1-byte button id of the older writers.
+test(EventStream, decodes_v1_event) {
+  uint8_t data[EventWireFormat::kEventV1PayloadSize + 2] = {
+      EventWireFormat::kMessageEventV1, 7, 0, // type, sequence
+      200, AceButton::kEventClicked, HIGH, // buttonId, eventType, buttonState
+      0x10, 0x27, 0, 0, // eventTime
+      0x64, 0, 0, 0, // duration
+      1, 0}; // count
+  uint32_t size = EventWireFormat::kEventV1PayloadSize;
+  EventWireFormat::putUint16(data + size, EventWireFormat::crc16(data, size));
+  uint8_t frame[EventWireFormat::kMaxFrameSize];
+  uint32_t n = EventWireFormat::cobsEncode(data, size + 2, frame);
+  frame[n++] = 0;
+
+  EventStreamDecoder decoder;
+  WireMessage message;
+  bool decoded = false;
+  for (uint32_t i = 0; i < n; i++) decoded = decoder.decode(frame[i], message);
+  assertTrue(decoded);
+  assertEqual(EventWireFormat::kMessageEvent, message.type);
+  assertEqual((uint16_t) 200, message.buttonId);
+  assertEqual(AceButton::kEventClicked, message.eventType);
+  assertEqual((uint32_t) 10000, message.eventTime);
+  assertEqual((uint32_t) 100, message.duration);
+}
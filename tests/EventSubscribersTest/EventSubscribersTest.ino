@@ -0,0 +1,130 @@
+#line 2 "EventSubscribersTest.ino"
+
+#include <AUnit.h>
+#include <AceButton.h>
+#include <EventSubscribers.h>
+#include <ace_button/testing/TestableButtonConfig.h>
+#include <ace_button/testing/EventTracker.h>
+#include <ace_button/testing/HelperForButtonConfig.h>
+
+using namespace aunit;
+using namespace ace_button;
+using namespace ace_button::testing;
+
+// --------------------------------------------------------------------------
+
+typedef EventSubscribers<3> Subscribers;
+
+/** An IEventHandler that records its events into its own EventTracker. */
+class TrackingHandler: public IEventHandler {
+  public:
+    void handleEvent(AceButton* button, uint8_t eventType,
+        uint8_t buttonState) override {
+      eventTracker.addEvent(button->getPin(), eventType, buttonState);
+    }
+
+    EventTracker eventTracker;
+};
+
+const uint8_t PIN = 13;
+const uint8_t BUTTON_ID = 1;
+const uint8_t OTHER_BUTTON_ID = 2;
+
+TestableButtonConfig testableConfig;
+AceButton button(&testableConfig);
+EventTracker eventTracker;
+HelperForButtonConfig helper(&testableConfig, &button, &eventTracker);
+
+Subscribers subscribers;
+TrackingHandler ui;
+TrackingHandler logger;
+TrackingHandler power;
+
+void setup() {
+#if ! defined(EPOXY_DUINO)
+  delay(1000); // wait to prevent garbage on SERIAL_PORT_MONITOR
+#endif
+
+  SERIAL_PORT_MONITOR.begin(115200);
+  while (!SERIAL_PORT_MONITOR); // wait until ready - Leonardo/Micro only
+
+  subscribers.attach(&testableConfig);
+}
+
+void loop() {
+  TestRunner::run();
+}
+
+/** Reset the button and subscribers, then press and release the button. */
+void pressAndRelease(uint8_t buttonId) {
+  ui.eventTracker.clear();
+  logger.eventTracker.clear();
+  power.eventTracker.clear();
+
+  helper.init(PIN, HIGH, buttonId);
+  testableConfig.setFeature(ButtonConfig::kFeatureLongPress);
+
+  helper.releaseButton(0);
+  helper.releaseButton(50);
+  helper.pressButton(100);
+  helper.pressButton(150); // Pressed
+  helper.pressButton(1200); // LongPressed
+  helper.releaseButton(1300);
+  helper.releaseButton(1350); // Released
+}
+
+// --------------------------------------------------------------------------
+
+test(EventSubscribers, capacity) {
+  subscribers.clear();
+  assertTrue(subscribers.subscribe(EventDelegate::fromHandler(&ui)));
+  assertTrue(subscribers.subscribe(EventDelegate::fromHandler(&logger)));
+  assertTrue(subscribers.subscribe(EventDelegate::fromHandler(&power)));
+  assertFalse(subscribers.subscribe(EventDelegate::fromHandler(&ui)));
+  assertEqual(3, subscribers.getNumSubscribers());
+
+  assertTrue(subscribers.unsubscribe(EventDelegate::fromHandler(&logger)));
+  assertFalse(subscribers.unsubscribe(EventDelegate::fromHandler(&logger)));
+  assertEqual(2, subscribers.getNumSubscribers());
+}
+
+test(EventSubscribers, event_mask) {
+  uint8_t expected;
+
+  subscribers.clear();
+  subscribers.subscribe(EventDelegate::fromHandler(&ui));
+  subscribers.subscribe(EventDelegate::fromHandler(&logger),
+      Subscribers::kEventMaskPressed | Subscribers::kEventMaskReleased);
+
+  pressAndRelease(BUTTON_ID);
+
+  assertEqual(3, ui.eventTracker.getNumEvents());
+  expected = AceButton::kEventPressed;
+  assertEqual(expected, ui.eventTracker.getRecord(0).getEventType());
+  expected = AceButton::kEventLongPressed;
+  assertEqual(expected, ui.eventTracker.getRecord(1).getEventType());
+  expected = AceButton::kEventReleased;
+  assertEqual(expected, ui.eventTracker.getRecord(2).getEventType());
+
+  assertEqual(2, logger.eventTracker.getNumEvents());
+  expected = AceButton::kEventPressed;
+  assertEqual(expected, logger.eventTracker.getRecord(0).getEventType());
+  expected = AceButton::kEventReleased;
+  assertEqual(expected, logger.eventTracker.getRecord(1).getEventType());
+}
+
+test(EventSubscribers, button_id_filter) {
+  uint8_t expected;
+
+  subscribers.clear();
+  subscribers.subscribe(EventDelegate::fromHandler(&power),
+      Subscribers::kEventMaskLongPressed, BUTTON_ID);
+
+  pressAndRelease(OTHER_BUTTON_ID);
+  assertEqual(0, power.eventTracker.getNumEvents());
+
+  pressAndRelease(BUTTON_ID);
+  assertEqual(1, power.eventTracker.getNumEvents());
+  expected = AceButton::kEventLongPressed;
+  assertEqual(expected, power.eventTracker.getRecord(0).getEventType());
+}
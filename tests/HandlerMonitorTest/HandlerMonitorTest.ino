@@ -0,0 +1,109 @@
+#line 2 "HandlerMonitorTest.ino"
+
+#include <AUnit.h>
+#include <AceButton.h>
+#include <HandlerMonitor.h>
+#include <ace_button/testing/TestableButtonConfig.h>
+#include <ace_button/testing/EventTracker.h>
+#include <ace_button/testing/HelperForButtonConfig.h>
+
+using namespace aunit;
+using namespace ace_button;
+using namespace ace_button::testing;
+
+// --------------------------------------------------------------------------
+
+const uint8_t PIN = 2;
+const uint8_t BUTTON_ID = 7;
+
+TestableButtonConfig testableConfig;
+AceButton button(&testableConfig);
+EventTracker eventTracker;
+HelperForButtonConfig helper(&testableConfig, &button, &eventTracker);
+
+// The handler busy-waits for the given number of micros per event type.
+uint32_t handlerMicros[8];
+uint8_t numHandled;
+
+void slowHandler(AceButton* /*button*/, uint8_t eventType,
+    uint8_t /*buttonState*/) {
+  numHandled++;
+  int64_t start = esp_timer_get_time();
+  while (esp_timer_get_time() - start < handlerMicros[eventType]) {}
+}
+
+uint8_t numCallbacks;
+uint8_t lastOverrunEventType;
+
+void onOverrun(AceButton* /*button*/, uint8_t eventType,
+    uint32_t /*elapsedMicros*/, uint32_t /*budgetMicros*/) {
+  numCallbacks++;
+  lastOverrunEventType = eventType;
+}
+
+HandlerMonitor<2> monitor;
+
+void setup() {
+#if ! defined(EPOXY_DUINO)
+  delay(1000); // wait to prevent garbage on SERIAL_PORT_MONITOR
+#endif
+
+  SERIAL_PORT_MONITOR.begin(115200);
+  while (!SERIAL_PORT_MONITOR); // wait until ready - Leonardo/Micro only
+
+  testableConfig.setEventHandler(slowHandler);
+  monitor.setOverrunCallback(onOverrun, 60000);
+  monitor.attach(&testableConfig);
+}
+
+void loop() {
+  TestRunner::run();
+}
+
+void pressAndRelease(unsigned long time) {
+  helper.pressButton(time);
+  helper.pressButton(time + 50);
+  helper.releaseButton(time + 100);
+  helper.releaseButton(time + 150);
+}
+
+// --------------------------------------------------------------------------
+
+test(HandlerMonitor, default_budget) {
+  // A quarter of the default debounce delay of 20 ms.
+  assertEqual((uint32_t) 5000, monitor.getBudgetMicros());
+}
+
+test(HandlerMonitor, offenders_and_rate_limited_callback) {
+  helper.init(PIN, HIGH, BUTTON_ID);
+  helper.releaseButton(0);
+  helper.releaseButton(50);
+  monitor.clear();
+  numHandled = 0;
+  numCallbacks = 0;
+  handlerMicros[AceButton::kEventPressed] = 0;
+  handlerMicros[AceButton::kEventReleased] = 8000;
+
+  // The handler is still called through the monitor.
+  pressAndRelease(100);
+  assertEqual(2, numHandled);
+  assertEqual((uint32_t) 1, monitor.getNumOverruns());
+  assertEqual(1, numCallbacks);
+  uint8_t expected = AceButton::kEventReleased;
+  assertEqual(expected, lastOverrunEventType);
+
+  // The second overrun is recorded, but its callback is suppressed.
+  pressAndRelease(1000);
+  assertEqual((uint32_t) 2, monitor.getNumOverruns());
+  assertEqual(1, numCallbacks);
+  assertEqual((uint32_t) 1, monitor.getNumSuppressedCallbacks());
+
+  // The slowest offender is ranked first.
+  assertEqual(2, monitor.getNumOffenders());
+  const HandlerMonitor<2>::Offender& worst = monitor.getOffender(0);
+  assertEqual(BUTTON_ID, worst.buttonId);
+  assertEqual(expected, worst.eventType);
+  assertMoreOrEqual(worst.maxMicros, (uint32_t) 8000);
+  assertEqual((uint32_t) 2, worst.numOverruns);
+  assertEqual((uint32_t) 0, monitor.getOffender(1).numOverruns);
+}
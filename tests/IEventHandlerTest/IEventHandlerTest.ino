@@ -26,11 +26,55 @@ class EventHandlerClass: public IEventHandler {
     EventTracker* eventTracker_;
 };
 
+class EventHandler2Class: public IEventHandler2 {
+  public:
+    EventHandler2Class(EventTracker* eventTracker):
+      eventTracker_(eventTracker) {}
+
+    void handleEvent(AceButton* button, uint8_t eventType,
+        uint8_t buttonState, int64_t eventTime, int64_t duration) override {
+      eventTracker_->addEvent(button->getPin(), eventType, buttonState);
+      eventTime_ = eventTime;
+      duration_ = duration;
+    }
+
+    int64_t eventTime() const { return eventTime_; }
+
+    int64_t duration() const { return duration_; }
+
+  private:
+    EventTracker* eventTracker_;
+    int64_t eventTime_ = -1;
+    int64_t duration_ = -1;
+};
+
+class MemberHandler {
+  public:
+    MemberHandler(EventTracker* eventTracker):
+      eventTracker_(eventTracker) {}
+
+    void onEvent(AceButton* button, uint8_t eventType, uint8_t buttonState) {
+      eventTracker_->addEvent(button->getPin(), eventType, buttonState);
+    }
+
+  private:
+    EventTracker* eventTracker_;
+};
+
+EventTracker* staticEventTracker;
+
+void staticHandleEvent(AceButton* button, uint8_t eventType,
+    uint8_t buttonState) {
+  staticEventTracker->addEvent(button->getPin(), eventType, buttonState);
+}
+
 TestableButtonConfig testableConfig;
 AceButton button(&testableConfig);
 EventTracker eventTracker;
 HelperForButtonConfig helper(&testableConfig, &button, &eventTracker);
 EventHandlerClass eventHandler(&eventTracker);
+EventHandler2Class eventHandler2(&eventTracker);
+MemberHandler memberHandler(&eventTracker);
 
 const uint8_t PIN = 13;
 const uint8_t BUTTON_ID = 1;
@@ -95,3 +139,155 @@ test(press_and_release_pullup) {
   assertEqual(expected, eventTracker.getRecord(0).getEventType());
   assertEqual(HIGH, eventTracker.getRecord(0).getButtonState());
 }
+
+// --------------------------------------------------------------------------
+// Test IEventHandler2
+// --------------------------------------------------------------------------
+
+test(press_and_release_with_timing) {
+  const uint8_t DEFAULT_RELEASED_STATE = HIGH;
+  uint8_t expected;
+
+  testableConfig.setIEventHandler2(&eventHandler2);
+  helper.init(PIN, DEFAULT_RELEASED_STATE, BUTTON_ID);
+
+  helper.releaseButton(0);
+  helper.releaseButton(50);
+  assertEqual(0, eventTracker.getNumEvents());
+
+  // Pressed is reported with the time it was detected, and no duration.
+  helper.pressButton(100);
+  helper.pressButton(190);
+  assertEqual(1, eventTracker.getNumEvents());
+  expected = AceButton::kEventPressed;
+  assertEqual(expected, eventTracker.getRecord(0).getEventType());
+  assertEqual((int64_t) 190, eventHandler2.eventTime());
+  assertEqual((int64_t) 0, eventHandler2.duration());
+
+  // Released carries the time since the Pressed event.
+  helper.releaseButton(1000);
+  helper.releaseButton(1060);
+  assertEqual(1, eventTracker.getNumEvents());
+  expected = AceButton::kEventReleased;
+  assertEqual(expected, eventTracker.getRecord(0).getEventType());
+  assertEqual((int64_t) 1060, eventHandler2.eventTime());
+  assertEqual((int64_t) 870, eventHandler2.duration());
+
+  testableConfig.setIEventHandler(&eventHandler);
+}
+
+test(click_with_duration) {
+  const uint8_t DEFAULT_RELEASED_STATE = HIGH;
+  uint8_t expected;
+
+  testableConfig.setIEventHandler2(&eventHandler2);
+  helper.init(PIN, DEFAULT_RELEASED_STATE, BUTTON_ID);
+  testableConfig.setFeature(ButtonConfig::kFeatureClick);
+
+  helper.releaseButton(0);
+  helper.releaseButton(50);
+
+  helper.pressButton(100);
+  helper.pressButton(150);
+  assertEqual(1, eventTracker.getNumEvents());
+
+  // Clicked is dispatched before Released, both with the same duration.
+  helper.releaseButton(200);
+  helper.releaseButton(250);
+  assertEqual(2, eventTracker.getNumEvents());
+  expected = AceButton::kEventClicked;
+  assertEqual(expected, eventTracker.getRecord(0).getEventType());
+  expected = AceButton::kEventReleased;
+  assertEqual(expected, eventTracker.getRecord(1).getEventType());
+  assertEqual((int64_t) 250, eventHandler2.eventTime());
+  assertEqual((int64_t) 100, eventHandler2.duration());
+
+  testableConfig.setIEventHandler(&eventHandler);
+}
+
+// --------------------------------------------------------------------------
+// Test EventDelegate
+// --------------------------------------------------------------------------
+
+test(delegate_null_is_noop) {
+  EventDelegate eventDelegate;
+  assertTrue(eventDelegate.isNull());
+  eventDelegate(&button, AceButton::kEventPressed, LOW, 0, 0);
+
+  assertTrue(EventDelegate::fromFunction(nullptr).isNull());
+  assertTrue(EventDelegate::fromHandler((IEventHandler*) nullptr).isNull());
+}
+
+test(delegate_member_function) {
+  uint8_t expected;
+
+  testableConfig.setEventDelegate(
+      EventDelegate::fromMethod<MemberHandler, &MemberHandler::onEvent>(
+          &memberHandler));
+  assertFalse(testableConfig.isFeature(
+      ButtonConfig::kInternalFeatureIEventHandler));
+  helper.init(PIN, HIGH, BUTTON_ID);
+
+  helper.releaseButton(0);
+  helper.releaseButton(50);
+  helper.pressButton(100);
+  helper.pressButton(190);
+  assertEqual(1, eventTracker.getNumEvents());
+  expected = AceButton::kEventPressed;
+  assertEqual(expected, eventTracker.getRecord(0).getEventType());
+  assertEqual(PIN, eventTracker.getRecord(0).getPin());
+
+  testableConfig.setIEventHandler(&eventHandler);
+}
+
+test(delegate_static_function) {
+  uint8_t expected;
+
+  staticEventTracker = &eventTracker;
+  EventDelegate eventDelegate =
+      EventDelegate::fromFunction<&staticHandleEvent>();
+  assertFalse(eventDelegate.isNull());
+  assertTrue(eventDelegate
+      == EventDelegate::fromFunction<&staticHandleEvent>());
+  assertTrue(eventDelegate != EventDelegate::fromFunction(staticHandleEvent));
+
+  testableConfig.setEventDelegate(eventDelegate);
+  helper.init(PIN, HIGH, BUTTON_ID);
+
+  helper.releaseButton(0);
+  helper.releaseButton(50);
+  helper.pressButton(100);
+  helper.pressButton(190);
+  assertEqual(1, eventTracker.getNumEvents());
+  expected = AceButton::kEventPressed;
+  assertEqual(expected, eventTracker.getRecord(0).getEventType());
+  assertEqual(PIN, eventTracker.getRecord(0).getPin());
+
+  testableConfig.setIEventHandler(&eventHandler);
+}
+
+test(delegate_capturing_lambda) {
+  uint8_t expected;
+  int64_t lastDuration = -1;
+
+  auto lambda = [&lastDuration](AceButton* button, uint8_t eventType,
+      uint8_t buttonState, int64_t /*eventTime*/, int64_t duration) {
+    eventTracker.addEvent(button->getPin(), eventType, buttonState);
+    lastDuration = duration;
+  };
+  testableConfig.setEventDelegate(EventDelegate::fromCallable2(&lambda));
+  helper.init(PIN, HIGH, BUTTON_ID);
+
+  helper.releaseButton(0);
+  helper.releaseButton(50);
+  helper.pressButton(100);
+  helper.pressButton(190);
+  helper.releaseButton(300);
+  helper.releaseButton(400);
+  assertEqual(1, eventTracker.getNumEvents());
+  expected = AceButton::kEventReleased;
+  assertEqual(expected, eventTracker.getRecord(0).getEventType());
+  assertEqual((int64_t) 210, lastDuration);
+
+  testableConfig.setIEventHandler(&eventHandler);
+}
@@ -0,0 +1,111 @@
+#line 2 "LatencyHistogramTest.ino"
+
+#include <AUnit.h>
+#include <AceButton.h>
+#include <ace_button/testing/TestableButtonConfig.h>
+#include <ace_button/testing/EventTracker.h>
+#include <ace_button/testing/HelperForButtonConfig.h>
+
+using namespace aunit;
+using namespace ace_button;
+using namespace ace_button::testing;
+
+#if ! ACE_BUTTON_ENABLE_CHECK_TIMING
+  #error Requires -DACE_BUTTON_ENABLE_CHECK_TIMING=1
+#endif
+
+// --------------------------------------------------------------------------
+
+TestableButtonConfig testableConfig;
+AceButton button(&testableConfig);
+EventTracker eventTracker;
+HelperForButtonConfig helper(&testableConfig, &button, &eventTracker);
+
+void setup() {
+#if ! defined(EPOXY_DUINO)
+  delay(1000); // wait to prevent garbage on SERIAL_PORT_MONITOR
+#endif
+
+  SERIAL_PORT_MONITOR.begin(115200);
+  while (!SERIAL_PORT_MONITOR); // wait until ready - Leonardo/Micro only
+}
+
+void loop() {
+  TestRunner::run();
+}
+
+typedef LatencyHistogram<2> Histogram;
+
+// --------------------------------------------------------------------------
+
+test(LatencyHistogram, buckets) {
+  // Values below 4 have their own bucket.
+  assertEqual((uint16_t) 3, Histogram::toBucket(3));
+  assertEqual((uint32_t) 3, Histogram::bucketUpperBound(3));
+
+  // [4, 8) is split into 4 buckets of width 1, [8, 16) into width 2, ...
+  assertEqual(Histogram::toBucket(8), Histogram::toBucket(9));
+  assertNotEqual(Histogram::toBucket(9), Histogram::toBucket(10));
+  assertEqual((uint32_t) 9, Histogram::bucketUpperBound(
+      Histogram::toBucket(8)));
+  assertEqual((uint32_t) 1279, Histogram::bucketUpperBound(
+      Histogram::toBucket(1100)));
+
+  // Every value falls within the bounds of its bucket.
+  uint32_t values[] = {0, 1, 5, 17, 1000, 65535, 65536, 0x7FFFFFFF,
+      0xFFFFFFFF};
+  for (uint32_t value : values) {
+    uint16_t bucket = Histogram::toBucket(value);
+    assertLess(bucket, Histogram::kNumBuckets);
+    assertLessOrEqual(value, Histogram::bucketUpperBound(bucket));
+    if (bucket > 0) {
+      assertMore(value, Histogram::bucketUpperBound(bucket - 1));
+    }
+  }
+}
+
+test(LatencyHistogram, percentiles) {
+  Histogram histogram;
+  LatencyPercentiles percentiles;
+
+  assertTrue(histogram.readPercentiles(percentiles));
+  assertEqual((uint32_t) 0, percentiles.count);
+  assertEqual((uint32_t) 0, percentiles.p99);
+
+  // 1000 samples at 100, 9 at 1000, 1 at 50000.
+  for (int i = 0; i < 1000; i++) histogram.record(100);
+  for (int i = 0; i < 9; i++) histogram.record(1000);
+  histogram.record(50000);
+
+  assertTrue(histogram.readPercentiles(percentiles));
+  assertEqual((uint32_t) 1010, percentiles.count);
+  assertEqual((uint32_t) 50000, percentiles.max);
+  assertEqual(Histogram::bucketUpperBound(Histogram::toBucket(100)),
+      percentiles.p50);
+  assertEqual(Histogram::bucketUpperBound(Histogram::toBucket(100)),
+      percentiles.p99);
+  assertEqual(Histogram::bucketUpperBound(Histogram::toBucket(1000)),
+      percentiles.p999);
+  assertEqual((uint32_t) 50000, histogram.getPercentile(1, 1));
+
+  histogram.requestReset();
+  histogram.record(7);
+  assertEqual((uint32_t) 1, histogram.getCount());
+  assertEqual((uint32_t) 7, histogram.getMax());
+}
+
+test(LatencyHistogram, check_state_timing) {
+  helper.init(2, HIGH, 0);
+  testableConfig.getCheckStateTimes().requestReset();
+
+  helper.releaseButton(0);
+  helper.releaseButton(50);
+  helper.pressButton(100);
+  helper.pressButton(150);
+
+  LatencyPercentiles percentiles;
+  assertTrue(testableConfig.getCheckStateTimes().readPercentiles(percentiles));
+  assertEqual((uint32_t) 4, percentiles.count);
+  assertLessOrEqual(percentiles.p50, percentiles.p99);
+  assertLessOrEqual(percentiles.p99, percentiles.max);
+}
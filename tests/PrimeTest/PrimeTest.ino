@@ -0,0 +1,163 @@
+#line 2 "PrimeTest.ino"
+
+#include <AUnit.h>
+#include <AceButton.h>
+#include <ButtonGroup.h>
+#include <ace_button/testing/TestableButtonConfig.h>
+#include <ace_button/testing/TestableEncodedButtonConfig.h>
+#include <ace_button/testing/RingEventTracker.h>
+
+using namespace aunit;
+using namespace ace_button;
+using namespace ace_button::testing;
+
+// --------------------------------------------------------------------------
+
+/** A TestableButtonConfig which returns a sequence of raw samples. */
+class SampledButtonConfig: public TestableButtonConfig {
+  public:
+    void setSamples(const int* samples, uint8_t numSamples) {
+      mSamples = samples;
+      mNumSamples = numSamples;
+      mIndex = 0;
+    }
+
+    int readButton(ButtonPinType /*pin*/) override {
+      int sample = mSamples[mIndex];
+      if (mIndex + 1 < mNumSamples) mIndex++;
+      return sample;
+    }
+
+  private:
+    const int* mSamples = nullptr;
+    uint8_t mNumSamples = 0;
+    uint8_t mIndex = 0;
+};
+
+const uint16_t DEBOUNCE_DELAY = 20;
+
+TestableButtonConfig testableConfig;
+SampledButtonConfig sampledConfig;
+RingEventTracker<16> tracker;
+
+const uint8_t ENCODER_PINS[] = {2, 3, 4};
+AceButton encodedButtons[] = {
+  AceButton(nullptr, 1, HIGH, 1),
+  AceButton(nullptr, 2, HIGH, 2),
+  AceButton(nullptr, 3, HIGH, 3),
+};
+TestableEncodedButtonConfig encodedConfig(3, ENCODER_PINS, 3, encodedButtons);
+
+void setup() {
+#if ! defined(EPOXY_DUINO)
+  delay(1000); // wait to prevent garbage on SERIAL_PORT_MONITOR
+#endif
+
+  SERIAL_PORT_MONITOR.begin(115200);
+  while (!SERIAL_PORT_MONITOR); // wait until ready - Leonardo/Micro only
+}
+
+void loop() {
+  TestRunner::run();
+}
+
+// --------------------------------------------------------------------------
+
+// A primed button detects the first press after a single debounce delay,
+// while an unprimed button first spends a debounce delay leaving
+// kButtonStateUnknown.
+test(Prime, first_press_without_initial_debounce) {
+  testableConfig.init();
+  testableConfig.setDebounceDelay(DEBOUNCE_DELAY);
+  tracker.clear();
+  tracker.attach(&testableConfig);
+
+  AceButton unprimed(&testableConfig, 1, HIGH, 1);
+  AceButton primed(&testableConfig, 2, HIGH, 2);
+  assertFalse(primed.prime());
+  assertEqual(HIGH, primed.getLastButtonState());
+  assertEqual(AceButton::kButtonStateUnknown,
+      unprimed.getLastButtonState());
+
+  testableConfig.setButtonState(LOW);
+  testableConfig.setClock(0);
+  unprimed.check();
+  primed.check();
+  testableConfig.setClock(DEBOUNCE_DELAY);
+  unprimed.check();
+  primed.check();
+
+  assertEqual((uint32_t) 1, tracker.size());
+  assertEqual((uint8_t) 2, tracker.getRecord(0).buttonId);
+  assertEqual(AceButton::kEventPressed, tracker.getRecord(0).eventType);
+
+  // The unprimed button has only learned its initial state.
+  assertEqual(LOW, unprimed.getLastButtonState());
+}
+
+// A button held at boot is reported by prime(), without a Pressed event, and
+// its release is detected normally.
+test(Prime, held_at_boot) {
+  testableConfig.init();
+  testableConfig.setDebounceDelay(DEBOUNCE_DELAY);
+  tracker.clear();
+  tracker.attach(&testableConfig);
+
+  AceButton button(&testableConfig, 1, HIGH, 1);
+  testableConfig.setButtonState(LOW);
+  assertTrue(button.prime());
+  assertTrue(button.isPressed());
+
+  testableConfig.setClock(0);
+  button.check();
+  assertEqual((uint32_t) 0, tracker.size());
+
+  testableConfig.setButtonState(HIGH);
+  testableConfig.setClock(100);
+  button.check();
+  testableConfig.setClock(100 + DEBOUNCE_DELAY);
+  button.check();
+  assertEqual((uint32_t) 1, tracker.size());
+  assertEqual(AceButton::kEventReleased, tracker.getRecord(0).eventType);
+  assertFalse(button.isPressed());
+}
+
+test(Prime, majority_sampling) {
+  sampledConfig.init();
+  AceButton button(&sampledConfig, 1, HIGH, 1);
+
+  // A single glitch is rejected.
+  static const int GLITCH[] = {HIGH, LOW, HIGH, HIGH, HIGH};
+  sampledConfig.setSamples(GLITCH, 5);
+  assertFalse(button.prime(5));
+
+  static const int HELD[] = {LOW, LOW, HIGH, LOW, LOW};
+  sampledConfig.setSamples(HELD, 5);
+  assertTrue(button.prime(5));
+
+  // A tie is resolved as released.
+  static const int TIE[] = {LOW, HIGH};
+  sampledConfig.setSamples(TIE, 2);
+  assertFalse(button.prime(2));
+  assertEqual(HIGH, button.getLastButtonState());
+}
+
+test(Prime, encoded_and_group) {
+  encodedConfig.init();
+  encodedConfig.setVirtualPin(2);
+  assertEqual((ButtonCountType) 1, encodedConfig.primeButtons(3));
+  assertFalse(encodedButtons[0].isPressed());
+  assertTrue(encodedButtons[1].isPressed());
+  assertFalse(encodedButtons[2].isPressed());
+
+  CompactButton compactButtons[] = {
+    CompactButton(1, HIGH, 1),
+    CompactButton(2, LOW, 2),
+  };
+  testableConfig.init();
+  testableConfig.setButtonState(HIGH);
+  ButtonGroup group(&testableConfig, compactButtons, 2);
+  assertEqual((ButtonCountType) 1, group.primeButtons());
+  assertFalse(compactButtons[0].isPressed());
+  assertTrue(compactButtons[1].isPressed());
+}
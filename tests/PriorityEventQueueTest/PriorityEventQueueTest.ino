@@ -0,0 +1,180 @@
+#line 2 "PriorityEventQueueTest.ino"
+
+#include <AUnit.h>
+#include <AceButton.h>
+#include <PriorityEventQueue.h>
+#include <ace_button/testing/TestableButtonConfig.h>
+#include <ace_button/testing/EventTracker.h>
+#include <ace_button/testing/HelperForButtonConfig.h>
+
+using namespace aunit;
+using namespace ace_button;
+using namespace ace_button::testing;
+
+// --------------------------------------------------------------------------
+
+const uint8_t PIN = 2;
+const uint8_t ESTOP_ID = 200;
+const uint8_t OTHER_ID = 1;
+
+TestableButtonConfig buttonConfig;
+AceButton button(&buttonConfig);
+AceButton estopButton(nullptr, 3, HIGH, ESTOP_ID);
+AceButton otherButton(nullptr, 4, HIGH, OTHER_ID);
+EventTracker eventTracker;
+HelperForButtonConfig helper(&buttonConfig, &button, &eventTracker);
+
+typedef PriorityEventQueue<8, 4> Queue;
+Queue queue;
+
+void setup() {
+#if ! defined(EPOXY_DUINO)
+  delay(1000); // wait to prevent garbage on SERIAL_PORT_MONITOR
+#endif
+
+  SERIAL_PORT_MONITOR.begin(115200);
+  while (!SERIAL_PORT_MONITOR); // wait until ready - Leonardo/Micro only
+
+  queue.setHighPriorityButton(ESTOP_ID);
+  queue.attach(&buttonConfig);
+}
+
+void loop() {
+  TestRunner::run();
+}
+
+void drain() {
+  ButtonEvent event;
+  while (queue.pop(event)) {}
+}
+
+// --------------------------------------------------------------------------
+
+test(PriorityEventQueue, classification) {
+  assertEqual(Queue::kPriorityHigh,
+      queue.getPriority(ESTOP_ID, AceButton::kEventHeartBeat));
+  assertEqual(Queue::kPriorityNormal,
+      queue.getPriority(OTHER_ID, AceButton::kEventPressed));
+
+  queue.setHighPriorityEvents(1 << AceButton::kEventPressed);
+  assertEqual(Queue::kPriorityHigh,
+      queue.getPriority(OTHER_ID, AceButton::kEventPressed));
+  assertEqual(Queue::kPriorityNormal,
+      queue.getPriority(OTHER_ID, AceButton::kEventReleased));
+  queue.setHighPriorityEvents(0);
+
+  queue.setHighPriorityButton(OTHER_ID + 32);
+  assertEqual(Queue::kPriorityNormal,
+      queue.getPriority(OTHER_ID, AceButton::kEventPressed));
+  queue.setHighPriorityButton(OTHER_ID + 32, false);
+  assertEqual(Queue::kPriorityNormal,
+      queue.getPriority(OTHER_ID + 32, AceButton::kEventPressed));
+
+  // An id which does not fit in ButtonIdType is rejected.
+  assertFalse(queue.setHighPriorityButton(70000));
+  assertTrue(queue.setHighPriorityButton(255));
+  assertEqual(Queue::kPriorityHigh,
+      queue.getPriority(255, AceButton::kEventPressed));
+  queue.setHighPriorityButton(255, false);
+}
+
+test(PriorityEventQueue, attached_to_button_config) {
+  ButtonEvent event;
+  drain();
+
+  helper.init(PIN, HIGH, 0);
+  helper.releaseButton(0);
+  helper.releaseButton(50);
+  helper.pressButton(100);
+  helper.pressButton(150);
+
+  assertEqual((uint32_t) 1, queue.size());
+  assertTrue(queue.pop(event));
+  assertEqual(PIN, event.pin);
+  assertEqual((int64_t) 150, event.eventTime);
+  assertEqual(Queue::kPriorityNormal, event.source);
+}
+
+test(PriorityEventQueue, high_priority_bypasses_normal) {
+  ButtonEvent event;
+  uint8_t expected;
+  drain();
+
+  for (int i = 0; i < 5; i++) {
+    queue.handleEvent(&otherButton, AceButton::kEventRepeatPressed, LOW, i, 0);
+  }
+  queue.handleEvent(&estopButton, AceButton::kEventPressed, LOW, 10, 0);
+  assertEqual((uint32_t) 1, queue.getHighSize());
+
+  assertTrue(queue.pop(event));
+  assertEqual(ESTOP_ID, event.buttonId);
+  expected = AceButton::kEventPressed;
+  assertEqual(expected, event.eventType);
+  assertEqual(Queue::kPriorityHigh, event.source);
+
+  assertTrue(queue.pop(event));
+  assertEqual((int64_t) 0, event.eventTime);
+  drain();
+}
+
+test(PriorityEventQueue, drop_counts) {
+  drain();
+  uint32_t normalDropped = queue.getNormalDropCount();
+  uint32_t highDropped = queue.getHighDropCount();
+
+  for (int i = 0; i < 10; i++) {
+    queue.handleEvent(&otherButton, AceButton::kEventHeartBeat, HIGH, i, 0);
+  }
+  for (int i = 0; i < 5; i++) {
+    queue.handleEvent(&estopButton, AceButton::kEventHeartBeat, HIGH, i, 0);
+  }
+  assertEqual(normalDropped + 2, queue.getNormalDropCount());
+  assertEqual(highDropped + 1, queue.getHighDropCount());
+  drain();
+}
+
+// Simulate a flood of RepeatPressed and HeartBeat events which arrive faster
+// than the consumer can process them, with an E-stop Pressed every 100 ticks.
+// The consumer processes one event per tick. Measure the delivery latency of
+// each event in ticks, from its eventTime to the tick when it is popped.
+test(PriorityEventQueue, latency_under_load) {
+  const int64_t kTicks = 1000;
+  PriorityEventQueue<64, 4> loaded;
+  loaded.setHighPriorityButton(ESTOP_ID);
+
+  int64_t maxHighLatency = 0;
+  int64_t maxNormalLatency = 0;
+  uint16_t numHigh = 0;
+  for (int64_t now = 0; now < kTicks; now++) {
+    // Producer: 3 normal events per tick.
+    loaded.handleEvent(&otherButton, AceButton::kEventRepeatPressed, LOW,
+        now, 0);
+    loaded.handleEvent(&otherButton, AceButton::kEventHeartBeat, LOW,
+        now, 0);
+    loaded.handleEvent(&button, AceButton::kEventHeartBeat, HIGH, now, 0);
+    if (now % 100 == 50) {
+      loaded.handleEvent(&estopButton, AceButton::kEventPressed, LOW, now, 0);
+    }
+
+    // Consumer: 1 event per tick.
+    ButtonEvent event;
+    if (loaded.pop(event)) {
+      int64_t latency = now - event.eventTime;
+      if (event.source == Queue::kPriorityHigh) {
+        numHigh++;
+        if (latency > maxHighLatency) maxHighLatency = latency;
+      } else {
+        if (latency > maxNormalLatency) maxNormalLatency = latency;
+      }
+    }
+  }
+
+  // The normal ring is saturated, so its events wait for up to its capacity
+  // divided by the net fill rate. The E-stop is always delivered in the same
+  // tick.
+  assertEqual((uint16_t) (kTicks / 100), numHigh);
+  assertEqual((int64_t) 0, maxHighLatency);
+  assertMore(maxNormalLatency, (int64_t) 20);
+  assertEqual((uint32_t) 0, loaded.getHighDropCount());
+  assertMore(loaded.getNormalDropCount(), (uint32_t) 0);
+}
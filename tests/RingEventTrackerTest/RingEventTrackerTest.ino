@@ -0,0 +1,132 @@
+#line 2 "RingEventTrackerTest.ino"
+
+#include <AUnit.h>
+#include <AceButton.h>
+#include <ace_button/testing/TestableButtonConfig.h>
+#include <ace_button/testing/RingEventTracker.h>
+
+using namespace aunit;
+using namespace ace_button;
+using namespace ace_button::testing;
+
+// --------------------------------------------------------------------------
+
+const uint8_t PIN = 13;
+const uint8_t BUTTON_ID = 3;
+
+// Number of clicks of the stress test, 3 events each.
+const uint32_t NUM_CLICKS = 100000;
+const uint32_t NUM_STRESS_EVENTS = 3 * NUM_CLICKS;
+
+TestableButtonConfig testableConfig;
+AceButton button(&testableConfig, PIN, HIGH, BUTTON_ID);
+RingEventTracker<8> smallTracker;
+RingEventTracker<(uint32_t) 1 << 19> stressTracker;
+TimedEventRecord expected[NUM_STRESS_EVENTS];
+
+void setup() {
+#if ! defined(EPOXY_DUINO)
+  delay(1000); // wait to prevent garbage on SERIAL_PORT_MONITOR
+#endif
+
+  SERIAL_PORT_MONITOR.begin(115200);
+  while (!SERIAL_PORT_MONITOR); // wait until ready - Leonardo/Micro only
+}
+
+void loop() {
+  TestRunner::run();
+}
+
+TimedEventRecord makeRecord(uint32_t time, uint8_t eventType,
+    uint8_t buttonState) {
+  TimedEventRecord record = {time, BUTTON_ID, PIN, eventType, buttonState};
+  return record;
+}
+
+void checkAt(uint32_t time, int buttonState) {
+  testableConfig.setClock(time);
+  button.checkState(buttonState);
+}
+
+// --------------------------------------------------------------------------
+
+test(RingEventTracker, record_size) {
+  assertEqual((size_t) 8, sizeof(TimedEventRecord));
+}
+
+test(RingEventTracker, overwrites_oldest) {
+  smallTracker.clear();
+  for (uint32_t i = 0; i < 20; i++) {
+    smallTracker.addEvent(BUTTON_ID, PIN, AceButton::kEventPressed, LOW, i);
+  }
+
+  assertEqual((uint32_t) 8, smallTracker.size());
+  assertEqual((uint64_t) 20, smallTracker.getNumEvents());
+  assertEqual((uint64_t) 12, smallTracker.getNumDropped());
+  assertEqual((uint32_t) 12, smallTracker.getRecord(0).time);
+  assertEqual((uint32_t) 19, smallTracker.getRecord(7).time);
+}
+
+test(RingEventTracker, compare_reports_first_divergence) {
+  smallTracker.clear();
+  TimedEventRecord records[10];
+  for (uint32_t i = 0; i < 10; i++) {
+    records[i] = makeRecord(100 + i, AceButton::kEventPressed, LOW);
+    smallTracker.addEvent(BUTTON_ID, PIN, AceButton::kEventPressed, LOW,
+        100 + i);
+  }
+
+  // The 2 oldest were overwritten, the ring has wrapped.
+  EventDivergence d = smallTracker.compare(&records[2], 8);
+  assertTrue(d.matched);
+
+  records[6].eventType = AceButton::kEventReleased;
+  d = smallTracker.compare(&records[2], 8);
+  assertFalse(d.matched);
+  assertEqual((uint32_t) 4, d.index);
+  assertEqual(AceButton::kEventReleased, d.expected.eventType);
+  assertEqual(AceButton::kEventPressed, d.actual.eventType);
+  records[6].eventType = AceButton::kEventPressed;
+
+  // Times within the tolerance.
+  records[9].time += 2;
+  assertFalse(smallTracker.compare(&records[2], 8).matched);
+  assertTrue(smallTracker.compare(&records[2], 8, 2).matched);
+
+  // A shorter expected sequence diverges at its end.
+  d = smallTracker.compare(&records[2], 7, 2);
+  assertFalse(d.matched);
+  assertEqual((uint32_t) 7, d.index);
+  assertEqual((uint32_t) 0, d.expected.time);
+  assertEqual((uint32_t) 109, d.actual.time);
+}
+
+test(RingEventTracker, stress_clicks) {
+  testableConfig.init();
+  testableConfig.setFeature(ButtonConfig::kFeatureClick);
+  button.init(PIN, HIGH, BUTTON_ID);
+  stressTracker.clear();
+  stressTracker.attach(&testableConfig);
+
+  checkAt(0, HIGH);
+  checkAt(50, HIGH);
+  uint32_t n = 0;
+  for (uint32_t i = 0; i < NUM_CLICKS; i++) {
+    uint32_t t = 100 + i * 200;
+    checkAt(t, LOW);
+    checkAt(t + 50, LOW); // Pressed
+    expected[n++] = makeRecord(t + 50, AceButton::kEventPressed, LOW);
+    checkAt(t + 100, HIGH);
+    checkAt(t + 150, HIGH); // Clicked, Released
+    expected[n++] = makeRecord(t + 150, AceButton::kEventClicked, HIGH);
+    expected[n++] = makeRecord(t + 150, AceButton::kEventReleased, HIGH);
+  }
+
+  assertEqual((uint64_t) NUM_STRESS_EVENTS, stressTracker.getNumEvents());
+  assertTrue(stressTracker.compare(expected, NUM_STRESS_EVENTS).matched);
+
+  expected[123456].time++;
+  EventDivergence d = stressTracker.compare(expected, NUM_STRESS_EVENTS);
+  assertFalse(d.matched);
+  assertEqual((uint32_t) 123456, d.index);
+}
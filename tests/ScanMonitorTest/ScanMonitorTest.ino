@@ -0,0 +1,101 @@
+#line 2 "ScanMonitorTest.ino"
+
+#include <AUnit.h>
+#include <AceButton.h>
+#include <ace_button/testing/TestableButtonConfig.h>
+
+using namespace aunit;
+using namespace ace_button;
+using namespace ace_button::testing;
+
+#if ! ACE_BUTTON_ENABLE_SCAN_MONITOR
+  #error Requires -DACE_BUTTON_ENABLE_SCAN_MONITOR=1
+#endif
+
+// --------------------------------------------------------------------------
+
+TestableButtonConfig testableConfig;
+AceButton button1(&testableConfig, 1, HIGH, 1);
+AceButton button2(&testableConfig, 2, HIGH, 2);
+
+void setup() {
+#if ! defined(EPOXY_DUINO)
+  delay(1000); // wait to prevent garbage on SERIAL_PORT_MONITOR
+#endif
+
+  SERIAL_PORT_MONITOR.begin(115200);
+  while (!SERIAL_PORT_MONITOR); // wait until ready - Leonardo/Micro only
+}
+
+void loop() {
+  TestRunner::run();
+}
+
+// Scan both buttons at the given time, as a loop() would.
+void scan(unsigned long now) {
+  testableConfig.setClock(now);
+  button1.checkState(HIGH);
+  button2.checkState(HIGH);
+}
+
+void init() {
+  testableConfig.init();
+  testableConfig.getScanMonitor().requestReset();
+}
+
+// --------------------------------------------------------------------------
+
+test(ScanMonitor, one_interval_per_scan) {
+  init();
+  const ScanMonitor& monitor = testableConfig.getScanMonitor();
+
+  // 20 ms debounce delay: scans must be at most 5 ms apart.
+  scan(0);
+  scan(5);
+  scan(10);
+  scan(15);
+
+  assertEqual((uint32_t) 3, monitor.getNumScans());
+  assertEqual((uint32_t) 0, monitor.getNumLateScans());
+  assertEqual((uint32_t) 5, monitor.getMaxGap());
+  assertEqual((uint32_t) 3, monitor.getGaps().getCount());
+}
+
+test(ScanMonitor, late_scans) {
+  init();
+  const ScanMonitor& monitor = testableConfig.getScanMonitor();
+
+  scan(100);
+  scan(104);
+  scan(110); // late by 1 ms
+  scan(150); // starved for 40 ms
+  scan(152);
+
+  assertEqual((uint32_t) 4, monitor.getNumScans());
+  assertEqual((uint32_t) 2, monitor.getNumLateScans());
+  assertEqual((uint32_t) 40, monitor.getMaxGap());
+
+  LatencyPercentiles percentiles;
+  assertTrue(monitor.getGaps().readPercentiles(percentiles));
+  assertEqual((uint32_t) 40, percentiles.max);
+}
+
+test(ScanMonitor, reset_latches_new_lead) {
+  init();
+  const ScanMonitor& monitor = testableConfig.getScanMonitor();
+
+  scan(0);
+  scan(30);
+  assertEqual((uint32_t) 1, monitor.getNumLateScans());
+
+  // After the reset, button2 alone is scanned and becomes the lead.
+  testableConfig.getScanMonitor().requestReset();
+  testableConfig.setClock(40);
+  button2.checkState(HIGH);
+  testableConfig.setClock(44);
+  button2.checkState(HIGH);
+
+  assertEqual((uint32_t) 1, monitor.getNumScans());
+  assertEqual((uint32_t) 0, monitor.getNumLateScans());
+  assertEqual((uint32_t) 4, monitor.getMaxGap());
+}
@@ -0,0 +1,177 @@
+#line 2 "SleepStateTest.ino"
+
+#include <AUnit.h>
+#include <string.h>
+#include <AceButton.h>
+#include <ButtonGroup.h>
+#include <ace_button/testing/TestableButtonConfig.h>
+#include <ace_button/testing/RingEventTracker.h>
+
+using namespace aunit;
+using namespace ace_button;
+using namespace ace_button::testing;
+
+// --------------------------------------------------------------------------
+
+const uint16_t DEBOUNCE_DELAY = 20;
+const uint16_t LONG_PRESS_DELAY = 1000;
+
+TestableButtonConfig testableConfig;
+RingEventTracker<16> tracker;
+
+// Stands in for the RTC memory which survives the deep sleep.
+ButtonCore::SavedState rtcState;
+ButtonCore::SavedState rtcStates[3];
+
+void setup() {
+#if ! defined(EPOXY_DUINO)
+  delay(1000); // wait to prevent garbage on SERIAL_PORT_MONITOR
+#endif
+
+  SERIAL_PORT_MONITOR.begin(115200);
+  while (!SERIAL_PORT_MONITOR); // wait until ready - Leonardo/Micro only
+}
+
+void loop() {
+  TestRunner::run();
+}
+
+// --------------------------------------------------------------------------
+
+void initConfig() {
+  testableConfig.init();
+  testableConfig.setDebounceDelay(DEBOUNCE_DELAY);
+  testableConfig.setLongPressDelay(LONG_PRESS_DELAY);
+  testableConfig.setFeature(ButtonConfig::kFeatureLongPress);
+  tracker.clear();
+  tracker.attach(&testableConfig);
+}
+
+/** Debounce the button into the given state, starting at the given time. */
+void settle(AceButton& button, int state, unsigned long time) {
+  testableConfig.setButtonState(state);
+  testableConfig.setClock(time);
+  button.check();
+  testableConfig.setClock(time + DEBOUNCE_DELAY);
+  button.check();
+}
+
+test(SleepState, compact_size) {
+  assertEqual((size_t) 16, sizeof(ButtonCore::SavedState));
+}
+
+// A press which started before the deep sleep becomes a long press after
+// the wake, even though the clock restarted from zero.
+test(SleepState, long_press_survives_sleep) {
+  initConfig();
+  {
+    AceButton button(&testableConfig, 1, HIGH, 7);
+    settle(button, HIGH, 0);
+    settle(button, LOW, 100); // Pressed at 120
+    assertEqual((uint32_t) 1, tracker.size());
+    testableConfig.setClock(300);
+    button.saveState(rtcState);
+  }
+
+  // Sleep for 500 ms, then reboot with a fresh button and clock, and restore
+  // 10 ms after the boot.
+  tracker.clear();
+  AceButton button(&testableConfig, 1, HIGH, 7);
+  testableConfig.setClock(10);
+  assertTrue(button.restoreState(rtcState, 510));
+  assertTrue(button.isPressed());
+
+  // 10 + 500 + 180 = 690 ms since the press, no event yet.
+  button.check();
+  assertEqual((uint32_t) 0, tracker.size());
+
+  // 1000 ms since the press.
+  testableConfig.setClock(320);
+  button.check();
+  assertEqual((uint32_t) 1, tracker.size());
+  assertEqual(AceButton::kEventLongPressed, tracker.getRecord(0).eventType);
+  assertEqual((uint8_t) 7, tracker.getRecord(0).buttonId);
+}
+
+// A button pressed to wake the device is detected after a single debounce
+// delay.
+test(SleepState, wake_press_after_one_debounce) {
+  initConfig();
+  {
+    AceButton button(&testableConfig, 1, HIGH, 7);
+    settle(button, HIGH, 0);
+    button.saveState(rtcState);
+  }
+
+  tracker.clear();
+  AceButton button(&testableConfig, 1, HIGH, 7);
+  testableConfig.setClock(0);
+  assertTrue(button.restoreState(rtcState, 60000));
+  settle(button, LOW, 0);
+
+  assertEqual((uint32_t) 1, tracker.size());
+  assertEqual(AceButton::kEventPressed, tracker.getRecord(0).eventType);
+  assertEqual((uint32_t) DEBOUNCE_DELAY, tracker.getRecord(0).time);
+}
+
+test(SleepState, invalid_state_is_rejected) {
+  initConfig();
+  ButtonCore::SavedState garbage;
+  memset(&garbage, 0xA5, sizeof(garbage));
+
+  AceButton button(&testableConfig, 1, HIGH, 7);
+  assertFalse(button.restoreState(garbage));
+  assertEqual(AceButton::kButtonStateUnknown, button.getLastButtonState());
+
+  garbage.crc = ButtonCore::kSavedStateVersion;
+  assertFalse(button.restoreState(garbage));
+  garbage.lastButtonState = HIGH;
+  assertFalse(button.restoreState(garbage));
+  assertEqual(AceButton::kButtonStateUnknown, button.getLastButtonState());
+}
+
+test(SleepState, corrupted_state_is_rejected) {
+  initConfig();
+  AceButton button(&testableConfig, 1, HIGH, 7);
+  settle(button, LOW, 0);
+  ButtonCore::SavedState state;
+  button.saveState(state);
+
+  // A single changed byte, e.g. a state torn by a reset during saveState(),
+  // does not match the crc.
+  uint8_t* data = reinterpret_cast<uint8_t*>(&state);
+  for (size_t i = 0; i < sizeof(state); i++) {
+    data[i] ^= 0x10;
+    AceButton restored(&testableConfig, 1, HIGH, 7);
+    assertFalse(restored.restoreState(state));
+    data[i] ^= 0x10;
+  }
+
+  AceButton restored(&testableConfig, 1, HIGH, 7);
+  assertTrue(restored.restoreState(state));
+  assertEqual(LOW, restored.getLastButtonState());
+}
+
+test(SleepState, group_save_and_restore) {
+  initConfig();
+  CompactButton buttons[] = {
+    CompactButton(1, HIGH, 1),
+    CompactButton(2, HIGH, 2),
+    CompactButton(3, LOW, 3),
+  };
+  ButtonGroup group(&testableConfig, buttons, 3);
+  testableConfig.setButtonState(HIGH);
+  group.primeButtons();
+  group.saveButtons(rtcStates);
+
+  CompactButton wokenButtons[] = {
+    CompactButton(1, HIGH, 1),
+    CompactButton(2, HIGH, 2),
+    CompactButton(3, LOW, 3),
+  };
+  ButtonGroup wokenGroup(&testableConfig, wokenButtons, 3);
+  assertEqual((ButtonCountType) 3, wokenGroup.restoreButtons(rtcStates, 1000));
+  assertFalse(wokenButtons[0].isPressed());
+  assertTrue(wokenButtons[2].isPressed());
+  assertEqual(LOW, wokenButtons[2].getDefaultReleasedState());
+}
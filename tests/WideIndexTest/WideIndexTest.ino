@@ -0,0 +1,190 @@
+#line 2 "WideIndexTest.ino"
+
+#include <AUnit.h>
+#include <AceButton.h>
+#include <ButtonArray.h>
+#include <EventLog.h>
+#include <EventStream.h>
+#include <EventStreamDecoder.h>
+#include <EventSubscribers.h>
+#include <FileLogStorage.h>
+#include <PriorityEventQueue.h>
+#include <ace_button/testing/TestableButtonConfig.h>
+#include <ace_button/testing/TestableEncodedButtonConfig.h>
+#include <ace_button/testing/RingEventTracker.h>
+
+using namespace aunit;
+using namespace ace_button;
+using namespace ace_button::testing;
+
+// --------------------------------------------------------------------------
+
+const uint16_t NUM_BUTTONS = 600;
+const uint8_t NUM_ENCODER_PINS = 10;
+const uint8_t ENCODER_PINS[NUM_ENCODER_PINS] = {
+    0, 1, 2, 3, 4, 5, 6, 7, 8, 9};
+
+TestableButtonConfig testableConfig;
+TestableEncodedButtonConfig encodedConfig(
+    NUM_ENCODER_PINS, ENCODER_PINS, 0, (AceButton*) nullptr);
+ButtonArray<NUM_BUTTONS> buttons;
+RingEventTracker<16> tracker;
+
+/** Counts the events which pass the filter of the EventSubscribers. */
+class CountingHandler: public IEventHandler {
+  public:
+    void handleEvent(AceButton* /*button*/, uint8_t /*eventType*/,
+        uint8_t /*buttonState*/) override {
+      count++;
+    }
+
+    uint16_t count = 0;
+};
+
+void setup() {
+#if ! defined(EPOXY_DUINO)
+  delay(1000); // wait to prevent garbage on SERIAL_PORT_MONITOR
+#endif
+
+  SERIAL_PORT_MONITOR.begin(115200);
+  while (!SERIAL_PORT_MONITOR); // wait until ready - Leonardo/Micro only
+}
+
+void loop() {
+  TestRunner::run();
+}
+
+// --------------------------------------------------------------------------
+
+/** Press then release the button, with enough time to debounce each. */
+void pressAndRelease(AceButton& button, int64_t start) {
+  testableConfig.setClock(start);
+  button.checkState(HIGH);
+  testableConfig.setClock(start + 50);
+  button.checkState(HIGH);
+  testableConfig.setClock(start + 100);
+  button.checkState(LOW);
+  testableConfig.setClock(start + 150);
+  button.checkState(LOW);
+  testableConfig.setClock(start + 200);
+  button.checkState(HIGH);
+  testableConfig.setClock(start + 250);
+  button.checkState(HIGH);
+}
+
+test(WideIndex, pin_and_id_are_16_bits) {
+  assertEqual(sizeof(uint16_t), sizeof(ButtonPinType));
+  assertEqual(sizeof(uint16_t), sizeof(ButtonIdType));
+  assertEqual(sizeof(uint16_t), sizeof(ButtonCountType));
+
+  AceButton button(&testableConfig, 1000, HIGH, 3000);
+  assertEqual((ButtonPinType) 1000, button.getPin());
+  assertEqual((ButtonIdType) 3000, button.getId());
+
+  // The wide fields fit in the padding before the int64_t fields.
+  assertEqual((size_t) (8 + sizeof(void*) + 5 * sizeof(int64_t)),
+      sizeof(AceButton));
+}
+
+test(WideIndex, encoded_config_with_many_buttons) {
+  buttons.clear();
+  for (uint16_t i = 0; i < NUM_BUTTONS; i++) {
+    assertTrue(buttons.add(nullptr, i + 1, HIGH, i + 1) != nullptr);
+  }
+  encodedConfig.init();
+  encodedConfig.setButtons(buttons.size(), buttons.data());
+
+  tracker.clear();
+  tracker.attach(&encodedConfig);
+
+  encodedConfig.setVirtualPin(encodedConfig.getNoButtonPin());
+  encodedConfig.setClock(0);
+  encodedConfig.checkButtons();
+  encodedConfig.setClock(50);
+  encodedConfig.checkButtons();
+
+  // Press a button beyond the range of 8-bit pins and ids.
+  encodedConfig.setVirtualPin(513);
+  encodedConfig.setClock(100);
+  encodedConfig.checkButtons();
+  encodedConfig.setClock(150);
+  encodedConfig.checkButtons();
+
+  assertEqual((uint32_t) 1, tracker.size());
+  assertEqual(AceButton::kEventPressed, tracker.getRecord(0).eventType);
+  assertEqual((ButtonIdType) 513, tracker.getRecord(0).buttonId);
+  assertEqual((ButtonPinType) 513, tracker.getRecord(0).pin);
+}
+
+test(WideIndex, subscribers_filter_wide_id) {
+  EventSubscribers<1> subscribers;
+  CountingHandler handler;
+  subscribers.subscribe(EventDelegate::fromHandler(&handler),
+      (1 << AceButton::kEventPressed), 300);
+  testableConfig.init();
+  subscribers.attach(&testableConfig);
+
+  // Same lower 8 bits as 300, not delivered.
+  AceButton other(&testableConfig, 1, HIGH, 300 & 0xFF);
+  pressAndRelease(other, 0);
+  assertEqual((uint16_t) 0, handler.count);
+
+  AceButton button(&testableConfig, 2, HIGH, 300);
+  pressAndRelease(button, 1000);
+  assertEqual((uint16_t) 1, handler.count);
+}
+
+test(WideIndex, event_log_keeps_wide_id) {
+  const char path[] = "/tmp/AceButtonWideIndexTest.img";
+  remove(path);
+  FileLogStorage storage(4096, 2);
+  assertTrue(storage.open(path));
+  EventLog eventLog(&storage);
+  assertTrue(eventLog.begin());
+  assertTrue(eventLog.append(300, AceButton::kEventPressed, 1000));
+  assertTrue(eventLog.append(300, AceButton::kEventReleased, 1100));
+  assertTrue(eventLog.append(44, AceButton::kEventPressed, 1200));
+
+  EventLogReader reader(&storage);
+  reader.rewind();
+  EventLogRecord record;
+  assertTrue(reader.next(record));
+  assertEqual((uint16_t) 300, record.buttonId);
+  assertTrue(reader.next(record));
+  assertEqual((uint16_t) 300, record.buttonId);
+  assertTrue(reader.next(record));
+  assertEqual((uint16_t) 44, record.buttonId);
+  assertFalse(reader.next(record));
+}
+
+test(WideIndex, event_stream_keeps_wide_id) {
+  EventStreamWriter<64> writer;
+  assertTrue(writer.publishEvent(
+      300, AceButton::kEventClicked, HIGH, 1000, 100, 1));
+
+  EventStreamDecoder decoder;
+  WireMessage message;
+  bool decoded = false;
+  writer.drain([&](const uint8_t* data, uint32_t size) {
+    for (uint32_t i = 0; i < size; i++) {
+      if (decoder.decode(data[i], message)) decoded = true;
+    }
+    return size;
+  });
+  assertTrue(decoded);
+  assertEqual((uint16_t) 300, message.buttonId);
+  assertEqual(AceButton::kEventClicked, message.eventType);
+}
+
+test(WideIndex, high_priority_wide_id) {
+  PriorityEventQueue<4, 2> queue;
+  uint8_t expected = PriorityEventQueue<4, 2>::kPriorityHigh;
+
+  assertTrue(queue.setHighPriorityButton(300));
+  assertTrue(queue.setHighPriorityButton(65535));
+  assertEqual(expected, queue.getPriority(300, AceButton::kEventPressed));
+  assertEqual(expected, queue.getPriority(65535, AceButton::kEventPressed));
+  expected = PriorityEventQueue<4, 2>::kPriorityNormal;
+  assertEqual(expected, queue.getPriority(44, AceButton::kEventPressed));
+  assertFalse(queue.setHighPriorityButton(65536));
+}